@@ -13,6 +13,7 @@
 #include <set>
 #include <list>
 #include <filesystem>
+#include <atomic>
 
 #include <errno.h>
 
@@ -19,6 +19,32 @@
 #ifndef __KEPOLL_H__
 #define __KEPOLL_H__
 
+#define K_EPOLL_CTL_ADD 1
+#define K_EPOLL_CTL_DEL 2
+#define K_EPOLL_CTL_MOD 3
+
+#define K_EPOLLONESHOT 0x40000000
+#define K_EPOLLET 0x80000000
+
+class KEPoll;
+
+class KEPollEntry {
+public:
+    KEPollEntry(KEPoll* epoll, FD fd, const std::shared_ptr<KObject>& object) : epoll(epoll), fd(fd), data(0), events(0), object(object), pollOnEveryWait(!object->supportsEPollNotify()), disabled(false), node(this) {}
+
+    KEPoll* epoll;
+    FD fd;
+    U64 data;
+    U32 events;
+    std::weak_ptr<KObject> object;
+    // objects that can't tell us when they are ready are checked on every wait
+    bool pollOnEveryWait;
+    // EPOLLONESHOT entries are disabled after they are reported until EPOLL_CTL_MOD re-arms them
+    bool disabled;
+    // in KEPoll::readyList or KEPoll::pollList
+    KListNode<KEPollEntry*> node;
+};
+
 class KEPoll : public KObject {
 public:
     KEPoll();
@@ -47,14 +73,22 @@ public:
 
     U32 ctl(U32 op, FD fd, U32 address);
     U32 wait(U32 events, U32 maxevents, U32 timeout);
+
+    // called by the object with its epoll entries locked
+    void onReady(KEPollEntry* entry);
 private:
-    class Data {
-    public:
-        U32 fd;
-        U64 data;
-        U32 events;
-    };
-    std::unordered_map<U32, Data*> data;
+    void removeEntry(KEPollEntry* entry);
+    // caller must hold entriesMutex
+    void unlinkClosedEntry(KEPollEntry* entry);
+
+    std::unordered_map<U32, KEPollEntry*> entries;
+    // entries that need to be checked on the next wait, level triggered entries stay here while they are ready
+    KList<KEPollEntry*> readyList;
+    KList<KEPollEntry*> pollList;
+    // held while changing the interest list so that an entry can't be deleted while it is being added to its object
+    BOXEDWINE_MUTEX ctlMutex;
+    BOXEDWINE_MUTEX entriesMutex;
+    BOXEDWINE_CONDITION readyCond;
 };
 
 #endif
\ No newline at end of file
@@ -25,6 +25,8 @@
 #define KTYPE_EPOLL 3
 #define KTYPE_SIGNAL 4
 
+class KEPollEntry;
+
 class KObject : public std::enable_shared_from_this<KObject> {
 protected:
     KObject(U32 type);
@@ -56,8 +58,18 @@ public:
     virtual U32  map(U32 address, U32 len, S32 prot, S32 flags, U64 off)=0;
     virtual bool canMap()=0;
 
+    // objects that return true must call notifyEPoll whenever their read/write readiness might have changed,
+    // epoll will then only re-check them when notified instead of polling them on every wait
+    virtual bool supportsEPollNotify() {return false;}
+    void addEPollEntry(KEPollEntry* entry);
+    void removeEPollEntry(KEPollEntry* entry);
+    void notifyEPoll();
+
     U32 type;
     U32 pid;
+private:
+    BOXEDWINE_MUTEX epollEntriesMutex;
+    std::vector<KEPollEntry*> epollEntries;
 };
 
 #endif
\ No newline at end of file
@@ -19,6 +19,8 @@
 #ifndef __KPOLL_H__
 #define __KPOLL_H__
 
+class KObject;
+
 class KPollData {
 public:
     U32 address;
@@ -29,6 +31,7 @@ public:
 };
 
 S32 internal_poll(KPollData* data, U32 count, U32 timeout);
+U32 getPollReadyEvents(KObject* object, U32 events);
 
 U32 kpoll(U32 pfds, U32 nfds, U32 timeout);
 U32 kselect(U32 nfds, U32 readfds, U32 writefds, U32 errorfds, U32 timeout);
@@ -25,17 +25,23 @@
 #define ADDRESS_PROCESS_STACK_START		0xF4000
 #define ADDRESS_PROCESS_FRAME_BUFFER	0xF8000
 #define ADDRESS_PROCESS_FRAME_BUFFER_ADDRESS 0xF8000000
+#define ADDRESS_PROCESS_VDSO            0xFFFE0
+
+#define KPROCESS_INITIAL_FDS 64
 
 class MappedFileCache;
 class Memory;
 
 class MappedFile : public BoxedPtrBase {
 public:
+    MappedFile() : address(0), len(0), offset(0), nextFaultIndex(0), faultAroundPages(0) {}
     BoxedPtr<MappedFileCache> systemCacheEntry;
     std::shared_ptr<KFile> file;
     U32 address;
     U64 len;
     U64 offset;
+    U32 nextFaultIndex; // file page right after the last fault-around window
+    U32 faultAroundPages; // size of the last fault-around window
 };
 
 #define K_SIG_INFO_SIZE 10
@@ -107,10 +113,11 @@ public:
     void killAllThreads();
     std::string getAbsoluteExePath();
     void clone(const std::shared_ptr<KProcess>& from);
-    U32 getNextFileDescriptorHandle(int after);
+    S32 getNextFileDescriptorHandle(int after);
 
     std::string getModuleName(U32 eip);
     U32 getModuleEip(U32 eip);    
+    // returns NULL if handle is -1 and there is no free handle below MAX_NUMBER_OF_FILES
     KFileDescriptor* allocFileDescriptor(const std::shared_ptr<KObject>& kobject, U32 accessFlags, U32 descriptorFlags, S32 handle, U32 afterHandle);
     KFileDescriptor* getFileDescriptor(FD handle);
     void clearFdHandle(FD handle);
@@ -241,9 +248,15 @@ public:
     U32 phnum;
     U32 phentsize;
     U32 entry;
+    U32 vdsoAddress; // 0 if there isn't one
     U32 eventQueueFD;     
     BOXEDWINE_CONDITION exitOrExecCond;
 
+    // file backed mmap stats
+    U32 mmapFaults;
+    U32 mmapPagesPopulated;
+    U64 mmapBytesRead;
+
     bool hasSetStackMask;
     bool hasSetSeg[6];
 #ifdef BOXEDWINE_64BIT_MMU
@@ -268,9 +281,24 @@ public:
 #endif
 #endif
 private:
-    std::unordered_map<U32, KFileDescriptor*> fds;
+    // indexed by handle.  Lookups don't lock, changes are serialized by fdsMutex and a table is only grown by
+    // publishing a bigger copy.  The smaller tables are kept and updated until the process goes away since another
+    // thread might still be reading one.
+    class KFileDescriptorTable {
+    public:
+        KFileDescriptorTable(U32 size);
+        ~KFileDescriptorTable();
+
+        const U32 size;
+        std::atomic<KFileDescriptor*>* const slots;
+    };
+    std::atomic<KFileDescriptorTable*> fds;
+    std::vector<KFileDescriptorTable*> retiredFds;
     BOXEDWINE_MUTEX fdsMutex;
 
+    void setFileDescriptor(U32 handle, KFileDescriptor* fd);
+    void getFileDescriptors(std::vector<KFileDescriptor*>& results);
+
     std::unordered_map<U32, user_desc> ldt;
     BOXEDWINE_MUTEX ldtMutex;
 
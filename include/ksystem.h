@@ -85,6 +85,7 @@ public:
     static U32 pollRate;
     static bool showWindowImmediately;
     static U32 skipFrameFPS;
+    static U32 faultAroundPages; // largest window of file pages read by one mmap fault, 0 or 1 disables fault-around
     static FILE* logFile;
     static std::function<void(const std::string& line)> watchTTY;
     static bool ttyPrepend;
@@ -39,6 +39,7 @@ public:
 
 class KProcess;
 class Memory;
+class KFutexWaiter;
 
 class KThreadGlContext {
 public:
@@ -157,7 +158,7 @@ private:
     struct user_desc tls[TLS_ENTRIES];
     BOXEDWINE_MUTEX tlsMutex;
 
-    static BOXEDWINE_MUTEX futexesMutex;
+    KFutexWaiter* futexWaiter;
 };
 
 class ChangeThread {
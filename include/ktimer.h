@@ -19,14 +19,17 @@
 #ifndef __KTIMER_H__
 #define __KTIMER_H__
 
+#define K_TIMER_NOT_QUEUED 0xFFFFFFFF
+#define K_TIMER_RUNNING 0xFFFFFFFE
+
 class KTimer {
 public:
-    KTimer() : node(this), millies(0), resetMillies(0), active(false) {}
+    KTimer() : heapIndex(K_TIMER_NOT_QUEUED), millies(0), resetMillies(0), active(false) {}
     ~KTimer();
 
-    virtual bool run()=0; // return true of the timer should be removed, don't remove a timer manually in run because it will invalidate the iterator
+    virtual bool run()=0; // return true if the timer should be removed, if it returns false it will be queued again with its current millies
 
-    KListNode<KTimer*> node;
+    U32 heapIndex; // where it is in the scheduler's timer heap, or one of K_TIMER_NOT_QUEUED/K_TIMER_RUNNING
 	U32 millies;
 	U32 resetMillies;
 	bool active;
@@ -3,6 +3,7 @@
 
 #include "ksocketmsg.h"
 #include "ksocketobject.h"
+#include "../source/util/kringbuffer.h"
 
 class KUnixSocketObject : public KSocketObject {
 public:
@@ -23,6 +24,7 @@ public:
     virtual bool isReadReady();
     virtual bool isWriteReady();
     virtual void waitForEvents(BOXEDWINE_CONDITION& parentCondition, U32 events);
+    virtual bool supportsEPollNotify();
     virtual U32  write(U32 buffer, U32 len);
     virtual U32  writeNative(U8* buffer, U32 len);
     virtual U32  writev(U32 iov, S32 iovcnt);
@@ -57,7 +59,7 @@ private:
 
     BOXEDWINE_CONDITION lockCond;
 
-    std::deque<S8> recvBuffer;
+    KRingBuffer recvBuffer;
     std::queue<std::shared_ptr<KSocketMsg> > msgs;
 
     U32 internal_write(const std::shared_ptr<KUnixSocketObject>& con, BOXEDWINE_CONDITION& cond, U32 buffer, U32 len);
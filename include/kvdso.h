@@ -0,0 +1,49 @@
+/*
+ *  Copyright (C) 2016  The BoxedWine Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __KVDSO_H__
+#define __KVDSO_H__
+
+// The guest rdtsc is a count of emulated instructions, it is only one clock for every thread when the
+// scheduler is single threaded, and the pages can only be shared between processes with the soft mmu
+#if defined(BOXEDWINE_DEFAULT_MMU) && !defined(BOXEDWINE_MULTI_THREADED)
+#define BOXEDWINE_VDSO
+#endif
+
+#ifdef BOXEDWINE_VDSO
+
+// A small 32-bit ELF image that is mapped into every process and passed to it with AT_SYSINFO_EHDR, libc
+// will then call __vdso_clock_gettime, __vdso_gettimeofday and __vdso_time instead of making a syscall.
+//
+// Those functions read the time from a second page that the host updates at the start of each slice and
+// after every syscall.  The guest adds how many instructions it ran since then (rdtsc) times the current
+// ns per instruction, the amount it can add is capped so that it never gets far ahead of the host clock.
+// The page is protected by a sequence count, it is odd while the host is writing it.
+class KVdso {
+public:
+    static U32 map(Memory* memory); // returns the address of the ELF header
+    static void updateTime(U64 tsc, U64 microCounter); // microCounter is a recent KSystem::getMicroCounter()
+    static U32 getFunctionAddress(const char* name); // 0 if not found
+
+private:
+    static void init();
+};
+
+#endif
+
+#endif
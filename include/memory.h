@@ -70,6 +70,11 @@ U32 getNativeStringLen(U32 address);
 
 void memcopyFromNative(U32 address, const void* p, U32 len);
 void memcopyToNative(U32 address, void* p, U32 len);
+#ifndef BOXEDWINE_DEFAULT_MMU
+// the soft mmu inlines small copies that stay on one page
+#define memcopyFromNativeInline memcopyFromNative
+#define memcopyToNativeInline memcopyToNative
+#endif
 
 class KProcess;
 class Page;
@@ -117,6 +122,10 @@ public:
 	void decRefCount() { this->refCount--; if (this->refCount == 0) { delete this; } }
     U32 getRefCount() { return this->refCount;}
 
+    // incremented whenever a normal core block for this memory is freed, NormalCPU's block cache entries
+    // from an older generation can't be used.  It starts at 1 since empty cache entries are generation 0.
+    std::atomic<U32> blockGeneration;
+
 private:
     U32 refCount;
 public: 
@@ -153,16 +162,19 @@ public:
     U64 memOffsets[K_NUMBER_OF_PAGES];    
 private:
     std::unordered_map<U32, std::unordered_map<U32, U32> > needsMemoryOffset; // first index is page, second index is offset
+    BOXEDWINE_MUTEX needsMemoryOffsetMutex; // the translator reads this without holding executableMemoryMutex
 public:
     bool doesInstructionNeedMemoryOffset(U32 eip) {
         U32 page = eip >> K_PAGE_SHIFT;
         U32 offset = eip & K_PAGE_MASK;
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(needsMemoryOffsetMutex);
         if (this->needsMemoryOffset.count(page) && this->needsMemoryOffset[page].count(offset)) {
             return this->needsMemoryOffset[page][offset] > 0;
         }
         return false;
     }
     void clearNeedsMemoryOffset(U32 page, U32 pageCount) {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(needsMemoryOffsetMutex);
         for (U32 i = 0; i < pageCount; i++) {
             if (this->needsMemoryOffset.count(page + i)) {
                 this->needsMemoryOffset.erase(page + i);
@@ -172,10 +184,12 @@ public:
     void setNeedsMemoryOffset(U32 eip) {
         U32 page = eip >> K_PAGE_SHIFT;
         U32 offset = eip & K_PAGE_MASK;
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(needsMemoryOffsetMutex);
         this->needsMemoryOffset[page][offset] = 1;
     }
 
     void clearAllNeedsMemoryOffset() {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(needsMemoryOffsetMutex);
         this->needsMemoryOffset.clear();
     }
 
@@ -184,6 +198,8 @@ public:
 
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
     BOXEDWINE_MUTEX executableMemoryMutex;    
+    // incremented whenever translated code is thrown away, code translated before the lock was taken is only published if this didn't change
+    std::atomic<U32> codeGeneration;
 private:
 #define EXECUTABLE_MIN_SIZE_POWER 7
 #define EXECUTABLE_MAX_SIZE_POWER 22
@@ -174,6 +174,7 @@ void* allocExecutable64kBlock(Memory* memory, U32 count);
 #endif
 #ifdef BOXEDWINE_X64
 bool platformHasBMI2();
+std::string platformGetExecutablePath(); // empty if it can't be found
 #endif
 
 #ifdef BOXEDWINE_MULTI_THREADED
@@ -296,4 +296,31 @@ bool platformHasBMI2() {
     }
     return false;
 }
+
+#ifdef __MACH__
+#include <mach-o/dyld.h>
+
+std::string platformGetExecutablePath() {
+    char path[PATH_MAX];
+    U32 len = sizeof(path);
+
+    if (_NSGetExecutablePath(path, &len) != 0) {
+        return "";
+    }
+    return path;
+}
+#else
+#include <unistd.h>
+
+std::string platformGetExecutablePath() {
+    char path[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+
+    if (len <= 0) {
+        return "";
+    }
+    path[len] = 0;
+    return path;
+}
+#endif
 #endif
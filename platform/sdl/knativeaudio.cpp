@@ -28,7 +28,7 @@ static void closeSdlAudio() {
 static void audioCallback(void* userdata, U8* stream, S32 len) {
 	KNativeSDLAudioData* data = (KNativeSDLAudioData*)userdata;
 
-	if (!data->isPlaying) {
+	if (!data->isPlaying || !data->ring) {
 		memset(stream, data->got.silence, len);
 		return;
 	}
@@ -38,34 +38,29 @@ static void audioCallback(void* userdata, U8* stream, S32 len) {
 	} else {
 		blockAlign = data->fmt.nBlockAlign * data->cvt.len_mult;
 	}
-	BOXEDWINE_CONDITION_LOCK(KSystem::processesCond);
-	if (data->process->terminated) {
-		memset(stream, data->got.silence, len);
-		BOXEDWINE_CONDITION_UNLOCK(KSystem::processesCond);
-		return;
-	}
 	U32 nframes = len / blockAlign;
-	U32 to_copy_bytes, to_copy_frames, chunk_bytes, lcl_offs_bytes;
-	if (!data->process->memory->isValidReadAddress(data->address_lcl_offs_frames, 4)) {
-		memset(stream, data->got.silence, len);
-		BOXEDWINE_CONDITION_UNLOCK(KSystem::processesCond);
-		return;
+	U32 to_copy_bytes, to_copy_frames, chunk_bytes, ring_offs_frames;
+	U32 readPos = data->ringReadPos.load(std::memory_order_relaxed);
+	U32 flushPos = data->ringFlushPos.load(std::memory_order_acquire);
+
+	if ((S32)(flushPos - readPos) > 0) {
+		readPos = flushPos;
 	}
-	U32 lcl_offs_frames = data->process->readd(data->address_lcl_offs_frames);
-	U32 held_frames = data->process->readd(data->address_held_frames);
+	U32 available = data->ringWritePos.load(std::memory_order_acquire) - readPos;
 
-	lcl_offs_bytes = lcl_offs_frames * data->fmt.nBlockAlign;
-	to_copy_frames = nframes < held_frames ? nframes : held_frames;
+	to_copy_frames = nframes < available ? nframes : available;
 	to_copy_bytes = to_copy_frames * data->fmt.nBlockAlign;
+	ring_offs_frames = readPos & (data->ringFrames - 1);
 
-	chunk_bytes = (data->bufsize_frames - lcl_offs_frames) * data->fmt.nBlockAlign;
+	chunk_bytes = (data->ringFrames - ring_offs_frames) * data->fmt.nBlockAlign;
 
+	U8* src = data->ring + ring_offs_frames * data->fmt.nBlockAlign;
 	if (data->sameFormat) {
 		if (to_copy_bytes > chunk_bytes) {
-			data->process->memcopyToNative(data->address_local_buffer + lcl_offs_bytes, stream, chunk_bytes);
-			data->process->memcopyToNative(data->address_local_buffer, stream + chunk_bytes, to_copy_bytes - chunk_bytes);
+			memcpy(stream, src, chunk_bytes);
+			memcpy(stream + chunk_bytes, data->ring, to_copy_bytes - chunk_bytes);
 		} else {
-			data->process->memcopyToNative(data->address_local_buffer + lcl_offs_bytes, stream, to_copy_bytes);
+			memcpy(stream, src, to_copy_bytes);
 		}
 		stream += to_copy_bytes;
 	} else {		
@@ -79,33 +74,113 @@ static void audioCallback(void* userdata, U8* stream, S32 len) {
 			data->cvtBufSize = bufSize;
 		}
 		if (to_copy_bytes > chunk_bytes) {
-			data->process->memcopyToNative(data->address_local_buffer + lcl_offs_bytes, data->cvtBuf, chunk_bytes);
-			data->process->memcopyToNative(data->address_local_buffer, data->cvtBuf + chunk_bytes, to_copy_bytes - chunk_bytes);
+			memcpy(data->cvtBuf, src, chunk_bytes);
+			memcpy(data->cvtBuf + chunk_bytes, data->ring, to_copy_bytes - chunk_bytes);
 		}
 		else {
-			data->process->memcopyToNative(data->address_local_buffer + lcl_offs_bytes, data->cvtBuf, to_copy_bytes);
+			memcpy(data->cvtBuf, src, to_copy_bytes);
 		}
 		data->cvt.buf = data->cvtBuf;
 		SDL_ConvertAudio(&data->cvt);
 		memcpy(stream, data->cvt.buf, data->cvt.len_cvt);
 		stream += data->cvt.len_cvt;
 	}
-	lcl_offs_frames += to_copy_frames;
-	lcl_offs_frames %= data->bufsize_frames;
-	data->process->writed(data->address_lcl_offs_frames, lcl_offs_frames);
-	held_frames -= to_copy_frames;
-	data->process->writed(data->address_held_frames, held_frames);
+	data->ringReadPos.store(readPos + to_copy_frames, std::memory_order_release);
 	if (nframes > to_copy_frames) {
 		memset(stream, data->got.silence, (nframes - to_copy_frames) * blockAlign);
+		data->underruns++;
 	}
 	if (data->eventFd) {
-		KFileDescriptor* fd = data->process->getFileDescriptor(data->eventFd);
-		if (fd) {
-			U8 c = EVENT_MSG_DATA_READ;
-			fd->kobject->writeNative(&c, 1);
+		SDL_SemPost(data->eventSem);
+	}
+}
+
+// writing to the event fd needs kernel locks, so it is done here instead of on the audio thread
+static int audioEventThread(void* userdata) {
+	KNativeSDLAudioData* data = (KNativeSDLAudioData*)userdata;
+
+	while (true) {
+		SDL_SemWait(data->eventSem);
+		if (data->eventThreadExit) {
+			break;
+		}
+		BOXEDWINE_CONDITION_LOCK(KSystem::processesCond);
+		if (data->eventFd && !data->process->terminated) {
+			KFileDescriptor* fd = data->process->getFileDescriptor(data->eventFd);
+			if (fd) {
+				U8 c = EVENT_MSG_DATA_READ;
+				fd->kobject->writeNative(&c, 1);
+			}
+		}
+		BOXEDWINE_CONDITION_UNLOCK(KSystem::processesCond);
+	}
+	return 0;
+}
+
+static void stopAudioEventThread(KNativeSDLAudioData* data) {
+	if (data->eventThread) {
+		data->eventThreadExit = true;
+		SDL_SemPost(data->eventSem);
+		SDL_WaitThread(data->eventThread, NULL);
+		data->eventThread = NULL;
+		data->eventThreadExit = false;
+	}
+	if (data->eventSem) {
+		SDL_DestroySemaphore(data->eventSem);
+		data->eventSem = NULL;
+	}
+}
+
+// Called on the emulated thread when the guest locks (copyNewFrames = false) or unlocks the device.
+// Reports what the callback consumed back to the guest's held/lcl_offs frames and, on unlock, moves
+// anything new the guest wrote to its local buffer into the ring.
+void KNativeAudioSDL::syncRing(KNativeSDLAudioData* data, bool copyNewFrames) {
+	if (!data->ring || !data->process->memory->isValidReadAddress(data->address_lcl_offs_frames, 4)) {
+		return;
+	}
+	U32 lcl_offs_frames = data->process->readd(data->address_lcl_offs_frames);
+	U32 held_frames = data->process->readd(data->address_held_frames);
+	U32 writePos = data->ringWritePos.load(std::memory_order_relaxed);
+	U32 readPos = data->ringReadPos.load(std::memory_order_acquire);
+
+	if (lcl_offs_frames != data->syncedLclOffsFrames || held_frames < writePos - data->syncedReadPos) {
+		// the guest reset its buffer, whatever is left in the ring is stale
+		data->ringFlushPos.store(writePos, std::memory_order_release);
+		data->syncedReadPos = writePos;
+	} else if ((S32)(readPos - data->syncedReadPos) > 0) {
+		U32 played = readPos - data->syncedReadPos;
+
+		data->syncedReadPos = readPos;
+		lcl_offs_frames += played;
+		lcl_offs_frames %= data->bufsize_frames;
+		data->process->writed(data->address_lcl_offs_frames, lcl_offs_frames);
+		held_frames -= played;
+		data->process->writed(data->address_held_frames, held_frames);
+	}
+	data->syncedLclOffsFrames = lcl_offs_frames;
+	if (!copyNewFrames) {
+		return;
+	}
+	U32 unplayed_frames = writePos - data->syncedReadPos;
+	U32 new_frames = held_frames - unplayed_frames;
+	U32 src_offs_frames = (lcl_offs_frames + unplayed_frames) % data->bufsize_frames;
+	U32 dst_offs_frames = writePos & (data->ringFrames - 1);
+
+	while (new_frames) {
+		U32 frames = new_frames;
+		if (frames > data->bufsize_frames - src_offs_frames) {
+			frames = data->bufsize_frames - src_offs_frames;
+		}
+		if (frames > data->ringFrames - dst_offs_frames) {
+			frames = data->ringFrames - dst_offs_frames;
 		}
+		data->process->memcopyToNative(data->address_local_buffer + src_offs_frames * data->fmt.nBlockAlign, data->ring + dst_offs_frames * data->fmt.nBlockAlign, frames * data->fmt.nBlockAlign);
+		src_offs_frames = (src_offs_frames + frames) % data->bufsize_frames;
+		dst_offs_frames = (dst_offs_frames + frames) & (data->ringFrames - 1);
+		writePos += frames;
+		new_frames -= frames;
 	}
-	BOXEDWINE_CONDITION_UNLOCK(KSystem::processesCond);
+	data->ringWritePos.store(writePos, std::memory_order_release);
 }
 
 bool KNativeAudioSDL::load() {
@@ -142,6 +217,11 @@ void KNativeAudioSDL::stop(U32 boxedAudioId) {
 		return;
 	}
 	data->isPlaying = false;
+	U32 underruns = data->underruns;
+	if (underruns != data->reportedUnderruns) {
+		klog("audio: %d underruns", underruns - data->reportedUnderruns);
+		data->reportedUnderruns = underruns;
+	}
 }
 
 bool KNativeAudioSDL::configure() {
@@ -191,8 +271,6 @@ U32 KNativeAudioSDL::init(bool isRender, U32 boxedAudioId, U32 addressFmt, U32 a
 	if (!data) {
 		return E_FAIL;
 	}
-	data->process = KThread::currentThread()->process;
-
 	data->bufsize_frames = bufsizeFrames;
 	data->period_frames = readd(addressPeriodFrames);
 	data->address_local_buffer = addressLocalBuffer;
@@ -213,6 +291,28 @@ U32 KNativeAudioSDL::init(bool isRender, U32 boxedAudioId, U32 addressFmt, U32 a
 	} else {
 		// If the previous audio is still playing, it will get cut off.  If I find a game that needs this, then perhaps I should think of a mixer.
 		closeSdlAudio();
+	}
+	// the callback is stopped now so the ring and the event thread can be replaced
+	stopAudioEventThread(data);
+	data->process = KThread::currentThread()->process;
+
+	U32 ringFrames = 1;
+	while (ringFrames < data->bufsize_frames) {
+		ringFrames <<= 1;
+	}
+	if (data->ring) {
+		delete[] data->ring;
+	}
+	data->ring = new U8[ringFrames * data->fmt.nBlockAlign];
+	data->ringFrames = ringFrames;
+	data->ringWritePos = 0;
+	data->ringReadPos = 0;
+	data->ringFlushPos = 0;
+	data->syncedReadPos = 0;
+	data->syncedLclOffsFrames = readd(addressLclOffsFrames);
+	data->eventSem = SDL_CreateSemaphore(0);
+	data->eventThread = SDL_CreateThread(audioEventThread, "AudioEvent", data);
+	if (KSystem::soundEnabled) {
 		if (SDL_OpenAudio(&data->want, &data->got) < 0) {
 			klog("Failed to open audio: %s", SDL_GetError());
 		}		
@@ -243,11 +343,17 @@ U32 KNativeAudioSDL::getLatency(U32 boxedAudioId, U32* pLatency) {
 }
 
 void KNativeAudioSDL::lock(U32 boxedAudioId) {
-	SDL_LockAudio();
+	KNativeSDLAudioData* data = getDataFromId(boxedAudioId);
+	if (data) {
+		syncRing(data, false);
+	}
 }
 
 void KNativeAudioSDL::unlock(U32 boxedAudioId) {
-	SDL_UnlockAudio();
+	KNativeSDLAudioData* data = getDataFromId(boxedAudioId);
+	if (data) {
+		syncRing(data, true);
+	}
 }
 
 U32 KNativeAudioSDL::isFormatSupported(U32 boxedAudioId, U32 addressWaveFormat) {
@@ -370,6 +476,8 @@ U32 KNativeAudioSDL::midiInReset(U32 wDevID) {
 void KNativeAudioSDL::cleanup() {
     SDL_PauseAudio(1);
     SDL_CloseAudio();
+    stopAudioEventThread(&data[0]);
+    stopAudioEventThread(&data[1]);
 }
 
 std::shared_ptr<KNativeAudio> KNativeAudio::createNativeAudio() {
@@ -1,9 +1,17 @@
 #ifndef __KNATIVE_AUDIO_SDL_H__
 #define __KNATIVE_AUDIO_SDL_H__
 
+#include <atomic>
+
+// The guest's local buffer is copied into a host ring whenever the guest locks or unlocks the
+// device, so the SDL audio callback only ever touches host memory and never takes a kernel lock.
+//
+// The ring is single producer (the emulated thread calling lock/unlock) and single consumer (the
+// SDL audio callback).  Positions are free running frame counts, only the producer writes
+// ringWritePos/ringFlushPos and only the consumer writes ringReadPos.
 class KNativeSDLAudioData {
 public:
-	KNativeSDLAudioData() : cvtBuf(0), cvtBufSize(0), sameFormat(false), open(false), isRender(false), isPlaying(false), eventFd(0), adevid(0), cap_held_frames(0), resamp_bufsize_frames(0), resamp_buffer(0), cap_offs_frames(0), bufsize_frames(0), address_local_buffer(0), address_wri_offs_frames(0), address_held_frames(0), address_lcl_offs_frames(0), period_frames(0) {}
+	KNativeSDLAudioData() : cvtBuf(0), cvtBufSize(0), sameFormat(false), open(false), isRender(false), isPlaying(false), eventFd(0), adevid(0), cap_held_frames(0), resamp_bufsize_frames(0), resamp_buffer(0), cap_offs_frames(0), bufsize_frames(0), address_local_buffer(0), address_wri_offs_frames(0), address_held_frames(0), address_lcl_offs_frames(0), period_frames(0), ring(0), ringFrames(0), ringWritePos(0), ringReadPos(0), ringFlushPos(0), syncedReadPos(0), syncedLclOffsFrames(0), underruns(0), reportedUnderruns(0), eventSem(0), eventThread(0), eventThreadExit(false) {}
 	~KNativeSDLAudioData() {
 		if (resamp_buffer) {
 			delete[] resamp_buffer;
@@ -11,6 +19,9 @@ public:
 		if (cvtBuf) {
 			delete[] cvtBuf;
 		}
+		if (ring) {
+			delete[] ring;
+		}
 	}
 
 	SDL_AudioSpec want;
@@ -43,6 +54,24 @@ public:
 	// mirrored in emulator side
 	U32 period_frames; // read only, doesn't change
 	BoxedWaveFormatExtensible fmt; // read only, doesn't change
+
+	U8* ring;
+	U32 ringFrames; // power of 2
+	std::atomic<U32> ringWritePos;
+	std::atomic<U32> ringReadPos;
+	std::atomic<U32> ringFlushPos; // the consumer skips ahead to here, used when the guest resets its buffer
+
+	// producer side view of what the guest has been told
+	U32 syncedReadPos;
+	U32 syncedLclOffsFrames;
+
+	std::atomic<U32> underruns;
+	U32 reportedUnderruns;
+
+	// the callback posts eventSem and eventThread delivers EVENT_MSG_DATA_READ to the guest
+	SDL_sem* eventSem;
+	SDL_Thread* eventThread;
+	std::atomic<bool> eventThreadExit;
 };
 
 class KNativeAudioSDL : public KNativeAudio, public std::enable_shared_from_this<KNativeAudioSDL> {
@@ -92,6 +121,7 @@ public:
 	virtual U32 midiInReset(U32 wDevID);
 
 	U32 getSdlFormat(BoxedWaveFormatExtensible* pFmt);
+	void syncRing(KNativeSDLAudioData* data, bool copyNewFrames);
 
 	KNativeSDLAudioData data[2];
 
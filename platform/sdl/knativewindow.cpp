@@ -99,8 +99,36 @@ public:
     SDL_Texture* sdlTexture;
     int sdlTextureHeight;
     int sdlTextureWidth;
+
+    // parts of sdlTexture that are out of date, in texture coordinates
+    std::vector<SDL_Rect> damage;
+    void addDamage(SDL_Rect rect);
 };
 
+#define MAX_DAMAGE_RECTS 8
+
+void WndSdl::addDamage(SDL_Rect rect) {
+    // anything that overlaps is merged, the merged rect might now overlap an earlier one so start over
+    for (U32 i = 0; i < damage.size();) {
+        if (SDL_HasIntersection(&damage[i], &rect)) {
+            SDL_UnionRect(&damage[i], &rect, &rect);
+            damage.erase(damage.begin() + i);
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+    damage.push_back(rect);
+    if (damage.size() > MAX_DAMAGE_RECTS) {
+        rect = damage[0];
+        for (U32 i = 1; i < damage.size(); i++) {
+            SDL_UnionRect(&damage[i], &rect, &rect);
+        }
+        damage.clear();
+        damage.push_back(rect);
+    }
+}
+
 U32 KNativeWindow::defaultScreenWidth = 800;
 U32 KNativeWindow::defaultScreenHeight = 600;
 U32 KNativeWindow::defaultScreenBpp = 32;
@@ -109,7 +137,7 @@ U32 sdlCustomEvent;
 
 class KNativeWindowSdl : public KNativeWindow, public std::enable_shared_from_this<KNativeWindowSdl> {
 public:
-    KNativeWindowSdl() : scaleX(100), scaleXOffset(0), scaleY(100), scaleYOffset(0), sdlDesktopWidth(0), sdlDesktopHeight(0), fullScreen(FULLSCREEN_NOTSET), vsync(VSYNC_DEFAULT), window(NULL), renderer(NULL), shutdownWindow(NULL), shutdownRenderer(NULL), desktopTexture(NULL), currentContext(NULL), contextCount(0), windowIsGL(false), glWindowVersionMajor(0), windowIsHidden(false), timeToHideUI(0), timeWindowWasCreated(0), lastChildWndCreated(0), primarySurface(NULL)
+    KNativeWindowSdl() : scaleX(100), scaleXOffset(0), scaleY(100), scaleYOffset(0), sdlDesktopWidth(0), sdlDesktopHeight(0), fullScreen(FULLSCREEN_NOTSET), vsync(VSYNC_DEFAULT), window(NULL), renderer(NULL), shutdownWindow(NULL), shutdownRenderer(NULL), desktopTexture(NULL), currentContext(NULL), contextCount(0), windowIsGL(false), glWindowVersionMajor(0), windowIsHidden(false), timeToHideUI(0), timeWindowWasCreated(0), lastChildWndCreated(0), primarySurface(NULL), bytesUploaded(0), framesPresented(0)
 #ifdef BOXEDWINE_RECORDER
         , screenCopyTexture(NULL)
 #endif
@@ -158,6 +186,10 @@ public:
     U32 timeWindowWasCreated;
     U32 lastChildWndCreated;
     Boxed_Surface* primarySurface;
+    // only touched on the main thread, they are updated inside DISPATCH_MAIN_THREAD_BLOCK and read by the main loop,
+    // so they don't take sdlMutex (bltWnd holds it while it waits for the main thread)
+    U64 bytesUploaded; // texture bytes uploaded since the last getBytesUploadedPerFrame
+    U32 framesPresented;
 
     std::string delayedCreateWindowMsg; // the ui will watch for this message
     std::unordered_map<std::string, SDL_Cursor*> cursors;
@@ -196,7 +228,7 @@ public:
 
     virtual std::shared_ptr<Wnd> getWnd(U32 hwnd);
     virtual std::shared_ptr<Wnd> createWnd(KThread* thread, U32 processId, U32 hwnd, U32 windowRect, U32 clientRect);
-    virtual void bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rect);
+    virtual void bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rects, U32 rectCount);
     virtual void drawWnd(KThread* thread, std::shared_ptr<Wnd> w, U8* bytes, U32 pitch, U32 bpp, U32 width, U32 height);
 #ifndef BOXEDWINE_MULTI_THREADED
     virtual void flipFB();
@@ -204,6 +236,7 @@ public:
     virtual void setPrimarySurface(KThread* thread, U32 bits, U32 width, U32 height, U32 pitch, U32 flags, U32 palette);
     virtual void drawAllWindows(KThread* thread, U32 hWnd, int count);
     virtual void setTitle(const std::string& title);
+    virtual U32 getBytesUploadedPerFrame();
 
     virtual U32 getGammaRamp(U32 ramp);
 
@@ -904,7 +937,7 @@ void KNativeWindowSdl::glSwapBuffers(KThread* thread) {
 static S8 sdlBuffer[1024*1024*4];
 #endif
 
-void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rect) {
+void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32 yOrg, U32 width, U32 height, U32 rects, U32 rectCount) {
     if (!firstWindowCreated) {
         BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sdlMutex);
         DISPATCH_MAIN_THREAD_BLOCK_BEGIN
@@ -914,9 +947,9 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
     
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(sdlMutex);
     std::shared_ptr<WndSdl> wnd = getWndSdl(hwnd);
-    wRECT r;
     int bpp = screenBpp()==8?32:screenBpp();
     int pitch = (width*((bpp+7)/8)+3) & ~3;
+    U32 bytesPerPixel = (bpp + 7) / 8;
 
     if (!renderer) {
         // final reality will draw its main start window while an OpenGL context is still going
@@ -931,12 +964,35 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
         }
     }
     preDrawWindow();
-    r.readRect(rect);    
     if (wnd)
     {
         if (!thread->memory->isValidReadAddress(bits, height * pitch)) {
             return;
         }
+        for (U32 i = 0; i < rectCount; i++) {
+            wRECT r;
+            SDL_Rect dirty;
+
+            r.readRect(rects + 16 * i);
+            dirty.x = r.left < 0 ? 0 : r.left;
+            dirty.w = (r.right > (S32)width ? (S32)width : r.right) - dirty.x;
+#ifdef BOXEDWINE_FLIP_MANUALLY
+            // the rows are flipped while they are copied to sdlBuffer, so the texture is top down like the rect
+            dirty.y = r.top < 0 ? 0 : r.top;
+            dirty.h = (r.bottom > (S32)height ? (S32)height : r.bottom) - dirty.y;
+#else
+            // the bits are bottom up and so is the texture, it is flipped when it is drawn
+            dirty.y = (S32)height - (r.bottom > (S32)height ? (S32)height : r.bottom);
+            dirty.h = (S32)height - (r.top < 0 ? 0 : r.top) - dirty.y;
+#endif
+            if (dirty.w > 0 && dirty.h > 0) {
+                wnd->addDamage(dirty);
+            }
+        }
+        if (!rectCount) {
+            SDL_Rect all = {0, 0, (int)width, (int)height};
+            wnd->addDamage(all);
+        }
         DISPATCH_MAIN_THREAD_BLOCK_BEGIN
         SDL_Texture *sdlTexture = NULL;
         
@@ -961,11 +1017,32 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
             }
             wnd->sdlTextureHeight = height;
             wnd->sdlTextureWidth = width;
+            // a new texture has nothing in it yet
+            SDL_Rect all = {0, 0, (int)width, (int)height};
+            wnd->damage.clear();
+            wnd->damage.push_back(all);
         }        
-#ifdef BOXEDWINE_FLIP_MANUALLY        
-        for (U32 y = 0; y < height; y++) {
-            memcopyToNative(bits+(height-y-1)*pitch, sdlBuffer+y*pitch, pitch);
-        } 
+#ifdef BOXEDWINE_FLIP_MANUALLY
+        bool copyAll = false;
+#ifdef BOXEDWINE_RECORDER
+        // the recorder keeps the whole frame
+        copyAll = Recorder::instance || Player::instance;
+#endif
+        if (copyAll) {
+            for (U32 y = 0; y < height; y++) {
+                memcopyToNative(bits+(height-y-1)*pitch, sdlBuffer+y*pitch, pitch);
+            }
+        } else {
+            // sdlBuffer is shared by every window, only the parts that are uploaded below need to be right
+            for (auto& dirty : wnd->damage) {
+                U32 offset = dirty.x * bytesPerPixel;
+                U32 len = dirty.w * bytesPerPixel;
+
+                for (S32 y = dirty.y; y < dirty.y + dirty.h; y++) {
+                    memcopyToNative(bits + (height - y - 1) * pitch + offset, sdlBuffer + y * pitch + offset, len);
+                }
+            }
+        }
 #endif
         if (screenBpp()!=32) {
             // SDL_ConvertPixels(width, height, )
@@ -990,15 +1067,31 @@ void KNativeWindowSdl::bltWnd(KThread* thread, U32 hwnd, U32 bits, S32 xOrg, S32
 #endif        
         if (KSystem::videoEnabled && renderer) {
 #ifdef BOXEDWINE_FLIP_MANUALLY
-            SDL_UpdateTexture(sdlTexture, NULL, sdlBuffer, pitch);
+            U8* src = (U8*)sdlBuffer;
 #else
-            SDL_UpdateTexture(sdlTexture, NULL, getNativeAddress(KThread::currentThread()->process->memory, bits), pitch);            
+            U8* src = (U8*)getNativeAddress(KThread::currentThread()->process->memory, bits);
 #endif
+            for (auto& dirty : wnd->damage) {
+                SDL_UpdateTexture(sdlTexture, &dirty, src + dirty.y * pitch + dirty.x * bytesPerPixel, pitch);
+                bytesUploaded += dirty.w * dirty.h * bytesPerPixel;
+            }
         }
+        wnd->damage.clear();
         DISPATCH_MAIN_THREAD_BLOCK_END
     }    
 }
 
+U32 KNativeWindowSdl::getBytesUploadedPerFrame() {
+    U32 result = 0;
+
+    if (framesPresented) {
+        result = (U32)(bytesUploaded / framesPresented);
+    }
+    bytesUploaded = 0;
+    framesPresented = 0;
+    return result;
+}
+
 void KNativeWindowSdl::updatePrimarySurface(KThread* thread, U32 bits, U32 width, U32 height, U32 pitch, U32 flags, SDL_Color* colors) {
     if (bits == 0) {
         if (desktopTexture) {
@@ -1191,6 +1284,7 @@ void KNativeWindowSdl::drawWnd(KThread* thread, std::shared_ptr<Wnd> w, U8* byte
 #endif        
     if (KSystem::videoEnabled && renderer) {
         SDL_UpdateTexture(sdlTexture, NULL, bytes, pitch);
+        bytesUploaded += pitch * height;
         
         SDL_SetRenderDrawColor(renderer, 58, 110, 165, 255);
         SDL_RenderClear(renderer);
@@ -1214,6 +1308,7 @@ void KNativeWindowSdl::drawWnd(KThread* thread, std::shared_ptr<Wnd> w, U8* byte
             SDL_RenderFillRect(renderer, &rect);
         }
         SDL_RenderPresent(renderer);
+        framesPresented++;
     }
     DISPATCH_MAIN_THREAD_BLOCK_END
 }
@@ -1356,6 +1451,7 @@ void KNativeWindowSdl::drawAllWindows(KThread* thread, U32 hWnd, int count) {
             }
         }
         SDL_RenderPresent(renderer);
+        framesPresented++;
         DISPATCH_MAIN_THREAD_BLOCK_END
     }
     KNativeWindow::windowUpdated = true;
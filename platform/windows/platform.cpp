@@ -483,4 +483,14 @@ bool platformHasBMI2() {
     }
     return false;
 }
+
+std::string platformGetExecutablePath() {
+    char path[MAX_PATH];
+    DWORD len = GetModuleFileNameA(NULL, path, MAX_PATH);
+
+    if (len == 0 || len == MAX_PATH) {
+        return "";
+    }
+    return path;
+}
 #endif
@@ -7844,6 +7844,15 @@ Armv8btOp armv8btEncoder[InstructionCount] = {
     opShufpdXmmE128,
     opPause,
 
+    // fused pairs are only created by the normal core
+    opCmpR32R32,
+    opCmpR32I32,
+    opTestR32R32,
+    opDecR32,
+    opPushR32,
+    opMovR32E32,
+    opMovR32E32,
+
     opNone,
     opCallback,
     opDone,
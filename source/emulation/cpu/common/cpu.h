@@ -331,6 +331,8 @@ public:
 
     virtual void run()=0;
     virtual DecodedBlock* getNextBlock() = 0;
+    virtual void pushReturnPrediction(U32 returnEip) {}
+    virtual DecodedBlock* getNextReturnBlock() {return this->getNextBlock();}
     virtual void restart() {}
     virtual void setSeg(U32 index, U32 address, U32 value);
 
@@ -637,3 +637,10 @@ INIT_CPU(Fxsave, fxsave)
 INIT_CPU(Fxrstor, fxrstor)
 INIT_CPU(Xsave, xsave)
 INIT_CPU(Xrstor, xrstor)
+INIT_CPU(CmpR32R32Jcc, cmpr32r32_jcc)
+INIT_CPU(CmpR32I32Jcc, cmp32_reg_jcc)
+INIT_CPU(TestR32R32Jcc, testr32r32_jcc)
+INIT_CPU(DecR32Jnz, dec32_reg_jnz)
+INIT_CPU(PushEbpMovEbpEsp, pushEbp_movEbpEsp)
+INIT_CPU(MovR32E32AddR32I32, movr32e32_add32_reg)
+INIT_CPU(MovR32E32AddR32I32NoFlags, movr32e32_add32_reg_noflags)
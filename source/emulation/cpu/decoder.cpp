@@ -1369,6 +1369,13 @@ const InstructionInfo instructionInfo[] = {
     {0, 0, 0, 0, 0, 0}, // ShufpdXmmXmm
     {0, 128, 0, 0, 0, 0}, // ShufpdXmmE128
     {0, 0, 0, 0, 0, 0}, // Pause
+    {0, 0, 0, CF|AF|ZF|SF|OF|PF, 0, 0, 0}, // CmpR32R32Jcc
+    {0, 0, 0, CF|AF|ZF|SF|OF|PF, 0, 0, 0}, // CmpR32I32Jcc
+    {0, 0, 0, CF|AF|ZF|SF|OF|PF, 0, 0, 0}, // TestR32R32Jcc
+    {0, 0, 0, AF|ZF|SF|OF|PF, 0, 0, 0}, // DecR32Jnz
+    {0, 0, 32, 0, 0, 0, 0}, // PushEbpMovEbpEsp
+    {0, 32, 0, 0, 0, 0, 0}, // MovR32E32AddR32I32
+    {0, 32, 0, 0, 0, 0, 0}, // MovR32E32AddR32I32NoFlags
 
     {DECODE_BRANCH_NO_CACHE, 0, 0, 0, 0, 0}, // Callback
     {DECODE_BRANCH_NO_CACHE, 0, 0, 0, 0, 0}, // Done
@@ -3149,7 +3156,14 @@ const LogInstruction instructionLog[] = {
     {"Packuswb", 128, logXmmE},
     {"Shufpd", 0, logXmmXmm},
     {"Shufpd", 128, logXmmE},
-    {"Pause", 0, logName}
+    {"Pause", 0, logName},
+    {"Cmp", 32, logRR},
+    {"Cmp", 32, logR, true},
+    {"Test", 32, logRR},
+    {"Dec", 32, logR},
+    {"Push", 32, logR},
+    {"Mov", 32, logRE},
+    {"Mov", 32, logRE}
 };
 #endif
 class DecodeData {
@@ -3161,11 +3175,38 @@ public:
     U32 opCode;
     U32 inst;
 
-    U8 fetch8();
-    U16 fetch16();
-    U32 fetch32();
+    U8 fetch8() {
+        this->opLen++;
+        if (this->host && this->eip - this->hostStart < K_PAGE_SIZE) {
+            return this->host[this->eip++ - this->hostStart];
+        }
+        return this->fetchByte(&this->eip);
+    }
+    U16 fetch16() {
+        if (this->host && this->eip - this->hostStart <= K_PAGE_SIZE - 2) {
+            U16 result;
+            memcpy(&result, this->host + (this->eip - this->hostStart), 2);
+            this->eip += 2;
+            this->opLen += 2;
+            return result;
+        }
+        return ((U16)this->fetch8()) | (((U16)this->fetch8()) << 8);
+    }
+    U32 fetch32() {
+        if (this->host && this->eip - this->hostStart <= K_PAGE_SIZE - 4) {
+            U32 result;
+            memcpy(&result, this->host + (this->eip - this->hostStart), 4);
+            this->eip += 4;
+            this->opLen += 4;
+            return result;
+        }
+        return ((U32)this->fetch16()) | (((U32)this->fetch16()) << 16);
+    }
 
     pfnFetchByte fetchByte;
+    // bytes on the page that starts at hostStart are read from host, anything else goes through fetchByte
+    const U8* host;
+    U32 hostStart;
     U32 eip;
     U32 opCountSoFarInThisBlock;
     U8 opLen;
@@ -5934,32 +5975,34 @@ const Decode* const decoder[] = {
     &decodePsubb, &decodePsubw, &decodePsubd, &sse0x3fb, &decodePaddb, &decodePaddw, &decodePaddd, 0,
 };
 
-U8 DecodeData::fetch8() {
-    this->opLen++;
-    return this->fetchByte(&this->eip);
-}
-
-U16 DecodeData::fetch16() {
-    return ((U16)this->fetch8()) | (((U16)this->fetch8()) << 8);
-}
-
-U32 DecodeData::fetch32() {
-    return ((U32)this->fetch16()) | (((U32)this->fetch16()) << 16);
-}
+// decodeBlock puts all of a block's ops in one run, that way the interpreter walks them in order in memory and the
+// allocator is only locked once per block instead of once per op.  Runs are carved out of slabs and a run goes back
+// on the free list for its size once all of its ops have been deallocated, ops are never returned one at a time.
+#define DECODED_OP_SLAB_SIZE DECODED_OP_MAX_RUN
 
-static DecodedOp* freeOps;
+static DecodedOp* freeRuns[DECODED_OP_RUN_CLASSES];
+static std::vector<DecodedOp*> opSlabs;
+static U32 opSlabPos = DECODED_OP_SLAB_SIZE;
+static U32 liveRuns;
 BOXEDWINE_MUTEX freeOpsMutex;
 
-DecodedOp::DecodedOp() {
+DecodedOp::DecodedOp() : runIndex(0), runLive(0), runClass(0) {
     this->init();
 }
 
 void DecodedOp::clearCache() {
-    while (freeOps) {
-        DecodedOp* next = freeOps->next;
-        delete freeOps;
-        freeOps = next;
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(freeOpsMutex);
+
+    // the slabs can only be freed if nothing is still using an op in them
+    if (liveRuns) {
+        return;
+    }
+    for (auto& slab : opSlabs) {
+        delete[] slab;
     }
+    opSlabs.clear();
+    opSlabPos = DECODED_OP_SLAB_SIZE;
+    memset(freeRuns, 0, sizeof(freeRuns));
 }
 
 void DecodedOp::init() {
@@ -5977,34 +6020,92 @@ void DecodedOp::init() {
     this->repNotZero = 0;
     this->pfn = NULL;
 }
+
 DecodedOp* DecodedOp::alloc() {
+    return DecodedOp::allocRun(1);
+}
+
+DecodedOp* DecodedOp::allocRun(U32 count, const DecodedOp* from) {
+    U32 runClass = 0;
     DecodedOp* result;
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(freeOpsMutex);
 
-    if (freeOps) {
-        result = freeOps;
-        freeOps = freeOps->next;
-        result->init();
-        return result;
-    } else {
-        return new DecodedOp();
-    }    
+    if (count > DECODED_OP_MAX_RUN) {
+        kpanic("DecodedOp::allocRun %d ops is too many", count);
+    }
+    while ((1u << runClass) < count) {
+        runClass++;
+    }
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(freeOpsMutex);
+
+        result = freeRuns[runClass];
+        if (result) {
+            freeRuns[runClass] = result->next;
+        } else {
+            U32 size = 1 << runClass;
+
+            if (opSlabPos + size > DECODED_OP_SLAB_SIZE) {
+                // what is left of the current slab is still a whole number of smaller runs
+                for (S32 i = runClass - 1; i >= 0; i--) {
+                    if (opSlabPos + (1u << i) <= DECODED_OP_SLAB_SIZE) {
+                        DecodedOp* run = opSlabs.back() + opSlabPos;
+                        run->next = freeRuns[i];
+                        freeRuns[i] = run;
+                        opSlabPos += 1 << i;
+                    }
+                }
+                opSlabs.push_back(new DecodedOp[DECODED_OP_SLAB_SIZE]);
+                opSlabPos = 0;
+            }
+            result = opSlabs.back() + opSlabPos;
+            result->runClass = (U8)runClass;
+            opSlabPos += size;
+        }
+        liveRuns++;
+    }
+    for (U32 i = 0; i < count; i++) {
+        DecodedOp* op = &result[i];
+
+        if (from) {
+            *op = from[i];
+        } else {
+            op->init();
+        }
+        op->runIndex = (U16)i;
+        op->next = (i + 1 < count) ? op + 1 : NULL;
+    }
+    result->runLive = (U16)count;
+    result->runClass = (U8)runClass;
+    return result;
+}
+
+// called while holding freeOpsMutex
+void DecodedOp::freeRun(DecodedOp* first) {
+    first->next = freeRuns[first->runClass];
+    freeRuns[first->runClass] = first;
+    liveRuns--;
 }
 
 void DecodedOp::dealloc(bool deallocNext) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(freeOpsMutex);
+    DecodedOp* op = this;
+
+    while (op) {
+        DecodedOp* next = deallocNext ? op->next : NULL;
+        DecodedOp* first = op - op->runIndex;
 
 #ifdef _DEBUG
-    if (this->inst == InstructionCount) {
-        kpanic("tried to dealloc a DecodedOp that was already deallocated");
-    }
+        if (op->inst == InstructionCount) {
+            kpanic("tried to dealloc a DecodedOp that was already deallocated");
+        }
 #endif
-    if (deallocNext && this->next) {
-        this->next->dealloc(deallocNext);
+        op->inst = InstructionCount;
+        first->runLive--;
+        if (!first->runLive) {
+            freeRun(first);
+        }
+        op = next;
     }
-    this->next = freeOps;
-    this->inst = InstructionCount;
-    freeOps = this;
 }
 
 bool DecodedOp::isFpuOp() {
@@ -6132,15 +6233,27 @@ void DecodedBlock::removeReferenceFrom(DecodedBlock* block) {
 
 DecodedBlock* DecodedBlock::currentBlock;
 
-void decodeBlock(pfnFetchByte fetchByte, U32 eip, bool isBig, U32 maxInstructions, U32 maxLen, U32 stopIfThrowsException, DecodedBlock* block) {
+// ops are decoded here first, once the block is done they are copied to a run that is just big enough
+//
+// thread_local instead of THREAD_LOCAL because __declspec(thread) can't destroy the vector when the thread exits
+static thread_local std::vector<DecodedOp> decodeScratch;
+
+void decodeBlock(pfnFetchByte fetchByte, U32 eip, bool isBig, U32 maxInstructions, U32 maxLen, U32 stopIfThrowsException, DecodedBlock* block, const U8* host) {
     DecodeData d;    
-    DecodedOp* op = DecodedOp::alloc();
+    U32 count = 1;
+
+    if (decodeScratch.empty()) {
+        decodeScratch.resize(64);
+    }
+    DecodedOp* op = &decodeScratch[0];
+    op->init();
 
     d.fetchByte = fetchByte;
+    d.host = host;
+    d.hostStart = eip & ~K_PAGE_MASK;
     d.eip = eip;
     d.opCountSoFarInThisBlock = 0;
 
-    block->op = op;
     block->bytes = 0;
     block->opCount = 0;
     while (1) {
@@ -6168,7 +6281,7 @@ void decodeBlock(pfnFetchByte fetchByte, U32 eip, bool isBig, U32 maxInstruction
         }
         d.opCountSoFarInThisBlock++;
         block->opCount++;
-        if (maxLen && d.opLen+block->bytes>maxLen) {
+        if ((maxLen && d.opLen+block->bytes>maxLen) || count == DECODED_OP_MAX_RUN) {
             op->inst = Done;
             op->len = 0;
             break;
@@ -6181,9 +6294,13 @@ void decodeBlock(pfnFetchByte fetchByte, U32 eip, bool isBig, U32 maxInstruction
 #endif
         if ((maxInstructions && maxInstructions<=block->opCount) || instructionInfo[op->inst].branch || (stopIfThrowsException && instructionInfo[op->inst].throwsException))
             break;
-        op->next = DecodedOp::alloc();
-        op = op->next;
+        if (count == decodeScratch.size()) {
+            decodeScratch.resize(count * 2);
+        }
+        op = &decodeScratch[count++];
+        op->init();
     }
+    block->op = DecodedOp::allocRun(count, decodeScratch.data());
 }
 
 const char* DecodedOp::name() {
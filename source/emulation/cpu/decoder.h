@@ -1400,6 +1400,15 @@ enum Instruction {
     ShufpdXmmE128,
     Pause,
 
+    // pairs fused by the normal core after a block is decoded, the second op of the pair stays in the block after the fused op
+    CmpR32R32Jcc,
+    CmpR32I32Jcc,
+    TestR32R32Jcc,
+    DecR32Jnz,
+    PushEbpMovEbpEsp,
+    MovR32E32AddR32I32,
+    MovR32E32AddR32I32NoFlags,
+
     None,
     Callback,
     Done,
@@ -1439,13 +1448,20 @@ class DecodedBlock;
 
 typedef void (OPCALL *OpCallback)(CPU* cpu, DecodedOp* op);
 
+// ops are allocated in runs, a run is a contiguous array of ops with a power of 2 capacity
+#define DECODED_OP_RUN_CLASSES 14
+#define DECODED_OP_MAX_RUN (1 << (DECODED_OP_RUN_CLASSES - 1))
+
 class DecodedOp {
 public:    
     static DecodedOp* alloc();
+    // count ops next to each other in memory and already linked through next, if from is not NULL they are copies of it
+    static DecodedOp* allocRun(U32 count, const DecodedOp* from = NULL);
     static void clearCache();
 
     DecodedOp();
 
+    void init();
     void dealloc(bool deallocNext);    
     void log(CPU* cpu);
     bool needsToSetFlags();
@@ -1483,7 +1499,12 @@ public:
     U8 repNotZero;    
     U8 ea16;
 private:
-    void init();
+    static void freeRun(DecodedOp* first);
+
+    // the first op of a run counts how many of its ops have not been deallocated yet
+    U16 runIndex;
+    U16 runLive;
+    U8 runClass;
 };
 
 typedef U8 (*pfnFetchByte)(U32* pEip);
@@ -1522,6 +1543,7 @@ public:
 protected:
     DecodedBlockFromNode* referencedFrom;
 };
-void decodeBlock(pfnFetchByte fetchByte, U32 eip, bool isBig, U32 maxInstructions, U32 maxLen, U32 stopIfThrowsException, DecodedBlock* block);
+// if host is not NULL it is where the page eip is on can be read in host memory, only bytes past that page use fetchByte
+void decodeBlock(pfnFetchByte fetchByte, U32 eip, bool isBig, U32 maxInstructions, U32 maxLen, U32 stopIfThrowsException, DecodedBlock* block, const U8* host = NULL);
 
 #endif
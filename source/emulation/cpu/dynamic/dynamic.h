@@ -2,6 +2,7 @@
 #define __DYNAMIC_H__
 
 #include "../common/cpu.h"
+#include "../normal/normalCPU.h"
 
 class DynamicData {
 public:
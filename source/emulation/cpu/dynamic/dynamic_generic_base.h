@@ -949,11 +949,7 @@ static void initDynOps() {
 }
 
 void OPCALL firstDynamicOp(CPU* cpu, DecodedOp* op) {
-#ifdef __TEST
-    if (DecodedBlock::currentBlock->runCount == 0) {
-#else
-    if (DecodedBlock::currentBlock->runCount == 50) {
-#endif
+    if (DecodedBlock::currentBlock->runCount >= NormalCPU::promoteThreshold) {
         DynamicData data;
         data.cpu = cpu;
         data.block = DecodedBlock::currentBlock;
@@ -1024,6 +1020,8 @@ void OPCALL firstDynamicOp(CPU* cpu, DecodedOp* op) {
             });
 
         memory->dynamicExecutableMemoryPos += outBufferPos;
+        NormalCPU::promotedBlocks++;
+        NormalCPU::promotedBytes += outBufferPos;
 
         bool b = false;
         if (b) {
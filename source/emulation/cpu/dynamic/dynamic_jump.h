@@ -158,3 +158,18 @@ void dynamic_jumpNLE(DynamicData* data, DecodedOp* op) {
     blockNext1();
     endIf();
 }
+
+// cmp/test/dec fused with the jcc after it by the normal core. The jcc is still the next op in the block so only
+// the first half is generated here, the generated code already skips the lazy flags when they aren't needed
+void dynamic_cmpr32r32_jcc(DynamicData* data, DecodedOp* op) {
+    dynamic_cmpr32r32(data, op);
+}
+void dynamic_cmp32_reg_jcc(DynamicData* data, DecodedOp* op) {
+    dynamic_cmp32_reg(data, op);
+}
+void dynamic_testr32r32_jcc(DynamicData* data, DecodedOp* op) {
+    dynamic_testr32r32(data, op);
+}
+void dynamic_dec32_reg_jnz(DynamicData* data, DecodedOp* op) {
+    dynamic_dec32_reg(data, op);
+}
@@ -202,3 +202,11 @@ void dynamic_leaR32(DynamicData* data, DecodedOp* op) {
     calculateEaa(op, DYN_ADDRESS); movToCpuFromReg(CPU_OFFSET_OF(reg[op->reg].u32), DYN_ADDRESS, DYN_32bit, true);
     INCREMENT_EIP(data, op);
 }
+
+// fused by the normal core, the add is still the next op in the block
+void dynamic_movr32e32_add32_reg(DynamicData* data, DecodedOp* op) {
+    dynamic_movr32e32(data, op);
+}
+void dynamic_movr32e32_add32_reg_noflags(DynamicData* data, DecodedOp* op) {
+    dynamic_movr32e32(data, op);
+}
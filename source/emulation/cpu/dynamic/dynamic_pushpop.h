@@ -171,3 +171,8 @@ void dynamic_pushf32(DynamicData* data, DecodedOp* op) {
     dynamic_pushReg32(data, DYN_SRC, true);
     INCREMENT_EIP(data, op);
 }
+
+// fused by the normal core, the mov is still the next op in the block
+void dynamic_pushEbp_movEbpEsp(DynamicData* data, DecodedOp* op) {
+    dynamic_pushEd_reg(data, op);
+}
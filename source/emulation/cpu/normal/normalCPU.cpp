@@ -14,6 +14,8 @@
 #endif
 #define NEXT() cpu->eip.u32+=op->len; op->next->pfn(cpu, op->next)
 #define NEXT_DONE() cpu->nextBlock = cpu->getNextBlock();
+#define NEXT_DONE_RETURN() cpu->nextBlock = cpu->getNextReturnBlock();
+#define PREDICT_RETURN(returnEip) cpu->pushReturnPrediction(returnEip)
 #define NEXT_BRANCH1() cpu->eip.u32+=op->len; if (!DecodedBlock::currentBlock->next1) {DecodedBlock::currentBlock->next1 = cpu->getNextBlock(); DecodedBlock::currentBlock->next1->addReferenceFrom(DecodedBlock::currentBlock);} cpu->nextBlock = DecodedBlock::currentBlock->next1
 #define NEXT_BRANCH2() cpu->eip.u32+=op->len; if (!DecodedBlock::currentBlock->next2) {DecodedBlock::currentBlock->next2 = cpu->getNextBlock(); DecodedBlock::currentBlock->next2->addReferenceFrom(DecodedBlock::currentBlock);} cpu->nextBlock = DecodedBlock::currentBlock->next2
 
@@ -93,7 +95,23 @@ OpCallback NormalCPU::getFunctionForOp(DecodedOp* op) {
     return normalOps[op->inst];
 }
 
-NormalCPU::NormalCPU() {   
+#ifdef __TEST
+U32 NormalCPU::promoteThreshold = 0; // the cpu tests only run each block once
+#else
+U32 NormalCPU::promoteThreshold = 50;
+#endif
+U32 NormalCPU::promotedBlocks;
+U64 NormalCPU::promotedBytes;
+
+NormalCPU::NormalCPU() : 
+    blockCacheHits(0),
+    blockCacheMisses(0),
+    returnPredictionHits(0),
+    returnPredictionMisses(0),
+    returnStackTop(0),
+    blockCacheMemory(NULL) {
+    memset(this->blockCache, 0, sizeof(this->blockCache));
+    memset(this->returnStack, 0, sizeof(this->returnStack));
     initNormalOps();
 #ifdef BOXEDWINE_DYNAMIC
     this->firstOp = firstDynamicOp;
@@ -109,6 +127,17 @@ U8 fetchByte(U32 *eip) {
     return readb((*eip)++);
 }
 
+// the page a block starts on is decoded straight from host memory, fetchByte is only used for the bytes after it.
+// 16-bit code always uses fetchByte since it checks for eip wrapping around.
+static const U8* getDecodeAddress(U32 address, bool big) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+    if (big) {
+        return getPhysicalReadAddress(address & ~K_PAGE_MASK, K_PAGE_SIZE);
+    }
+#endif
+    return NULL;
+}
+
 class NormalBlock : public DecodedBlock {
 public:
     static NormalBlock* alloc();
@@ -120,6 +149,8 @@ public:
 
     void run(CPU* cpu);
 
+    Memory* memory; // the memory whose code cache has this block, NULL if it isn't in one
+
 private:
     void init();
     NormalBlock* next;
@@ -144,6 +175,7 @@ static NormalBlock* freeBlocks;
 
 void NormalBlock::init() {
     this->next = 0;
+    this->memory = NULL;
     this->op = NULL;
     this->bytes = 0;
     this->opCount = 0;
@@ -176,6 +208,9 @@ NormalBlock* NormalBlock::alloc() {
 
 void NormalBlock::dealloc(bool delayed) {
     KThread* thread = KThread::currentThread();
+    if (this->memory) {
+        this->memory->blockGeneration++;
+    }
     if (thread) {
         CPU* cpu = thread->cpu;
         if (cpu && cpu->delayedFreeBlock && cpu->delayedFreeBlock != DecodedBlock::currentBlock) {
@@ -222,23 +257,70 @@ void NormalBlock::dealloc(bool delayed) {
 
 DecodedBlock* NormalCPU::getBlockForInspectionButNotUsed(U32 address, bool big) {
     DecodedBlock* block = NormalBlock::alloc();
-    decodeBlock(fetchByte, address, big, 0, K_PAGE_SIZE, 0, block);
+    decodeBlock(fetchByte, address, big, 0, K_PAGE_SIZE, 0, block, getDecodeAddress(address, big));
     block->address = address;
     return block;
 }
 
+// Fuses common pairs of ops so that the normal core only dispatches once for them.  The second op of the pair is
+// left in the block after the fused op, the fused handler runs it and then continues with the op after it.  That way
+// the dynamic cores and the flag liveness checks still see the same ops as before.
+static void fuseOps(DecodedBlock* block) {
+    DecodedOp* op = block->op;
+
+    while (op && op->next) {
+        DecodedOp* next = op->next;
+        U32 inst = op->inst;
+
+        if ((inst == CmpR32R32 || inst == CmpR32I32 || inst == TestR32R32) && next->inst >= JumpO && next->inst <= JumpNLE) {
+            if (inst == CmpR32R32) {
+                op->inst = CmpR32R32Jcc;
+            } else if (inst == CmpR32I32) {
+                op->inst = CmpR32I32Jcc;
+            } else {
+                op->inst = TestR32R32Jcc;
+            }
+        } else if (inst == DecR32 && next->inst == JumpNZ) {
+            op->inst = DecR32Jnz;
+        } else if (inst == PushR32 && op->reg == 5 && next->inst == MovR32R32 && next->reg == 5 && next->rm == 4) {
+            op->inst = PushEbpMovEbpEsp;
+        } else if (inst == MovR32E32 && next->inst == AddR32I32 && next->reg == op->reg) {
+            // the add's flags are often overwritten before they are read, this can only see to the end of the block
+            if (DecodedOp::getNeededFlags(block, next, instructionInfo[AddR32I32].flagsSets & ~MAYBE)) {
+                op->inst = MovR32E32AddR32I32;
+            } else {
+                op->inst = MovR32E32AddR32I32NoFlags;
+            }
+        }
+        if (op->inst != inst) {
+            // the second op of the pair can't start another pair
+            op = next;
+        }
+        op = op->next;
+    }
+}
+
 DecodedBlock* NormalCPU::getNextBlock() {
     if (!this->thread->process) // exit was called, don't need to pre-cache the next block
         return NULL;
 
     U32 startIp = (this->big?this->eip.u32:this->eip.u16) + this->seg[CS].address;
-    DecodedBlock* block = this->thread->memory->getCodeBlock(startIp);
+    DecodedBlock* block = this->getCachedBlock(startIp);
 
+    if (block) {
+        this->blockCacheHits++;
+        return block;
+    }
+    this->blockCacheMisses++;
+    block = this->thread->memory->getCodeBlock(startIp);
     if (!block) {
-        block = NormalBlock::alloc();
-        decodeBlock(fetchByte, startIp, this->isBig(), 0, K_PAGE_SIZE, 0, block);
+        NormalBlock* normalBlock = NormalBlock::alloc();
+        normalBlock->memory = this->thread->memory;
+        block = normalBlock;
+        decodeBlock(fetchByte, startIp, this->isBig(), 0, K_PAGE_SIZE, 0, block, getDecodeAddress(startIp, this->isBig()));
         block->address = startIp;
-        
+        fuseOps(block);
+
         DecodedOp* op = block->op;
         while (op) {
             if (!op->pfn) // callback will be set by decoder
@@ -254,9 +336,59 @@ DecodedBlock* NormalCPU::getNextBlock() {
             block->op = op;
         }
     }
+    this->cacheBlock(startIp, block);
     return block;
 }
 
+DecodedBlock* NormalCPU::getCachedBlock(U32 startIp) {
+    if (this->blockCacheMemory != this->thread->memory) {
+        // blocks cached for one memory are not valid for another one, even at the same address
+        memset(this->blockCache, 0, sizeof(this->blockCache));
+        memset(this->returnStack, 0, sizeof(this->returnStack));
+        this->blockCacheMemory = this->thread->memory;
+        return NULL;
+    }
+    BlockCacheEntry& entry = this->blockCache[startIp & (NORMAL_BLOCK_CACHE_SIZE - 1)];
+    if (entry.eip == startIp && entry.generation == this->blockCacheMemory->blockGeneration) {
+        return entry.block;
+    }
+    return NULL;
+}
+
+void NormalCPU::cacheBlock(U32 startIp, DecodedBlock* block) {
+    BlockCacheEntry& entry = this->blockCache[startIp & (NORMAL_BLOCK_CACHE_SIZE - 1)];
+    entry.eip = startIp;
+    entry.generation = this->thread->memory->blockGeneration;
+    entry.block = block;
+}
+
+void NormalCPU::pushReturnPrediction(U32 returnEip) {
+    U32 startIp = (this->big?returnEip:(returnEip & 0xFFFF)) + this->seg[CS].address;
+
+    this->returnStackTop = (this->returnStackTop + 1) & (NORMAL_RETURN_STACK_SIZE - 1);
+    BlockCacheEntry& entry = this->returnStack[this->returnStackTop];
+    entry.eip = startIp;
+    entry.generation = this->thread->memory->blockGeneration;
+    // will be NULL the first time through a call, then the ret will fall back to getNextBlock
+    entry.block = this->getCachedBlock(startIp);
+}
+
+DecodedBlock* NormalCPU::getNextReturnBlock() {
+    if (!this->thread->process) // exit was called, don't need to pre-cache the next block
+        return NULL;
+
+    U32 startIp = (this->big?this->eip.u32:this->eip.u16) + this->seg[CS].address;
+    BlockCacheEntry& entry = this->returnStack[this->returnStackTop];
+
+    this->returnStackTop = (this->returnStackTop - 1) & (NORMAL_RETURN_STACK_SIZE - 1);
+    if (entry.block && entry.eip == startIp && this->blockCacheMemory == this->thread->memory && entry.generation == this->blockCacheMemory->blockGeneration) {
+        this->returnPredictionHits++;
+        return entry.block;
+    }
+    this->returnPredictionMisses++;
+    return this->getNextBlock();
+}
+
 void NormalCPU::run() {    
     DecodedBlock::currentBlock = this->nextBlock;
     DecodedBlock::currentBlock->run(this);    
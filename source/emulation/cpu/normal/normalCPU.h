@@ -3,6 +3,10 @@
 
 #include "../common/cpu.h"
 
+// direct mapped, indexed by eip, so that indirect jumps and returns usually don't need to look in the code page
+#define NORMAL_BLOCK_CACHE_SIZE 1024
+#define NORMAL_RETURN_STACK_SIZE 16
+
 class NormalCPU : public CPU {
 public:
     NormalCPU();
@@ -12,11 +16,41 @@ public:
     virtual void run();
     virtual DecodedBlock* getNextBlock();
 
+    // call ops remember where they will return to, ret ops then check that first
+    virtual void pushReturnPrediction(U32 returnEip);
+    virtual DecodedBlock* getNextReturnBlock();
+
     static OpCallback getFunctionForOp(DecodedOp* op);
 
     static DecodedBlock* getBlockForInspectionButNotUsed(U32 address, bool big);
 
+    // blocks start out in the interpreter, the dynamic core only generates code for a block once it has run this many times.
+    // The x64 binary translator isn't tiered, it has no interpreter to fall back to and translates each chunk it reaches
+    static U32 promoteThreshold;
+    static U32 promotedBlocks;
+    static U64 promotedBytes;
+
     OpCallback firstOp;
+
+    // debug counters
+    U64 blockCacheHits;
+    U64 blockCacheMisses;
+    U64 returnPredictionHits;
+    U64 returnPredictionMisses;
+
+private:
+    struct BlockCacheEntry {
+        U32 eip;
+        U32 generation;
+        DecodedBlock* block;
+    };
+    DecodedBlock* getCachedBlock(U32 startIp);
+    void cacheBlock(U32 startIp, DecodedBlock* block);
+
+    BlockCacheEntry blockCache[NORMAL_BLOCK_CACHE_SIZE];
+    BlockCacheEntry returnStack[NORMAL_RETURN_STACK_SIZE];
+    U32 returnStackTop;
+    Memory* blockCacheMemory;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -80,3 +80,101 @@ void OPCALL normal_jumpNLE(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     if (!cpu->getZF() && cpu->getSF()==cpu->getOF()) {cpu->eip.u32+=op->imm; NEXT_BRANCH1();} else {NEXT_BRANCH2();}
 }
+
+// cmp/test fused with the jcc after it, the condition comes straight from the operands instead of the lazy flags.
+// The lazy flags are still set because the next block might read them.
+static bool normal_cmp32Condition(CPU* cpu, U32 inst) {
+    U32 dst = cpu->dst.u32;
+    U32 src = cpu->src.u32;
+
+    switch (inst) {
+    case JumpO: return (((dst ^ src) & (dst ^ cpu->result.u32)) & 0x80000000) != 0;
+    case JumpNO: return (((dst ^ src) & (dst ^ cpu->result.u32)) & 0x80000000) == 0;
+    case JumpB: return dst < src;
+    case JumpNB: return dst >= src;
+    case JumpZ: return dst == src;
+    case JumpNZ: return dst != src;
+    case JumpBE: return dst <= src;
+    case JumpNBE: return dst > src;
+    case JumpS: return (cpu->result.u32 & 0x80000000) != 0;
+    case JumpNS: return (cpu->result.u32 & 0x80000000) == 0;
+    case JumpP: return cpu->getPF() != 0;
+    case JumpNP: return cpu->getPF() == 0;
+    case JumpL: return (S32)dst < (S32)src;
+    case JumpNL: return (S32)dst >= (S32)src;
+    case JumpLE: return (S32)dst <= (S32)src;
+    case JumpNLE: return (S32)dst > (S32)src;
+    default: kpanic("normal_cmp32Condition unexpected inst: %d", inst); return false;
+    }
+}
+
+// test always clears CF and OF
+static bool normal_test32Condition(CPU* cpu, U32 inst) {
+    S32 result = (S32)cpu->result.u32;
+
+    switch (inst) {
+    case JumpO: return false;
+    case JumpNO: return true;
+    case JumpB: return false;
+    case JumpNB: return true;
+    case JumpZ: return result == 0;
+    case JumpNZ: return result != 0;
+    case JumpBE: return result == 0;
+    case JumpNBE: return result != 0;
+    case JumpS: return result < 0;
+    case JumpNS: return result >= 0;
+    case JumpP: return cpu->getPF() != 0;
+    case JumpNP: return cpu->getPF() == 0;
+    case JumpL: return result < 0;
+    case JumpNL: return result >= 0;
+    case JumpLE: return result <= 0;
+    case JumpNLE: return result > 0;
+    default: kpanic("normal_test32Condition unexpected inst: %d", inst); return false;
+    }
+}
+
+void OPCALL normal_cmpr32r32_jcc(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->dst.u32 = cpu->reg[op->reg].u32;
+    cpu->src.u32 = cpu->reg[op->rm].u32;
+    cpu->result.u32 = cpu->dst.u32 - cpu->src.u32;
+    cpu->lazyFlags = FLAGS_CMP32;
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    if (normal_cmp32Condition(cpu, op->inst)) {cpu->eip.u32+=op->imm; NEXT_BRANCH1();} else {NEXT_BRANCH2();}
+}
+void OPCALL normal_cmp32_reg_jcc(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->dst.u32 = cpu->reg[op->reg].u32;
+    cpu->src.u32 = op->imm;
+    cpu->result.u32 = cpu->dst.u32 - cpu->src.u32;
+    cpu->lazyFlags = FLAGS_CMP32;
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    if (normal_cmp32Condition(cpu, op->inst)) {cpu->eip.u32+=op->imm; NEXT_BRANCH1();} else {NEXT_BRANCH2();}
+}
+void OPCALL normal_testr32r32_jcc(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->dst.u32 = cpu->reg[op->reg].u32;
+    cpu->src.u32 = cpu->reg[op->rm].u32;
+    cpu->result.u32 = cpu->dst.u32 & cpu->src.u32;
+    cpu->lazyFlags = FLAGS_TEST32;
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    if (normal_test32Condition(cpu, op->inst)) {cpu->eip.u32+=op->imm; NEXT_BRANCH1();} else {NEXT_BRANCH2();}
+}
+void OPCALL normal_dec32_reg_jnz(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->oldCF=cpu->getCF();
+    cpu->dst.u32=cpu->reg[op->reg].u32;
+    cpu->result.u32=cpu->dst.u32 - 1;
+    cpu->lazyFlags = FLAGS_DEC32;
+    cpu->reg[op->reg].u32 = cpu->result.u32;
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    if (cpu->result.u32) {cpu->eip.u32+=op->imm; NEXT_BRANCH1();} else {NEXT_BRANCH2();}
+}
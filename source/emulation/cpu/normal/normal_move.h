@@ -237,4 +237,28 @@ void OPCALL normal_movCRxRd(CPU* cpu, DecodedOp* op) {
     } else {
         NEXT_DONE();
     };
-}
\ No newline at end of file
+}
+
+// mov reg, [mem]; add reg, imm fused into one op, the add is still the next op in the block
+void OPCALL normal_movr32e32_add32_reg(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    cpu->dst.u32 = readd(eaa(cpu, op));
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    cpu->src.u32 = op->imm;
+    cpu->result.u32 = cpu->dst.u32 + cpu->src.u32;
+    cpu->lazyFlags = FLAGS_ADD32;
+    cpu->reg[op->reg].u32 = cpu->result.u32;
+    NEXT();
+}
+// same as above when the flags from the add are overwritten before anything in the block reads them
+void OPCALL normal_movr32e32_add32_reg_noflags(CPU* cpu, DecodedOp* op) {
+    START_OP(cpu, op);
+    U32 value = readd(eaa(cpu, op));
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    cpu->reg[op->reg].u32 = value + op->imm;
+    NEXT();
+}
@@ -154,24 +154,24 @@ void OPCALL normal_retn16Iw(CPU* cpu, DecodedOp* op) {
     U16 eip = cpu->pop16();
     SP = SP+op->imm;
     cpu->eip.u32 = eip;
-    NEXT_DONE();
+    NEXT_DONE_RETURN();
 }
 void OPCALL normal_retn32Iw(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     U32 eip = cpu->pop32();
     ESP = ESP+op->imm;
     cpu->eip.u32 = eip;
-    NEXT_DONE();
+    NEXT_DONE_RETURN();
 }
 void OPCALL normal_retn16(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     cpu->eip.u32 = cpu->pop16();
-    NEXT_DONE();
+    NEXT_DONE_RETURN();
 }
 void OPCALL normal_retn32(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     cpu->eip.u32 = cpu->pop32();
-    NEXT_DONE();
+    NEXT_DONE_RETURN();
 }
 void OPCALL normal_invalid(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
@@ -426,12 +426,14 @@ void OPCALL normal_OutDxEax(CPU* cpu, DecodedOp* op) {
 void OPCALL normal_callJw(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     cpu->push16(cpu->eip.u32 + op->len);
+    PREDICT_RETURN(cpu->eip.u32 + op->len);
     cpu->eip.u32 += (S16)op->imm;
     NEXT_BRANCH1();
 }
 void OPCALL normal_callJd(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     cpu->push32(cpu->eip.u32 + op->len);
+    PREDICT_RETURN(cpu->eip.u32 + op->len);
     cpu->eip.u32 += (S32)op->imm;
     NEXT_BRANCH1();
 }
@@ -453,12 +455,14 @@ void OPCALL normal_jmp32(CPU* cpu, DecodedOp* op) {
 void OPCALL normal_callR16(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     cpu->push16(cpu->eip.u32+op->len);
+    PREDICT_RETURN(cpu->eip.u32+op->len);
     cpu->eip.u32 = cpu->reg[op->reg].u16;
     NEXT_DONE();
 }
 void OPCALL normal_callR32(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     cpu->push32(cpu->eip.u32+op->len);
+    PREDICT_RETURN(cpu->eip.u32+op->len);
     cpu->eip.u32 = cpu->reg[op->reg].u32;
     NEXT_DONE();
 }
@@ -466,6 +470,7 @@ void OPCALL normal_callE16(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     U32 neweip = readw(eaa(cpu, op));
     cpu->push16(cpu->eip.u32+op->len);
+    PREDICT_RETURN(cpu->eip.u32+op->len);
     cpu->eip.u32 = neweip;
     NEXT_DONE();
 }
@@ -473,6 +478,7 @@ void OPCALL normal_callE32(CPU* cpu, DecodedOp* op) {
     START_OP(cpu, op);
     U32 neweip = readd(eaa(cpu, op));
     cpu->push32(cpu->eip.u32+op->len);
+    PREDICT_RETURN(cpu->eip.u32+op->len);
     cpu->eip.u32 = neweip;
     NEXT_DONE();
 }
@@ -129,3 +129,14 @@ void OPCALL normal_pushf32(CPU* cpu, DecodedOp* op){
     cpu->push32((cpu->flags|2) & 0xFCFFFF);
     NEXT();
 }
+
+// push ebp; mov ebp, esp fused into one op, the mov is still the next op in the block
+void OPCALL normal_pushEbp_movEbpEsp(CPU* cpu, DecodedOp* op){
+    START_OP(cpu, op);
+    cpu->push32(EBP);
+    cpu->eip.u32+=op->len;
+    op = op->next;
+    START_OP(cpu, op);
+    EBP = ESP;
+    NEXT();
+}
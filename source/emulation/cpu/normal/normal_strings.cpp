@@ -17,6 +17,199 @@
  */
 
 #include "boxedwine.h"
+
+#ifdef BOXEDWINE_DEFAULT_MMU
+// The 32-bit REP string ops work on host memory a page at a time when they can, so that each element doesn't need
+// its own page lookup.  If a page can't be used directly, like a code page or a page that would fault, the caller
+// does the next element the slow way, that way a fault still happens on the right element with ECX, ESI and EDI
+// updated for everything before it.
+
+// how many whole elements, starting with the one at address and moving in the direction of inc, are on its page
+static U32 stringElementsOnPage(U32 address, S32 inc, U32 size) {
+    U32 offset = address & K_PAGE_MASK;
+
+    if (offset + size > K_PAGE_SIZE) {
+        return 0;
+    }
+    if (inc > 0) {
+        return (K_PAGE_SIZE - offset) / size;
+    }
+    return offset / size + 1;
+}
+
+static U32 stringElementsOnPage(U32 address1, U32 address2, S32 inc, U32 size, U32 count) {
+    U32 result = stringElementsOnPage(address1, inc, size);
+    U32 result2 = stringElementsOnPage(address2, inc, size);
+
+    if (result2 < result) {
+        result = result2;
+    }
+    if (count < result) {
+        result = count;
+    }
+    return result;
+}
+
+// lowest address touched by len bytes of elements starting at address
+static U32 stringLowAddress(U32 address, S32 inc, U32 len, U32 size) {
+    return inc > 0 ? address : address - len + size;
+}
+
+// host offset of element i
+static U32 stringElementOffset(U32 i, S32 inc, U32 len, U32 size) {
+    return inc > 0 ? i * size : len - size - i * size;
+}
+
+static U32 movsPage(U32 dst, U32 src, S32 inc, U32 size, U32 count) {
+    U32 n = stringElementsOnPage(dst, src, inc, size, count);
+
+    if (!n) {
+        return 0;
+    }
+    U32 len = n * size;
+    // the destination first, making it writable can replace a copy on write page which src might be on too
+    U8* d = getPhysicalWriteAddress(stringLowAddress(dst, inc, len, size), len);
+    if (!d) {
+        return 0;
+    }
+    U8* s = getPhysicalReadAddress(stringLowAddress(src, inc, len, size), len);
+    if (!s) {
+        return 0;
+    }
+    if ((inc > 0 && d > s && d < s + len) || (inc < 0 && d < s && d + len > s)) {
+        // an element can read what an earlier element wrote, like a fill done with movsb and an offset of 1, memmove would give a different result
+        for (U32 i = 0; i < n; i++) {
+            U32 offset = stringElementOffset(i, inc, len, size);
+            memmove(d + offset, s + offset, size);
+        }
+    } else {
+        memmove(d, s, len);
+    }
+    return n;
+}
+
+#define STRING_PATTERN_SIZE 64
+
+// value repeated so that whole blocks of elements can be written or compared with one memcpy/memcmp
+template <typename T> static void stringFillPattern(U8* pattern, T value) {
+    for (U32 i = 0; i < STRING_PATTERN_SIZE; i += sizeof(T)) {
+        memcpy(pattern + i, &value, sizeof(T));
+    }
+}
+
+template <typename T> static U32 stosPage(U32 dst, S32 inc, T value, U32 count) {
+    U32 n = stringElementsOnPage(dst, dst, inc, sizeof(T), count);
+
+    if (!n) {
+        return 0;
+    }
+    U32 len = n * sizeof(T);
+    U8* d = getPhysicalWriteAddress(stringLowAddress(dst, inc, len, sizeof(T)), len);
+    if (!d) {
+        return 0;
+    }
+    if (sizeof(T) == 1) {
+        memset(d, (U8)value, len);
+    } else {
+        U8 pattern[STRING_PATTERN_SIZE];
+        U32 i = 0;
+
+        stringFillPattern(pattern, value);
+        for (; i + STRING_PATTERN_SIZE <= len; i += STRING_PATTERN_SIZE) {
+            memcpy(d + i, pattern, STRING_PATTERN_SIZE);
+        }
+        memcpy(d + i, pattern, len - i);
+    }
+    return n;
+}
+
+// *stop is set if the last element compared ended the repeat
+template <typename T> static U32 scasPage(U32 dst, S32 inc, T value, U32 rep_zero, U32 count, T* last, bool* stop) {
+    U32 n = stringElementsOnPage(dst, dst, inc, sizeof(T), count);
+
+    if (!n) {
+        return 0;
+    }
+    U32 len = n * sizeof(T);
+    U8* d = getPhysicalReadAddress(stringLowAddress(dst, inc, len, sizeof(T)), len);
+    if (!d) {
+        return 0;
+    }
+    if (sizeof(T) == 1 && !rep_zero && inc > 0) {
+        // repne scasb, strlen and memchr in the guest's crt
+        U8* found = (U8*)memchr(d, (U8)value, len);
+        if (found) {
+            *last = *found;
+            *stop = true;
+            return (U32)(found - d) + 1;
+        }
+        *last = d[len - 1];
+        return n;
+    }
+    if (rep_zero) {
+        // repe scas usually runs to the end of the page, check that a block at a time first
+        U8 pattern[STRING_PATTERN_SIZE];
+        U32 i = 0;
+
+        stringFillPattern(pattern, value);
+        while (i + STRING_PATTERN_SIZE <= len && !memcmp(d + i, pattern, STRING_PATTERN_SIZE)) {
+            i += STRING_PATTERN_SIZE;
+        }
+        if (i + STRING_PATTERN_SIZE > len && !memcmp(d + i, pattern, len - i)) {
+            *last = value;
+            return n;
+        }
+    }
+    for (U32 i = 0; i < n; i++) {
+        T v;
+        memcpy(&v, d + stringElementOffset(i, inc, len, sizeof(T)), sizeof(T));
+        if ((v == value) != (rep_zero != 0)) {
+            *last = v;
+            *stop = true;
+            return i + 1;
+        }
+    }
+    memcpy(last, d + stringElementOffset(n - 1, inc, len, sizeof(T)), sizeof(T));
+    return n;
+}
+
+template <typename T> static U32 cmpsPage(U32 dst, U32 src, S32 inc, U32 rep_zero, U32 count, T* last1, T* last2, bool* stop) {
+    U32 n = stringElementsOnPage(dst, src, inc, sizeof(T), count);
+
+    if (!n) {
+        return 0;
+    }
+    U32 len = n * sizeof(T);
+    U8* d = getPhysicalReadAddress(stringLowAddress(dst, inc, len, sizeof(T)), len);
+    if (!d) {
+        return 0;
+    }
+    U8* s = getPhysicalReadAddress(stringLowAddress(src, inc, len, sizeof(T)), len);
+    if (!s) {
+        return 0;
+    }
+    if (!rep_zero || memcmp(d, s, len)) {
+        for (U32 i = 0; i < n; i++) {
+            U32 offset = stringElementOffset(i, inc, len, sizeof(T));
+            T v1;
+            T v2;
+            memcpy(&v1, d + offset, sizeof(T));
+            memcpy(&v2, s + offset, sizeof(T));
+            if ((v1 == v2) != (rep_zero != 0)) {
+                *last1 = v1;
+                *last2 = v2;
+                *stop = true;
+                return i + 1;
+            }
+        }
+    }
+    // repe cmps usually gets here with the whole page matching
+    U32 offset = stringElementOffset(n - 1, inc, len, sizeof(T));
+    memcpy(last1, d + offset, sizeof(T));
+    memcpy(last2, s + offset, sizeof(T));
+    return n;
+}
+#endif
 void movsb16(CPU* cpu, U32 base) {
     U32 dBase = cpu->seg[ES].address;
     U32 sBase = cpu->seg[base].address;
@@ -51,12 +244,22 @@ void movsb32r(CPU* cpu, U32 base) {
     U32 sBase = cpu->seg[base].address;
     S32 inc = cpu->df;
     U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
+    while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+        U32 done = movsPage(dBase+EDI, sBase+ESI, inc, 1, count);
+        if (done) {
+            EDI+=inc*(S32)done;
+            ESI+=inc*(S32)done;
+            ECX-=done;
+            count-=done;
+            continue;
+        }
+#endif
         writeb(dBase+EDI, readb(sBase+ESI));
         EDI+=inc;
         ESI+=inc;
         ECX--;
+        count--;
     }
 }
 void movsw16(CPU* cpu, U32 base) {
@@ -93,12 +296,22 @@ void movsw32r(CPU* cpu, U32 base) {
     U32 sBase = cpu->seg[base].address;
     S32 inc = cpu->df << 1;
     U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
+    while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+        U32 done = movsPage(dBase+EDI, sBase+ESI, inc, 2, count);
+        if (done) {
+            EDI+=inc*(S32)done;
+            ESI+=inc*(S32)done;
+            ECX-=done;
+            count-=done;
+            continue;
+        }
+#endif
         writew(dBase+EDI, readw(sBase+ESI));
         EDI+=inc;
         ESI+=inc;
         ECX--;
+        count--;
     }
 }
 void movsd16(CPU* cpu, U32 base) {
@@ -135,12 +348,22 @@ void movsd32r(CPU* cpu, U32 base) {
     U32 sBase = cpu->seg[base].address;
     S32 inc = cpu->df << 2;
     U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
+    while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+        U32 done = movsPage(dBase+EDI, sBase+ESI, inc, 4, count);
+        if (done) {
+            EDI+=inc*(S32)done;
+            ESI+=inc*(S32)done;
+            ECX-=done;
+            count-=done;
+            continue;
+        }
+#endif
         writed(dBase+EDI, readd(sBase+ESI));
         EDI+=inc;
         ESI+=inc;
         ECX--;
+        count--;
     }
 }
 void cmpsb16(CPU* cpu, U32 rep_zero, U32 base) {
@@ -204,12 +427,25 @@ void cmpsb32r(CPU* cpu, U32 rep_zero, U32 base) {
     if (count) {
         U8 v1=0;
         U8 v2=0;
-        for (U32 i=0;i<count;i++) {
+        while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+            bool stop = false;
+            U32 done = cmpsPage<U8>(dBase+EDI, sBase+ESI, inc, rep_zero, count, &v1, &v2, &stop);
+            if (done) {
+                EDI+=inc*(S32)done;
+                ESI+=inc*(S32)done;
+                ECX-=done;
+                count-=done;
+                if (stop) break;
+                continue;
+            }
+#endif
             v1 = readb(dBase+EDI);
             v2 = readb(sBase+ESI);
             EDI+=inc;
             ESI+=inc;
             ECX--;
+            count--;
             if ((v1==v2)!=rep_zero) break;
         }
         cpu->dst.u8 = v2;
@@ -278,12 +514,25 @@ void cmpsw32r(CPU* cpu, U32 rep_zero, U32 base) {
     if (count) {
         U16 v1=0;
         U16 v2=0;
-        for (U32 i=0;i<count;i++) {
+        while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+            bool stop = false;
+            U32 done = cmpsPage<U16>(dBase+EDI, sBase+ESI, inc, rep_zero, count, &v1, &v2, &stop);
+            if (done) {
+                EDI+=inc*(S32)done;
+                ESI+=inc*(S32)done;
+                ECX-=done;
+                count-=done;
+                if (stop) break;
+                continue;
+            }
+#endif
             v1 = readw(dBase+EDI);
             v2 = readw(sBase+ESI);
             EDI+=inc;
             ESI+=inc;
             ECX--;
+            count--;
             if ((v1==v2)!=rep_zero) break;
         }
         cpu->dst.u16 = v2;
@@ -352,12 +601,25 @@ void cmpsd32r(CPU* cpu, U32 rep_zero, U32 base) {
     if (count) {
         U32 v1=0;
         U32 v2=0;
-        for (U32 i=0;i<count;i++) {
+        while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+            bool stop = false;
+            U32 done = cmpsPage<U32>(dBase+EDI, sBase+ESI, inc, rep_zero, count, &v1, &v2, &stop);
+            if (done) {
+                EDI+=inc*(S32)done;
+                ESI+=inc*(S32)done;
+                ECX-=done;
+                count-=done;
+                if (stop) break;
+                continue;
+            }
+#endif
             v1 = readd(dBase+EDI);
             v2 = readd(sBase+ESI);
             EDI+=inc;
             ESI+=inc;
             ECX--;
+            count--;
             if ((v1==v2)!=rep_zero) break;
         }
         cpu->dst.u32 = v2;
@@ -389,11 +651,20 @@ void stosb32r(CPU* cpu) {
     U32 dBase = cpu->seg[ES].address;
     S32 inc = cpu->df;
     U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
+    while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+        U32 done = stosPage<U8>(dBase+EDI, inc, AL, count);
+        if (done) {
+            EDI+=inc*(S32)done;
+            ECX-=done;
+            count-=done;
+            continue;
+        }
+#endif
         writeb(dBase+EDI, AL);
         EDI+=inc;
         ECX--;
+        count--;
     }
 }
 void stosw16(CPU* cpu) {
@@ -419,11 +690,20 @@ void stosw32r(CPU* cpu) {
     U32 dBase = cpu->seg[ES].address;
     S32 inc = cpu->df << 1;
     U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
+    while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+        U32 done = stosPage<U16>(dBase+EDI, inc, AX, count);
+        if (done) {
+            EDI+=inc*(S32)done;
+            ECX-=done;
+            count-=done;
+            continue;
+        }
+#endif
         writew(dBase+EDI, AX);
         EDI+=inc;
         ECX--;
+        count--;
     }
 }
 void stosd16(CPU* cpu) {
@@ -449,11 +729,20 @@ void stosd32r(CPU* cpu) {
     U32 dBase = cpu->seg[ES].address;
     S32 inc = cpu->df << 2;
     U32 count = ECX;
-    U32 i;
-    for (i=0;i<count;i++) {
+    while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+        U32 done = stosPage<U32>(dBase+EDI, inc, EAX, count);
+        if (done) {
+            EDI+=inc*(S32)done;
+            ECX-=done;
+            count-=done;
+            continue;
+        }
+#endif
         writed(dBase+EDI, EAX);
         EDI+=inc;
         ECX--;
+        count--;
     }
 }
 void lodsb16(CPU* cpu, U32 base) {
@@ -592,10 +881,22 @@ void scasb32r(CPU* cpu, U32 rep_zero) {
     U32 count = ECX;
     if (count) {
         U8 v1=0;
-        for (U32 i=0;i<count;i++) {
+        while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+            bool stop = false;
+            U32 done = scasPage<U8>(dBase+EDI, inc, AL, rep_zero, count, &v1, &stop);
+            if (done) {
+                EDI+=inc*(S32)done;
+                ECX-=done;
+                count-=done;
+                if (stop) break;
+                continue;
+            }
+#endif
             v1 = readb(dBase+EDI);
             EDI+=inc;
             ECX--;
+            count--;
             if ((AL==v1)!=rep_zero) break;
         }
         cpu->dst.u8 = AL;
@@ -650,10 +951,22 @@ void scasw32r(CPU* cpu, U32 rep_zero) {
     U32 count = ECX;
     if (count) {
         U16 v1=0;
-        for (U32 i=0;i<count;i++) {
+        while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+            bool stop = false;
+            U32 done = scasPage<U16>(dBase+EDI, inc, AX, rep_zero, count, &v1, &stop);
+            if (done) {
+                EDI+=inc*(S32)done;
+                ECX-=done;
+                count-=done;
+                if (stop) break;
+                continue;
+            }
+#endif
             v1 = readw(dBase+EDI);
             EDI+=inc;
             ECX--;
+            count--;
             if ((AX==v1)!=rep_zero) break;
         }
         cpu->dst.u16 = AX;
@@ -708,10 +1021,22 @@ void scasd32r(CPU* cpu, U32 rep_zero) {
     U32 count = ECX;
     if (count) {
         U32 v1=0;
-        for (U32 i=0;i<count;i++) {
+        while (count) {
+#ifdef BOXEDWINE_DEFAULT_MMU
+            bool stop = false;
+            U32 done = scasPage<U32>(dBase+EDI, inc, EAX, rep_zero, count, &v1, &stop);
+            if (done) {
+                EDI+=inc*(S32)done;
+                ECX-=done;
+                count-=done;
+                if (stop) break;
+                continue;
+            }
+#endif
             v1 = readd(dBase+EDI);
             EDI+=inc;
             ECX--;
+            count--;
             if ((EAX==v1)!=rep_zero) break;
         }
         cpu->dst.u32 = EAX;
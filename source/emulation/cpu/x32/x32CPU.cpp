@@ -2186,11 +2186,7 @@ static void initX32Ops() {
 }
 
 void OPCALL firstDynamicOp(CPU* cpu, DecodedOp* op) {
-#ifdef __TEST
-    if (DecodedBlock::currentBlock->runCount == 0) {
-#else
-    if (DecodedBlock::currentBlock->runCount == 50) {
-#endif
+    if (DecodedBlock::currentBlock->runCount >= NormalCPU::promoteThreshold) {
         DynamicData data;
         data.cpu = cpu;
         data.block = DecodedBlock::currentBlock;
@@ -2256,6 +2252,8 @@ void OPCALL firstDynamicOp(CPU* cpu, DecodedOp* op) {
         U8* begin = (U8*)mem+memory->dynamicExecutableMemoryPos;
         memcpy(begin, outBuffer, outBufferPos);
         memory->dynamicExecutableMemoryPos+=outBufferPos;
+        NormalCPU::promotedBlocks++;
+        NormalCPU::promotedBytes+=outBufferPos;
         
         for (U32 i=0;i<patch.size();i++) {
             U32 pos = patch[i];
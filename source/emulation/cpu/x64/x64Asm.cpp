@@ -259,6 +259,12 @@ void X64Asm::writeToRegFromValue(U8 reg, bool isRexReg, U64 value, U8 bytes) {
     }
 }
 
+// the address will be relocated if this code is loaded by X64CodeCache in a later run
+void X64Asm::writeToRegFromHostAddress(U8 reg, bool isRexReg, const void* address) {
+    writeToRegFromValue(reg, isRexReg, (U64)address, 8);
+    this->hostAddressPos.push_back(this->bufferPos - 8);
+}
+
 void X64Asm::writeHostPlusTmp(U8 rm, bool checkG, bool isG8bit, bool isE8bit, U8 tmpReg) {
     this->rex |= REX_BASE | REX_SIB_INDEX|REX_MOD_RM;    
     setRM(rm, checkG, false, isG8bit, isE8bit);
@@ -1618,7 +1624,7 @@ void X64Asm::callHost(void* pfn) {
     write8(0x74);
     U32 pos = this->bufferPos;
     write8(0);
-    writeToRegFromValue(tmp, true, (U64)badStack, 8);
+    writeToRegFromHostAddress(tmp, true, (void*)badStack);
     write8(REX_BASE | REX_64);
     write8(0x83);
     write8(0xEC);
@@ -1633,7 +1639,7 @@ void X64Asm::callHost(void* pfn) {
 
     write8(0xfc); // cld
 
-    writeToRegFromValue(tmp, true, (U64)pfn, 8);
+    writeToRegFromHostAddress(tmp, true, pfn);
 
 #ifdef BOXEDWINE_MSVC
     // part of the x64 windows ABI, shadow store
@@ -1858,6 +1864,7 @@ void X64Asm::setPF_onAL(U8 flagReg) {
     // mov HOST_TMP2, parity_lookup
     write8(REX_BASE | REX_64 | REX_MOD_RM);
     write8(0xb8+tmpReg);
+    this->hostAddressPos.push_back(this->bufferPos);
     write64((U64)parity_lookup);
     
     // or HOST_TMPb, byte ptr [HOST_TMP2]
@@ -3525,7 +3532,7 @@ static void x64_errorMsg(const char* msg) {
 void X64Asm::errorMsg(const char* msg) {
     //syncRegsFromHost(); 
     lockParamReg(PARAM_1_REG, PARAM_1_REX);
-    writeToRegFromValue(PARAM_1_REG, PARAM_1_REX, (U64)msg, 8);
+    writeToRegFromHostAddress(PARAM_1_REG, PARAM_1_REX, msg);
     callHost((void*)x64_errorMsg);
     //syncRegsToHost();
     //doJmp();
@@ -3712,7 +3719,7 @@ void X64Asm::stos(void* pfn, U32 size, bool repeat) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostAddress(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, size, 4);
@@ -3730,7 +3737,7 @@ void X64Asm::scas(void* pfn, U32 size, bool repeat, bool repeatZero) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostAddress(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, (U32)repeatZero?1:0, 4);
@@ -3751,7 +3758,7 @@ void X64Asm::movs(void* pfn, U32 size, bool repeat, U32 base) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostAddress(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, base, 4);
@@ -3772,7 +3779,7 @@ void X64Asm::lods(void* pfn, U32 size, bool repeat, U32 base) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostAddress(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, base, 4);
@@ -3793,7 +3800,7 @@ void X64Asm::cmps(void* pfn, U32 size, bool repeat, bool repeatZero, U32 base) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostAddress(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, (U32)repeatZero?1:0, 4);
@@ -3931,7 +3938,7 @@ void X64Asm::callFpuWithAddressWrite(PFN_FPU_ADDRESS pfn, U8 rm, U32 len) {
     writeToRegFromReg(PARAM_1_REG, PARAM_1_REX, HOST_CPU, true, 8); // CPU* param
 
     lockParamReg(PARAM_2_REG, PARAM_2_REX);
-    writeToRegFromValue(PARAM_2_REG, PARAM_2_REX, (U64)pfn, 8);
+    writeToRegFromHostAddress(PARAM_2_REG, PARAM_2_REX, (void*)pfn);
 
     lockParamReg(PARAM_3_REG, PARAM_3_REX);
     writeToRegFromValue(PARAM_3_REG, PARAM_3_REX, len, 4);
@@ -3964,6 +3971,7 @@ void X64Asm::saveNativeState() {
 	}
 
 	writeToRegFromValue(HOST_CPU, true, (U64)this->cpu, 8);
+	this->cacheable = false;
 
 	// fxsave cpu->fpuState
 	write8(0x41);
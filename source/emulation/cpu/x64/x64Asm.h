@@ -122,6 +122,7 @@ public:
     void bswapSp();
     void string32(bool hasSi, bool hasDi);
     void writeToRegFromValue(U8 reg, bool isRexReg, U64 value, U8 bytes);
+    void writeToRegFromHostAddress(U8 reg, bool isRexReg, const void* address);
     void enter(bool big, U32 bytes, U32 level);
     void leave(bool big);
     void callE(bool big, U8 rm);
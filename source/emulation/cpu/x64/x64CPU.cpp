@@ -6,6 +6,7 @@
 #include "x64Asm.h"
 #include "../../hardmmu/hard_memory.h"
 #include "x64CodeChunk.h"
+#include "x64CodeCache.h"
 #include "../normal/normalCPU.h"
 #include "ksignal.h"
 #include "knativethread.h"
@@ -177,44 +178,83 @@ std::shared_ptr<BtCodeChunk> x64CPU::translateChunk(U32 ip) {
 }
 
 std::shared_ptr<BtCodeChunk> x64CPU::translateChunk(X64Asm* parent, U32 ip) {
+    X64Asm* data = this->generateChunk(parent, ip);
+    std::shared_ptr<BtCodeChunk> chunk = this->publishChunk(data);
+    delete data;
+    return chunk;
+}
+
+// decodes and generates the host code, nothing is added to memory so this doesn't need executableMemoryMutex
+X64Asm* x64CPU::generateChunk(X64Asm* parent, U32 ip) {
+    if (!X64CodeCache::path.length()) {
+        return this->generateChunkUncached(parent, ip);
+    }
+    X64Asm* data = X64CodeCache::get(this, ip);
+    if (data) {
+        return data;
+    }
+    U32 state = X64CodeCache::getTranslationState(this);
+    data = this->generateChunkUncached(parent, ip);
+    if (X64CodeCache::getTranslationState(this) != state) {
+        // translating this chunk changed how later code is translated, like setting a segment
+        data->cacheable = false;
+    }
+    return data;
+}
+
+X64Asm* x64CPU::generateChunkUncached(X64Asm* parent, U32 ip) {
     X64Asm data1(this);
     data1.ip = ip;
     data1.startOfDataIp = ip;       
     data1.parent = parent;
     translateData(&data1);
 
-    X64Asm data(this);
-    data.ip = ip;
-    data.startOfDataIp = ip;  
-    data.calculatedEipLen = data1.ip - data1.startOfDataIp;
-    data.parent = parent;
-    translateData(&data, &data1);        
-    S32 failedJumpOpIndex = this->preLinkCheck(&data);
+    X64Asm* data = new X64Asm(this);
+    data->ip = ip;
+    data->startOfDataIp = ip;  
+    data->calculatedEipLen = data1.ip - data1.startOfDataIp;
+    data->parent = parent;
+    translateData(data, &data1);        
+    S32 failedJumpOpIndex = this->preLinkCheck(data);
 
     if (failedJumpOpIndex==-1) {
-        std::shared_ptr<BtCodeChunk> chunk = data.commit(false);
-        link(&data, chunk);
-        return chunk;
-    } else {
-        X64Asm data2(this);
-        data2.ip = ip;
-        data2.startOfDataIp = ip;       
-        data2.parent = parent;
-        data2.stopAfterInstruction = failedJumpOpIndex;
-        translateData(&data2);
-
-        X64Asm data3(this);
-        data3.ip = ip;
-        data3.startOfDataIp = ip;  
-        data3.calculatedEipLen = data2.ip - data2.startOfDataIp;
-        data3.parent = parent;
-        data3.stopAfterInstruction = failedJumpOpIndex;
-        translateData(&data3, &data2);
-
-        std::shared_ptr<BtCodeChunk> chunk = data3.commit(false);
-        link(&data3, chunk);
-        return chunk;
-    }    
+        return data;
+    }
+    delete data;
+
+    X64Asm data2(this);
+    data2.ip = ip;
+    data2.startOfDataIp = ip;       
+    data2.parent = parent;
+    data2.stopAfterInstruction = failedJumpOpIndex;
+    translateData(&data2);
+
+    X64Asm* data3 = new X64Asm(this);
+    data3->ip = ip;
+    data3->startOfDataIp = ip;  
+    data3->calculatedEipLen = data2.ip - data2.startOfDataIp;
+    data3->parent = parent;
+    data3->stopAfterInstruction = failedJumpOpIndex;
+    translateData(data3, &data2);
+    return data3;
+}
+
+// must hold executableMemoryMutex
+std::shared_ptr<BtCodeChunk> x64CPU::publishChunk(X64Asm* data) {
+    std::shared_ptr<BtCodeChunk> chunk = data->commit(false);
+    link(data, chunk);
+    X64CodeCache::add(this, data);
+    return chunk;
+}
+
+// another thread might have published code for part of this chunk while it was being generated
+bool x64CPU::isChunkAlreadyTranslated(X64Asm* data) {
+    for (U32 i=0;i<data->ipAddressCount;i++) {
+        if (this->thread->memory->getExistingHostAddress(data->ipAddress[i])) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void* x64CPU::translateEipInternal(X64Asm* parent, U32 ip) {
@@ -355,9 +395,37 @@ void x64CPU::makePendingCodePagesReadOnly() {
 }
 
 void* x64CPU::translateEip(U32 ip) {
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->thread->memory->executableMemoryMutex);
+    Memory* memory = this->thread->memory;
+    X64Asm* data = NULL;
 
-    void* result = translateEipInternal(NULL, ip);
+    if (!this->isBig()) {
+        ip = ip & 0xFFFF;
+    }
+    U32 address = this->seg[CS].address+ip;
+    U32 codeGeneration = memory->codeGeneration;
+
+    // Generating the code is the slow part, so it happens before taking executableMemoryMutex.  That way other threads
+    // that hit untranslated code or a code patch aren't stalled while this one translates, only publishing needs the lock.
+    if (!memory->getExistingHostAddress(address)) {
+        data = this->generateChunk(NULL, ip);
+    }
+
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(memory->executableMemoryMutex);
+    void* result = memory->getExistingHostAddress(address);
+
+    if (!result) {
+        if (data && codeGeneration == memory->codeGeneration && !this->isChunkAlreadyTranslated(data)) {
+            std::shared_ptr<BtCodeChunk> chunk = this->publishChunk(data);
+            result = chunk->getHostAddress();
+            chunk->makeLive();
+        } else {
+            // the code that was generated might be stale, translate it again now that nothing can change
+            result = translateEipInternal(NULL, ip);
+        }
+    }
+    if (data) {
+        delete data;
+    }
     makePendingCodePagesReadOnly();
     return result;
 }
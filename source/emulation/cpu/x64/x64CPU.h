@@ -81,6 +81,10 @@ public:
 #endif
 private:      
     std::shared_ptr<BtCodeChunk> translateChunk(X64Asm* parent, U32 ip);
+    X64Asm* generateChunk(X64Asm* parent, U32 ip);
+    X64Asm* generateChunkUncached(X64Asm* parent, U32 ip);
+    std::shared_ptr<BtCodeChunk> publishChunk(X64Asm* data);
+    bool isChunkAlreadyTranslated(X64Asm* data);
     void* translateEipInternal(X64Asm* parent, U32 ip);            
     void markCodePageReadOnly(X64Asm* data);
 
@@ -0,0 +1,333 @@
+#include "boxedwine.h"
+
+#ifdef BOXEDWINE_X64
+#include "x64CPU.h"
+#include "x64Asm.h"
+#include "x64CodeCache.h"
+#include "../../hardmmu/hard_memory.h"
+
+#define X64_CODE_CACHE_MAGIC 0x43435842 // BXCC
+#define X64_CODE_CACHE_VERSION 2
+
+// host pointers in the cached code are relative to where this function was loaded in the run that saved them,
+// that is only the same offset for every pointer if it is the exact same executable
+static void x64CodeCacheImageBase() {
+}
+
+static U64 executableHash;
+static bool executableHashDone;
+
+// FNV-1a of the whole executable, 0 if it couldn't be read, any rebuild that moves a function changes it
+static U64 getExecutableHash() {
+    if (executableHashDone) {
+        return executableHash;
+    }
+    executableHashDone = true;
+    std::string exe = platformGetExecutablePath();
+    FILE* f = exe.length() ? fopen(exe.c_str(), "rb") : NULL;
+    if (!f) {
+        klog("could not read the executable, the code cache will not be used");
+        return 0;
+    }
+    U64 hash = 0xcbf29ce484222325ull;
+    std::vector<U8> buffer(64 * 1024);
+    size_t len;
+    while ((len = fread(buffer.data(), 1, buffer.size(), f)) > 0) {
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ buffer[i]) * 0x100000001b3ull;
+        }
+    }
+    fclose(f);
+    executableHash = hash;
+    return executableHash;
+}
+
+class X64CodeCacheEntry {
+public:
+    X64CodeCacheEntry() : csAddress(0), ip(0), eipLen(0), state(0) {}
+
+    U32 csAddress;
+    U32 ip;
+    U32 eipLen;
+    U32 state;
+    std::vector<U8> guestBytes;
+    std::vector<U8> code;
+    std::vector<U32> ipAddress;
+    std::vector<U32> ipAddressBufferPos;
+    std::vector<U8> needsMemoryOffset;
+    std::vector<TodoJump> todoJump;
+    std::vector<U32> hostAddressPos;
+};
+
+std::string X64CodeCache::path;
+std::atomic<U32> X64CodeCache::hits;
+std::atomic<U32> X64CodeCache::misses;
+
+static BOXEDWINE_MUTEX codeCacheMutex;
+static std::unordered_map<U32, std::shared_ptr<X64CodeCacheEntry>> codeCacheEntries;
+
+// everything other than the guest bytes that X64Asm looks at while translating
+U32 X64CodeCache::getTranslationState(x64CPU* cpu) {
+    U32 result = 0;
+
+    for (U32 i = 0; i < 6; i++) {
+        if (cpu->thread->process->hasSetSeg[i]) {
+            result |= 1 << i;
+        }
+    }
+    if (cpu->thread->process->emulateFPU) {
+        result |= 0x40;
+    }
+    if (KSystem::useLargeAddressSpace) {
+        result |= 0x80;
+    }
+    if (x64CPU::hasBMI2) {
+        result |= 0x100;
+    }
+    return result;
+}
+
+void X64CodeCache::add(x64CPU* cpu, X64Asm* data) {
+    if (!path.length() || !data->cacheable || data->dynamic || !cpu->isBig()) {
+        return;
+    }
+    Memory* memory = cpu->thread->memory;
+    std::shared_ptr<X64CodeCacheEntry> entry = std::make_shared<X64CodeCacheEntry>();
+    U32 guestLen = data->ip - data->startOfDataIp;
+
+    // the first pass might have looked further than the final code
+    if (data->calculatedEipLen > guestLen) {
+        guestLen = data->calculatedEipLen;
+    }
+    entry->csAddress = cpu->seg[CS].address;
+    entry->ip = data->startOfDataIp;
+    entry->eipLen = data->ip - data->startOfDataIp;
+    entry->state = getTranslationState(cpu);
+    entry->guestBytes.resize(guestLen);
+    memcopyToNative(entry->csAddress + entry->ip, entry->guestBytes.data(), guestLen);
+    entry->code.assign(data->buffer, data->buffer + data->bufferPos);
+    entry->ipAddress.assign(data->ipAddress, data->ipAddress + data->ipAddressCount);
+    entry->ipAddressBufferPos.assign(data->ipAddressBufferPos, data->ipAddressBufferPos + data->ipAddressCount);
+    for (U32 i = 0; i < data->ipAddressCount; i++) {
+        entry->needsMemoryOffset.push_back(memory->doesInstructionNeedMemoryOffset(data->ipAddress[i] - entry->csAddress) ? 1 : 0);
+    }
+    entry->todoJump = data->todoJump;
+    entry->hostAddressPos = data->hostAddressPos;
+
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(codeCacheMutex);
+    codeCacheEntries[entry->csAddress + entry->ip] = entry;
+}
+
+// the same checks X64Asm would have made, if any of them are different now then the translator would produce different code
+static bool isEntryValid(x64CPU* cpu, const std::shared_ptr<X64CodeCacheEntry>& entry) {
+    Memory* memory = cpu->thread->memory;
+    U32 address = entry->csAddress + entry->ip;
+
+    if (entry->csAddress != cpu->seg[CS].address || entry->state != X64CodeCache::getTranslationState(cpu)) {
+        return false;
+    }
+    for (U32 page = address >> K_PAGE_SHIFT; page <= (address + (U32)entry->guestBytes.size() - 1) >> K_PAGE_SHIFT; page++) {
+        if (memory->dynamicCodePageUpdateCount[memory->getNativePage(page)] == MAX_DYNAMIC_CODE_PAGE_COUNT) {
+            return false;
+        }
+    }
+    for (U32 i = 0; i < entry->ipAddress.size(); i++) {
+        // the translator stops when it reaches code that was already translated
+        if (memory->getExistingHostAddress(entry->ipAddress[i])) {
+            return false;
+        }
+        // if an instruction faulted since then it will keep faulting without the memory offset
+        if (!entry->needsMemoryOffset[i] && memory->doesInstructionNeedMemoryOffset(entry->ipAddress[i] - entry->csAddress)) {
+            return false;
+        }
+    }
+    std::vector<U8> guestBytes(entry->guestBytes.size());
+    memcopyToNative(address, guestBytes.data(), (U32)guestBytes.size());
+    return guestBytes == entry->guestBytes;
+}
+
+X64Asm* X64CodeCache::get(x64CPU* cpu, U32 ip) {
+    if (!path.length() || !cpu->isBig()) {
+        return NULL;
+    }
+    std::shared_ptr<X64CodeCacheEntry> entry;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(codeCacheMutex);
+        std::unordered_map<U32, std::shared_ptr<X64CodeCacheEntry>>::iterator it = codeCacheEntries.find(cpu->seg[CS].address + ip);
+        if (it != codeCacheEntries.end()) {
+            entry = it->second;
+        }
+    }
+    if (!entry || !isEntryValid(cpu, entry)) {
+        misses++;
+        return NULL;
+    }
+    hits++;
+
+    X64Asm* data = new X64Asm(cpu);
+    data->startOfDataIp = entry->ip;
+    data->ip = entry->ip + entry->eipLen;
+    data->calculatedEipLen = entry->eipLen;
+    data->cacheable = false; // already cached
+    for (U32 i = 0; i < entry->code.size(); i++) {
+        data->write8(entry->code[i]);
+    }
+    for (U32 i = 0; i < entry->ipAddress.size(); i++) {
+        data->mapAddress(entry->ipAddress[i], entry->ipAddressBufferPos[i]);
+    }
+    data->todoJump = entry->todoJump;
+    data->hostAddressPos = entry->hostAddressPos;
+    return data;
+}
+
+void X64CodeCache::clear() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(codeCacheMutex);
+    codeCacheEntries.clear();
+    hits = 0;
+    misses = 0;
+}
+
+static void writeU32(FILE* f, U32 value) {
+    fwrite(&value, sizeof(value), 1, f);
+}
+
+static bool readU32(FILE* f, U32* value) {
+    return fread(value, sizeof(U32), 1, f) == 1;
+}
+
+template <typename T> static void writeVector(FILE* f, const std::vector<T>& v) {
+    writeU32(f, (U32)v.size());
+    if (v.size()) {
+        fwrite(v.data(), sizeof(T), v.size(), f);
+    }
+}
+
+template <typename T> static bool readVector(FILE* f, std::vector<T>& v) {
+    U32 count;
+
+    if (!readU32(f, &count)) {
+        return false;
+    }
+    v.resize(count);
+    return count == 0 || fread(v.data(), sizeof(T), count, f) == count;
+}
+
+bool X64CodeCache::save() {
+    if (!path.length()) {
+        return false;
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(codeCacheMutex);
+    U64 hash = getExecutableHash();
+    if (!hash) {
+        return false;
+    }
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        klog("could not write the code cache: %s", path.c_str());
+        return false;
+    }
+    U64 imageBase = (U64)x64CodeCacheImageBase;
+
+    writeU32(f, X64_CODE_CACHE_MAGIC);
+    writeU32(f, X64_CODE_CACHE_VERSION);
+    fwrite(&hash, sizeof(hash), 1, f);
+    fwrite(&imageBase, sizeof(imageBase), 1, f);
+    writeU32(f, (U32)codeCacheEntries.size());
+    for (auto& it : codeCacheEntries) {
+        const std::shared_ptr<X64CodeCacheEntry>& entry = it.second;
+
+        writeU32(f, entry->csAddress);
+        writeU32(f, entry->ip);
+        writeU32(f, entry->eipLen);
+        writeU32(f, entry->state);
+        writeVector(f, entry->guestBytes);
+        writeVector(f, entry->code);
+        writeVector(f, entry->ipAddress);
+        writeVector(f, entry->ipAddressBufferPos);
+        writeVector(f, entry->needsMemoryOffset);
+        writeVector(f, entry->hostAddressPos);
+        writeU32(f, (U32)entry->todoJump.size());
+        for (const TodoJump& jump : entry->todoJump) {
+            writeU32(f, jump.eip);
+            writeU32(f, jump.bufferPos);
+            writeU32(f, jump.offsetSize);
+            writeU32(f, jump.sameChunk ? 1 : 0);
+            writeU32(f, jump.opIndex);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static std::shared_ptr<X64CodeCacheEntry> readEntry(FILE* f, U64 imageDelta) {
+    std::shared_ptr<X64CodeCacheEntry> entry = std::make_shared<X64CodeCacheEntry>();
+    U32 todoCount;
+
+    if (!readU32(f, &entry->csAddress) || !readU32(f, &entry->ip) || !readU32(f, &entry->eipLen) || !readU32(f, &entry->state)) {
+        return NULL;
+    }
+    if (!readVector(f, entry->guestBytes) || !readVector(f, entry->code) || !readVector(f, entry->ipAddress) || !readVector(f, entry->ipAddressBufferPos) || !readVector(f, entry->needsMemoryOffset) || !readVector(f, entry->hostAddressPos) || !readU32(f, &todoCount)) {
+        return NULL;
+    }
+    if (entry->guestBytes.empty() || entry->ipAddress.size() != entry->ipAddressBufferPos.size() || entry->ipAddress.size() != entry->needsMemoryOffset.size()) {
+        return NULL;
+    }
+    for (U32 i = 0; i < todoCount; i++) {
+        U32 eip, bufferPos, offsetSize, sameChunk, opIndex;
+
+        if (!readU32(f, &eip) || !readU32(f, &bufferPos) || !readU32(f, &offsetSize) || !readU32(f, &sameChunk) || !readU32(f, &opIndex)) {
+            return NULL;
+        }
+        entry->todoJump.push_back(TodoJump(eip, bufferPos, (U8)offsetSize, sameChunk != 0, opIndex));
+    }
+    for (U32 pos : entry->hostAddressPos) {
+        if (pos + 8 > entry->code.size()) {
+            return NULL;
+        }
+        U64 value;
+        memcpy(&value, &entry->code[pos], 8);
+        value += imageDelta;
+        memcpy(&entry->code[pos], &value, 8);
+    }
+    return entry;
+}
+
+bool X64CodeCache::load() {
+    if (!path.length()) {
+        return false;
+    }
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(codeCacheMutex);
+    U64 hash = getExecutableHash();
+    if (!hash) {
+        return false;
+    }
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    U32 magic = 0, version = 0, count = 0;
+    U64 savedHash = 0, imageBase = 0;
+    bool result = false;
+
+    if (readU32(f, &magic) && magic == X64_CODE_CACHE_MAGIC && readU32(f, &version) && version == X64_CODE_CACHE_VERSION) {
+        if (fread(&savedHash, sizeof(savedHash), 1, f) == 1 && savedHash == hash && fread(&imageBase, sizeof(imageBase), 1, f) == 1 && readU32(f, &count)) {
+            U64 imageDelta = (U64)x64CodeCacheImageBase - imageBase;
+
+            result = true;
+            for (U32 i = 0; i < count; i++) {
+                std::shared_ptr<X64CodeCacheEntry> entry = readEntry(f, imageDelta);
+                if (!entry) {
+                    klog("code cache is corrupt, it will be rebuilt: %s", path.c_str());
+                    codeCacheEntries.clear();
+                    result = false;
+                    break;
+                }
+                codeCacheEntries[entry->csAddress + entry->ip] = entry;
+            }
+        }
+    }
+    fclose(f);
+    return result;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef __X64_CODE_CACHE_H__
+#define __X64_CODE_CACHE_H__
+
+#ifdef BOXEDWINE_X64
+
+class X64Asm;
+class x64CPU;
+
+// Translated chunks are remembered by the guest address they start at and can be written to a file at
+// shutdown, the next run loads that file so that code that didn't change, like the dlls in the root zip,
+// doesn't need to go through the translator again.
+//
+// A cached chunk is only used if the guest bytes it was translated from are still the same and the host
+// pointers it calls are relocated to where this run loaded boxedwine.
+class X64CodeCache {
+public:
+    static std::string path; // empty if the cache is not enabled
+
+    static bool load();
+    static bool save();
+    static void clear();
+
+    static void add(x64CPU* cpu, X64Asm* data);
+    static X64Asm* get(x64CPU* cpu, U32 ip); // caller deletes the result
+    static U32 getTranslationState(x64CPU* cpu);
+
+    // get() is called by every thread that translates code
+    static std::atomic<U32> hits;
+    static std::atomic<U32> misses;
+};
+
+#endif
+
+#endif
@@ -24,6 +24,7 @@ X64Data::X64Data(x64CPU* cpu) : cpu(cpu) {
     this->stopAfterInstruction = -1;
     this->dynamic = false;
     this->useSingleMemOffset = true;
+    this->cacheable = true;
 }
 
 X64Data::~X64Data() {
@@ -127,6 +127,11 @@ public:
     bool useSingleMemOffset;
     bool skipWriteOp;
     bool isG8bitWritten;
+
+    // buffer positions of 64-bit pointers into the boxedwine image, X64CodeCache relocates these
+    std::vector<U32> hostAddressPos;
+    // false if the code contains a pointer that can't be relocated in a later run, like the cpu
+    bool cacheable;
 };
 #endif
 #endif
@@ -25,7 +25,7 @@
 #include "../cpu/binaryTranslation/btCodeMemoryWrite.h"
 #include "../cpu/binaryTranslation/btCodeChunk.h"
 
-Memory::Memory() : allocated(0), callbackPos(0) {
+Memory::Memory() : blockGeneration(1), allocated(0), callbackPos(0) {
     memset(flags, 0, sizeof(flags));
     memset(nativeFlags, 0, sizeof(nativeFlags));
     memset(memOffsets, 0, sizeof(memOffsets));
@@ -39,6 +39,7 @@ Memory::Memory() : allocated(0), callbackPos(0) {
         this->eipToHostInstructionPages = NULL;
     }
     this->eipToHostInstructionAddressSpaceMapping = NULL;
+    this->codeGeneration = 0;
     memset(this->dynamicCodePageUpdateCount, 0, sizeof(this->dynamicCodePageUpdateCount));
     memset(this->committedEipPages, 0, sizeof(this->committedEipPages));
 #endif    
@@ -803,6 +804,7 @@ U8* getPhysicalWriteAddress(U32 address, U32 len) {
 #ifdef BOXEDWINE_BINARY_TRANSLATOR
 // called when BtCodeChunk is being dealloc'd
 void Memory::removeCodeChunk(const std::shared_ptr<BtCodeChunk>& chunk) {
+    this->codeGeneration++;
     U32 hostPage = (U32)(((size_t)chunk->getHostAddress()) >> K_PAGE_SHIFT);
     if (this->codeChunksByHostPage.count(hostPage)) {
         std::shared_ptr< std::list<std::shared_ptr<BtCodeChunk>> > chunks = this->codeChunksByHostPage[hostPage];
@@ -856,6 +858,7 @@ void Memory::addCodeChunk(const std::shared_ptr<BtCodeChunk>& chunk) {
 
 void Memory::makeNativePageDynamic(U32 nativePage) {
     U32 startPage = getEmulatedPage(nativePage);
+    this->codeGeneration++;
     for (U32 i = 0; i < K_NATIVE_PAGES_PER_PAGE; i++) {
         U32 page = startPage + i;
         if (this->codeChunksByEmulationPage.count(page)) {
@@ -939,6 +942,7 @@ std::shared_ptr<BtCodeChunk> Memory::getCodeChunkContainingEip(U32 eip) {
 void Memory::clearHostCodeForWriting(U32 nativePage, U32 count) {
     U32 addressStart = getEmulatedPage(nativePage) << K_PAGE_SHIFT;
     U32 addressStop = getEmulatedPage(nativePage + count) << K_PAGE_SHIFT;
+    this->codeGeneration++;
     for (U32 i= addressStart;i < addressStop;i++) {
         std::shared_ptr<BtCodeChunk> chunk = getCodeChunkContainingEip(i);
         if (chunk && !chunk->isDynamicAware()) {
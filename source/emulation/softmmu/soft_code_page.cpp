@@ -55,10 +55,34 @@ CodePage* CodePage::alloc(U8* page, U32 address, U32 flags) {
     return new CodePage(page, address, flags);
 }
 
-CodePage::CodePage(U8* page, U32 address, U32 flags) : RWPage(page, address, flags, Code_Page) {
+CodePage::CodePage(U8* page, U32 address, U32 flags) : RWPage(page, address, flags, Code_Page), codeLines(0) {
     memset(this->entries, 0, sizeof(this->entries));
 }
 
+static U64 getCodeLineMask(U32 offset, U32 len) {
+    U32 first = offset >> CODE_LINE_SHIFT;
+    U32 last = (offset + len - 1) >> CODE_LINE_SHIFT;
+
+    // when last is 63, 2 << 63 wraps to 0 and the subtraction gives all the bits
+    return (((U64)2 << last) - 1) & ~(((U64)1 << first) - 1);
+}
+
+// address and len must be in this page
+bool CodePage::hasCode(U32 address, U32 len) {
+    return (this->codeLines & getCodeLineMask(address - this->address, len)) != 0;
+}
+
+void CodePage::updateCodeLines() {
+    this->codeLines = 0;
+    for (U32 i = 0; i < CODE_ENTRIES; i++) {
+        CodePageEntry* entry = this->entries[i];
+        while (entry) {
+            this->codeLines |= getCodeLineMask(entry->offset, entry->len);
+            entry = entry->next;
+        }
+    }
+}
+
 CodePage::~CodePage() {
     int i;
 
@@ -123,6 +147,7 @@ void CodePage::removeBlockAt(U32 address, U32 len) {
         freeCodePageEntry(entry);
         entry = findCode(address, len);
     }
+    this->updateCodeLines();
 }
 
 void CodePage::addCode(U32 eip, DecodedBlock* block, U32 len, CodePageEntry* link) {
@@ -146,6 +171,7 @@ void CodePage::addCode(U32 eip, DecodedBlock* block, U32 len, CodePageEntry* lin
 		(*entry)->len = K_PAGE_SIZE-offset;
 	else
 		(*entry)->len = len;
+	this->codeLines |= getCodeLineMask((*entry)->offset, (*entry)->len);
 	if (link) {
 		(*entry)->linkedPrev = link;
 		link->linkedNext = (*entry);
@@ -175,21 +201,27 @@ DecodedBlock* CodePage::getCode(U32 eip) {
 }
 
 void CodePage::writeb(U32 address, U8 value) {    
-    if (value!=this->readb(address)) {
+    if (!this->hasCode(address, 1)) {
+        RWPage::writeb(address, value);
+    } else if (value!=this->readb(address)) {
         removeBlockAt(address, 1);
         RWPage::writeb(address, value);
     }
 }
 
 void CodePage::writew(U32 address, U16 value) {
-    if (value!=this->readw(address)) {
+    if (!this->hasCode(address, 2)) {
+        RWPage::writew(address, value);
+    } else if (value!=this->readw(address)) {
         removeBlockAt(address, 2);
         RWPage::writew(address, value);
     }
 }
 
 void CodePage::writed(U32 address, U32 value) {
-    if (value!=this->readd(address)) {
+    if (!this->hasCode(address, 4)) {
+        RWPage::writed(address, value);
+    } else if (value!=this->readd(address)) {
         removeBlockAt(address, 4);
         RWPage::writed(address, value);
     }
@@ -208,11 +240,14 @@ U8* CodePage::getReadAddress(U32 address, U32 len) {
 }
 
 U8* CodePage::getWriteAddress(U32 address, U32 len) {
-    return NULL;
+    if (!len || this->hasCode(address, len)) {
+        return NULL;
+    }
+    return &this->page[address - this->address];
 }
 
 U8* CodePage::getReadWriteAddress(U32 address, U32 len) {
-    return NULL;
+    return this->getWriteAddress(address, len);
 }
 
 #endif
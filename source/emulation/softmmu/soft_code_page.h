@@ -26,6 +26,9 @@
 #define CODE_ENTRIES 128
 #define CODE_ENTRIES_SHIFT 5
 
+// writes to a 64 byte line that doesn't have any code in it don't need to look for blocks to remove
+#define CODE_LINE_SHIFT 6
+
 class CodePage : public RWPage {
 protected:
     CodePage(U8* page, U32 address, U32 flags);
@@ -60,7 +63,10 @@ private:
     void removeBlockAt(U32 address, U32 len);
     CodePageEntry* findCode(U32 address, U32 len);
     void addCode(U32 eip, DecodedBlock* block, U32 len, CodePageEntry* link);
+    bool hasCode(U32 address, U32 len);
+    void updateCodeLines();
     CodePageEntry* entries[CODE_ENTRIES];
+    U64 codeLines; // 1 bit per line, can have extra bits set if code was removed by another page
 
     static CodePageEntry* freeCodePageEntries;
     static CodePageEntry* allocCodePageEntry();
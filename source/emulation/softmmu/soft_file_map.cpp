@@ -33,24 +33,100 @@ FilePage* FilePage::alloc(const BoxedPtr<MappedFile>& mapped, U32 index, U32 fla
     return new FilePage(mapped, index, flags);
 }
 
+// reads a window of file pages around a fault into the system cache with a single read
+//
+// a fault right after the previous window is treated as sequential access and the window
+// doubles up to KSystem::faultAroundPages, any other fault starts over with a small aligned window
+U8* FilePage::faultAround(KProcess* process) {
+    BoxedPtr<MappedFileCache>& cache = this->mapped->systemCacheEntry;
+    U32 firstIndex = (U32)(this->mapped->offset >> K_PAGE_SHIFT);
+    U32 lastIndex = firstIndex + (U32)(this->mapped->len >> K_PAGE_SHIFT);
+    U32 window;
+    U32 start;
+
+    if (lastIndex > cache->dataSize) {
+        lastIndex = cache->dataSize;
+    }
+    if (this->index >= lastIndex) {
+        return NULL;
+    }
+    if (this->mapped->faultAroundPages && this->index == this->mapped->nextFaultIndex) {
+        window = this->mapped->faultAroundPages * 2;
+        if (window > KSystem::faultAroundPages) {
+            window = KSystem::faultAroundPages;
+        }
+        start = this->index;
+    } else {
+        window = FAULT_AROUND_MIN_PAGES;
+        if (window > KSystem::faultAroundPages) {
+            window = KSystem::faultAroundPages;
+        }
+        start = this->index - (this->index % window);
+        if (start < firstIndex) {
+            start = firstIndex;
+        }
+    }
+    U32 end = start + window;
+    if (end > lastIndex) {
+        end = lastIndex;
+    }
+    // pages at the edges that another mapping already brought in don't need to be read again
+    while (start < this->index && cache->data[start]) {
+        start++;
+    }
+    while (end > this->index + 1 && cache->data[end - 1]) {
+        end--;
+    }
+    this->mapped->faultAroundPages = window;
+    this->mapped->nextFaultIndex = end;
+
+    U32 len = (end - start) << K_PAGE_SHIFT;
+    U8* buffer = new U8[len];
+    U64 pos = this->mapped->file->getPos();
+    this->mapped->file->seek(((U64)start) << K_PAGE_SHIFT);
+    U32 read = this->mapped->file->readNative(buffer, len);
+    this->mapped->file->seek(pos);
+    if (read < len) {
+        memset(buffer + read, 0, len - read);
+    }
+    process->mmapBytesRead += read;
+
+    for (U32 i = start; i < end; i++) {
+        if (!cache->data[i]) {
+            U8* ram = ramPageAlloc();
+            memcpy(ram, buffer + ((i - start) << K_PAGE_SHIFT), K_PAGE_SIZE);
+            cache->data[i] = ram;
+            process->mmapPagesPopulated++;
+        }
+    }
+    delete[] buffer;
+    return cache->data[this->index];
+}
+
 // :TODO: what about sync'ing the writes back to the file?
 void FilePage::ondemmandFile(U32 address) {
-    Memory* memory = KThread::currentThread()->process->memory;
+    KProcess* process = KThread::currentThread()->process.get();
+    Memory* memory = process->memory;
     U32 page = address >> K_PAGE_SHIFT;
     bool read = this->canRead() || this->canExec();
     bool write = this->canWrite();
     bool shared = this->mapShared();
     U8* ram=NULL;
 
+    process->mmapFaults++;
     address = address & (~K_PAGE_MASK);
     if ((read && !write) || shared) {
         ram = mapped->systemCacheEntry->data[this->index];   
+        if (!ram && KSystem::faultAroundPages > 1) {
+            ram = faultAround(process);
+        }
     } 
     if (!ram) {
         ram = ramPageAlloc();
         U64 pos = this->mapped->file->getPos();
         this->mapped->file->seek(((U64)this->index) << K_PAGE_SHIFT);
-        this->mapped->file->readNative(ram, K_PAGE_SIZE);
+        process->mmapBytesRead += this->mapped->file->readNative(ram, K_PAGE_SIZE);
+        process->mmapPagesPopulated++;
         this->mapped->file->seek(pos);
         if (!write || shared) {
             mapped->systemCacheEntry->data[this->index] = ram;
@@ -23,6 +23,9 @@
 
 #include "soft_page.h"
 
+// the window a random fault starts with, sequential faults grow it up to KSystem::faultAroundPages
+#define FAULT_AROUND_MIN_PAGES 16
+
 class FilePage : public Page {
 protected:
     FilePage(const BoxedPtr<MappedFile>& mapped, U32 index, U32 flags) : Page(File_Page, flags), mapped(mapped), index(index) {}
@@ -45,6 +48,7 @@ public:
     void close() {delete this;}
 
     void ondemmandFile(U32 address);
+    U8* faultAround(KProcess* process);
 
      BoxedPtr<MappedFile> mapped;
      U32 index;
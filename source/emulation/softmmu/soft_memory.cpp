@@ -104,7 +104,7 @@ void Memory::addCallback(OpCallback func) {
     }
 }
 
-Memory::Memory() : nativeAddressStart(0) {
+Memory::Memory() : blockGeneration(1), nativeAddressStart(0) {
     for (int i=0;i<K_NUMBER_OF_PAGES;i++) {
         this->mmu[i] = invalidPage;
         this->mmuReadPtr[i] = NULL;
@@ -414,6 +414,11 @@ void memcopyFromNative(U32 address, const void* pv, U32 len) {
     U32 i;
     U8* p = (U8*)pv;
 
+    // most copies are small and stay on one page, like a marshalled structure, so try the same lookup writed uses first
+    if ((address & K_PAGE_MASK) + len <= K_PAGE_SIZE && Memory::currentMMUWritePtr[address >> K_PAGE_SHIFT]) {
+        memcpy(&Memory::currentMMUWritePtr[address >> K_PAGE_SHIFT][address & K_PAGE_MASK], p, len);
+        return;
+    }
     if (len>4) {
         U32 todo = K_PAGE_SIZE-(address & (K_PAGE_SIZE-1));
         if (todo>len)
@@ -454,6 +459,10 @@ void memcopyToNative(U32 address, void* pv, U32 len) {
     }
 #else
     U8* p = (U8*)pv;
+    if ((address & K_PAGE_MASK) + len <= K_PAGE_SIZE && Memory::currentMMUReadPtr[address >> K_PAGE_SHIFT]) {
+        memcpy(p, &Memory::currentMMUReadPtr[address >> K_PAGE_SHIFT][address & K_PAGE_MASK], len);
+        return;
+    }
     if (len>4) {
         U32 todo = K_PAGE_SIZE-(address & (K_PAGE_SIZE-1));
         if (todo>len)
@@ -117,5 +117,32 @@ inline void writeq(U32 address, U64 value) {
 #endif
     writed(address, (U32)value); writed(address + 4, (U32)(value >> 32));
 }
+
+// for small copies, like a marshalled structure, when len is a constant the memcpy turns into a few moves
+inline void memcopyToNativeInline(U32 address, void* p, U32 len) {
+#ifndef UNALIGNED_MEMORY
+    if ((address & K_PAGE_MASK) + len <= K_PAGE_SIZE) {
+        U8* ram = Memory::currentMMUReadPtr[address >> K_PAGE_SHIFT];
+        if (ram) {
+            memcpy(p, &ram[address & K_PAGE_MASK], len);
+            return;
+        }
+    }
+#endif
+    memcopyToNative(address, p, len);
+}
+
+inline void memcopyFromNativeInline(U32 address, const void* p, U32 len) {
+#ifndef UNALIGNED_MEMORY
+    if ((address & K_PAGE_MASK) + len <= K_PAGE_SIZE) {
+        U8* ram = Memory::currentMMUWritePtr[address >> K_PAGE_SHIFT];
+        if (ram) {
+            memcpy(&ram[address & K_PAGE_MASK], p, len);
+            return;
+        }
+    }
+#endif
+    memcopyFromNative(address, p, len);
+}
 #endif
 #endif
@@ -21,7 +21,11 @@ BOXEDWINE_MUTEX Fs::nextNodeIdMutex;
 BoxedPtr<FsFileNode> Fs::rootNode;
 std::string Fs::nativePathSeperator;
 
+Fs::PathCacheShard Fs::pathCache[FS_PATH_CACHE_SHARDS];
+std::atomic<U32> Fs::pathCacheGeneration;
+
 void Fs::shutDown() {
+    invalidatePathCache();
 	rootNode = NULL;
 }
 bool Fs::initFileSystem(const std::string& rootPath) {
@@ -46,6 +50,7 @@ bool Fs::initFileSystem(const std::string& rootPath) {
     }
 
     BoxedPtr<FsNode> parent(NULL);
+    invalidatePathCache();
     rootNode = new FsFileNode(Fs::nextNodeId++, 0, "/", "", path, true, true, parent);
 
     BoxedPtr<FsNode> dir = Fs::getNodeFromLocalPath("", "/tmp/del", false, NULL);
@@ -101,10 +106,54 @@ BoxedPtr<FsNode> Fs::addDynamicLinkFile(const std::string& path, U32 rdev, const
     return result;
 }
 
+void Fs::invalidatePathCache() {
+    // bump the generation first so that a lookup that is in progress won't add what it found after the clear
+    Fs::pathCacheGeneration++;
+    for (U32 i = 0; i < FS_PATH_CACHE_SHARDS; i++) {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(Fs::pathCache[i].mutex);
+        Fs::pathCache[i].paths[0].clear();
+        Fs::pathCache[i].paths[1].clear();
+    }
+}
+
 BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, bool followLink, bool* isLink) {
+    std::string fullpath = Fs::getFullPath(currentDirectory, path);
+    PathCacheShard& shard = Fs::pathCache[std::hash<std::string>()(fullpath) % FS_PATH_CACHE_SHARDS];
+    std::unordered_map<std::string, PathCacheEntry>& paths = shard.paths[followLink ? 1 : 0];
+    U32 generation;
+
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(shard.mutex);
+        auto it = paths.find(fullpath);
+        if (it != paths.end()) {
+            if (isLink && it->second.isLink) {
+                *isLink = true;
+            }
+            return it->second.node;
+        }
+        generation = Fs::pathCacheGeneration;
+    }
+
     BoxedPtr<FsNode> lastNode;
     std::vector<std::string> missingParts;
-    return Fs::getNodeFromLocalPath(currentDirectory, path, lastNode, missingParts, followLink, isLink);
+    bool foundLink = false;
+    bool canCache = true;
+    BoxedPtr<FsNode> result = Fs::getNodeFromLocalPath("", fullpath, lastNode, missingParts, followLink, &foundLink, &canCache);
+    if (isLink && foundLink) {
+        *isLink = true;
+    }
+    if (canCache) {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(shard.mutex);
+        if (generation == Fs::pathCacheGeneration) {
+            if (paths.size() >= FS_PATH_CACHE_MAX_ENTRIES) {
+                paths.clear();
+            }
+            PathCacheEntry& entry = paths[fullpath];
+            entry.node = result;
+            entry.isLink = foundLink;
+        }
+    }
+    return result;
 }
 
 std::string Fs::getFullPath(const std::string& currentDirectory, const std::string& path) {
@@ -141,7 +190,7 @@ bool cleanPath(std::vector<std::string>& parts) {
     return true;
 }
 
-BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink) {
+BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink, bool* canCache) {
     std::string fullpath = Fs::getFullPath(currentDirectory, path);
 
     if (fullpath.length()==0 || fullpath=="/")
@@ -180,6 +229,10 @@ BoxedPtr<FsNode> Fs::getNodeFromLocalPath(const std::string& currentDirectory, c
             if (i==parts.size()-1 && isLink) {
                 *isLink = true;
             }
+            if (canCache && node->isDynamicLink()) {
+                // /proc/self points somewhere different for each process
+                *canCache = false;
+            }
 
             std::vector<std::string> linkParts;
             Fs::splitPath(node->getLink(), linkParts);
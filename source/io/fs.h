@@ -5,6 +5,8 @@
 #include "fsnode.h"
 #include "fsopennode.h"
 
+#include <atomic>
+
 #define K_O_RDONLY   0x0000
 #define K_O_WRONLY   0x0001
 #define K_O_RDWR     0x0002
@@ -43,6 +45,10 @@
 
 #define FS_BLOCK_SIZE 8192
 
+// lookups are cached by their full path, the shard is picked from the hash so that threads don't share one lock
+#define FS_PATH_CACHE_SHARDS 16
+#define FS_PATH_CACHE_MAX_ENTRIES 4096
+
 typedef FsOpenNode* (*OpenVirtualNode)(const BoxedPtr<FsNode>& node, U32 flags, U32 data);
 
 class FsFileNode;
@@ -80,6 +86,9 @@ public:
     static std::vector<std::string> getFilesInNativeDirectoryWhereFileMatches(const std::string& dirPath, const std::string& startsWith, const std::string& endsWith, bool ignoreCase);
     static void trimTrailingSlash(std::string& s);
 
+    // must be called when a node is added, removed or renamed, or when a link changes
+    static void invalidatePathCache();
+
     static std::string nativePathSeperator;
 
     static BoxedPtr<FsFileNode> rootNode;
@@ -87,10 +96,22 @@ public:
 private:
     friend class KUnixSocketObject;
 
-    static BoxedPtr<FsNode> getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink=NULL);
+    static BoxedPtr<FsNode> getNodeFromLocalPath(const std::string& currentDirectory, const std::string& path, BoxedPtr<FsNode>& lastNode, std::vector<std::string>& missingParts, bool followLink, bool* isLink=NULL, bool* canCache=NULL);
 
     static U32 nextNodeId;    
     static BOXEDWINE_MUTEX nextNodeIdMutex;
+
+    // a NULL node means the path doesn't exist
+    struct PathCacheEntry {
+        BoxedPtr<FsNode> node;
+        bool isLink;
+    };
+    struct PathCacheShard {
+        std::unordered_map<std::string, PathCacheEntry> paths[2]; // indexed by followLink
+        BOXEDWINE_MUTEX mutex;
+    };
+    static PathCacheShard pathCache[FS_PATH_CACHE_SHARDS];
+    static std::atomic<U32> pathCacheGeneration;
 };
 
 #endif
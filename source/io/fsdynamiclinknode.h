@@ -17,6 +17,7 @@ public:
     virtual U32 setTimes(U64 lastAccessTime, U32 lastAccessTimeNano, U64 lastModifiedTime, U32 lastModifiedTimeNano);
     virtual std::string getLink();
     virtual bool isLink();
+    virtual bool isDynamicLink() { return true; }
 
     std::function<std::string(void)> fnGetLink;
 };
@@ -18,7 +18,15 @@
 
 std::set<std::string> FsFileNode::nonExecFileFullPaths;
 
-FsFileNode::FsFileNode(U32 id, U32 rdev, const std::string& path, const std::string& link, const std::string& nativePath, bool isDirectory, bool isRootPath, BoxedPtr<FsNode> parent) : FsNode(File, id, rdev, path, link, nativePath, isDirectory, parent), isRootPath(isRootPath) {
+FsFileNode::FsFileNode(U32 id, U32 rdev, const std::string& path, const std::string& link, const std::string& nativePath, bool isDirectory, bool isRootPath, BoxedPtr<FsNode> parent) : FsNode(File, id, rdev, path, link, nativePath, isDirectory, parent), 
+#ifdef BOXEDWINE_ZLIB
+    zipOnly(false),
+#endif
+    isRootPath(isRootPath),
+    statValid(false),
+    statFound(false),
+    statLength(0),
+    statLastModified(0) {
 }
 
 std::string FsFileNode::getNativeTmpPath() {
@@ -102,17 +110,45 @@ bool FsFileNode::remove() {
         });
         result = true;
     }
+    this->invalidateStat();
     if (result) {
         this->removeNodeFromParent();
     }
     return result;
 }
 
-U64 FsFileNode::lastModified() {
-    PLATFORM_STAT_STRUCT buf;
+void FsFileNode::invalidateStat() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->statMutex);
+    this->statValid = false;
+}
 
+// statMutex must be held
+void FsFileNode::loadStat() {
+    if (this->statValid) {
+        return;
+    }
+    this->statValid = true;
+    this->statFound = false;
+#ifdef BOXEDWINE_ZLIB
+    if (this->zipNode && this->zipOnly) {
+        return;
+    }
+#endif
+    PLATFORM_STAT_STRUCT buf;
     if (PLATFORM_STAT(this->nativePath.c_str(), &buf)==0) {
-        return ((U64)buf.st_mtime)*1000l;
+        this->statFound = true;
+        this->statLength = buf.st_size;
+        this->statLastModified = ((U64)buf.st_mtime)*1000l;
+    }
+}
+
+U64 FsFileNode::lastModified() {
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->statMutex);
+        this->loadStat();
+        if (this->statFound) {
+            return this->statLastModified;
+        }
     }
 #ifdef BOXEDWINE_ZLIB
     if (this->zipNode)
@@ -125,9 +161,12 @@ U64 FsFileNode::length() {
     if (this->isDirectory())
         return 4096;
 
-    PLATFORM_STAT_STRUCT buf;
-    if (PLATFORM_STAT(this->nativePath.c_str(), &buf)==0) {
-        return buf.st_size;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->statMutex);
+        this->loadStat();
+        if (this->statFound) {
+            return this->statLength;
+        }
     }
 #ifdef BOXEDWINE_ZLIB
     if (this->zipNode)
@@ -147,6 +186,8 @@ void FsFileNode::ensurePathIsLocal() {
             Fs::makeLocalDirs(parentPath.c_str());
             this->zipNode->moveToFileSystem(this);
         }
+        this->zipOnly = false;
+        this->invalidateStat();
     } else if (this->parent->type==File) {
         std::string parentPath = Fs::getParentPath(this->path);
         Fs::makeLocalDirs(parentPath);
@@ -203,6 +244,9 @@ FsOpenNode* FsFileNode::open(U32 flags) {
 #endif
         return 0;
     }
+    if (flags & (K_O_CREAT | K_O_TRUNC)) {
+        this->invalidateStat();
+    }
     return new FsFileOpenNode(this, flags, f);
 }
 
@@ -328,6 +372,7 @@ U32 FsFileNode::rename(const std::string& path) {
         }    
         result = ::rename(this->nativePath.c_str(), nativePath.c_str());
         if (result==0) {
+            this->invalidateStat();
             this->removeNodeFromParent();
             this->path = path;
             this->nativePath = nativePath;
@@ -379,5 +424,6 @@ U32 FsFileNode::setTimes(U64 lastAccessTime, U32 lastAccessTimeNano, U64 lastMod
         settime.modtime = lastModifiedTime;
     }       
     utime(this->nativePath.c_str(),&settime);
+    this->invalidateStat();
     return 0; // no error checking, we don't care if this fails
 }
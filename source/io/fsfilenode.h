@@ -25,6 +25,7 @@ public:
     virtual U32 getMode();
     virtual U32 removeDir();
     virtual U32 setTimes(U64 lastAccessTime, U32 lastAccessTimeNano, U64 lastModifiedTime, U32 lastModifiedTimeNano);
+    virtual void invalidateStat();
     static std::set<std::string> nonExecFileFullPaths;
 private:
     friend class FsFileOpenNode;
@@ -32,13 +33,22 @@ private:
     friend class Platform;
 
     void ensurePathIsLocal();
+    void loadStat();
 #ifdef BOXEDWINE_ZLIB
     friend class FsZip;
     friend class FsZipNode;    
     std::shared_ptr<FsZipNode> zipNode;
+    bool zipOnly; // the file hasn't been copied out of the zip, so there is nothing on the host to stat
 #endif    
     friend class Fs;
     bool isRootPath;
+
+    // filled in from one host stat, changes made through this node invalidate it
+    BOXEDWINE_MUTEX statMutex;
+    bool statValid;
+    bool statFound;
+    U64 statLength;
+    U64 statLastModified;
 };
 
 #endif
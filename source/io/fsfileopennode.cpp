@@ -19,6 +19,7 @@ S64 FsFileOpenNode::length() {
 }
 
 bool FsFileOpenNode::setLength(S64 len) {
+    this->fileNode->invalidateStat();
     return ftruncate(this->handle, (S32)len)==0;
 }
 
@@ -96,5 +97,7 @@ U32 FsFileOpenNode::readNative(U8* buffer, U32 len) {
 }
 
 U32 FsFileOpenNode::writeNative(U8* buffer, U32 len) {
-    return (U32)::write(this->handle, buffer, len);
+    U32 result = (U32)::write(this->handle, buffer, len);
+    this->fileNode->invalidateStat();
+    return result;
 }
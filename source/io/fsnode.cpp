@@ -14,7 +14,8 @@ FsNode::FsNode(Type type, U32 id, U32 rdev, const std::string& path, const std::
     parent(parent),
     isDir(isDirectory),  
     locksCS("FsNode.lockCS"),
-    hasLoadedChildrenFromFileSystem(false)
+    hasLoadedChildrenFromFileSystem(false),
+    isLoadingChildren(false)
  {   
 }
 
@@ -33,13 +34,44 @@ bool FsNode::canWrite() {
 
 void FsNode::removeNodeFromParent() {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->parent->childrenByNameMutex);
-    this->parent->childrenByName.erase(this->name);
+    auto it = this->parent->childrenByName.find(this->name);
+    if (it != this->parent->childrenByName.end()) {
+        this->parent->removeChildFromIndex(it->second);
+        this->parent->childrenByName.erase(it);
+    }
+    Fs::invalidatePathCache();
+    this->parent->invalidateStat();
+}
+
+// childrenByNameMutex must be held and node must still be in childrenByName
+void FsNode::removeChildFromIndex(const BoxedPtr<FsNode>& node) {
+    std::string lowerName = node->name;
+    stringToLower(lowerName);
+    auto it = this->childrenByLowerCaseName.find(lowerName);
+    if (it == this->childrenByLowerCaseName.end()) {
+        return;
+    }
+    LowerCaseChild& child = it->second;
+    child.count--;
+    if (!child.count) {
+        this->childrenByLowerCaseName.erase(it);
+    } else if (child.node == node) {
+        // only differs by case from another child, which is rare so it's ok to look for the other one the slow way
+        for (auto& n : this->childrenByName) {
+            if (n.second != node && stringCaseInSensativeEquals(n.first, node->name)) {
+                child.node = n.second;
+                break;
+            }
+        }
+    }
 }
 
 void FsNode::loadChildren() {
     // don't need to protect from threads since this is private
     if (!this->hasLoadedChildrenFromFileSystem) {
         this->hasLoadedChildrenFromFileSystem = true;
+        // a lookup always loads the children first, so adding them here can't change what was cached
+        this->isLoadingChildren = true;
         if (this->nativePath.length()) {
             std::vector<Platform::ListNodeResult> results;
             Platform::listNodes(nativePath, results);
@@ -67,6 +99,7 @@ void FsNode::loadChildren() {
                 }           
             }
         }
+        this->isLoadingChildren = false;
     }
 }
 
@@ -81,10 +114,11 @@ BoxedPtr<FsNode> FsNode::getChildByName(const std::string& name) {
 BoxedPtr<FsNode> FsNode::getChildByNameIgnoreCase(const std::string& name) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
-    for (auto& n : this->childrenByName) {
-        if (stringCaseInSensativeEquals(n.first, name)) {
-            return n.second;
-        }
+    std::string lowerName = name;
+    stringToLower(lowerName);
+    auto it = this->childrenByLowerCaseName.find(lowerName);
+    if (it != this->childrenByLowerCaseName.end()) {
+        return it->second.node;
     }
     return NULL;
 }
@@ -98,13 +132,36 @@ U32 FsNode::getChildCount() {
 void FsNode::addChild(BoxedPtr<FsNode> node) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
+    auto it = this->childrenByName.find(node->name);
+    if (it != this->childrenByName.end()) {
+        this->removeChildFromIndex(it->second);
+    }
     this->childrenByName[node->name] = node;
+
+    std::string lowerName = node->name;
+    stringToLower(lowerName);
+    LowerCaseChild& child = this->childrenByLowerCaseName[lowerName];
+    if (!child.count) {
+        child.node = node;
+    }
+    child.count++;
+    if (!this->isLoadingChildren) {
+        Fs::invalidatePathCache();
+        // a directory's modified time changes when an entry is added
+        this->invalidateStat();
+    }
 }
 
 void FsNode::removeChildByName(const std::string& name) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->childrenByNameMutex);
     this->loadChildren();
-    this->childrenByName.erase(name);
+    auto it = this->childrenByName.find(name);
+    if (it != this->childrenByName.end()) {
+        this->removeChildFromIndex(it->second);
+        this->childrenByName.erase(it);
+    }
+    Fs::invalidatePathCache();
+    this->invalidateStat();
 }
 
 void FsNode::getAllChildren(std::vector<BoxedPtr<FsNode> > & results) {
@@ -33,9 +33,11 @@ public:
 
     virtual bool canRead();
     virtual bool canWrite();
+    virtual void invalidateStat() {}
 
     virtual std::string getLink() {return this->link;}
     virtual bool isLink() { return this->link.size() > 0; }
+    virtual bool isDynamicLink() { return false; }
 
     U32 getHardLinkCount() {return this->hardLinkCount;}    
     bool isDirectory() {return this->isDir;}
@@ -79,14 +81,23 @@ protected:
 private:
     const bool isDir;
     bool hasLoadedChildrenFromFileSystem;    
+    bool isLoadingChildren;
 
     std::unordered_map<std::string, BoxedPtr<FsNode> > childrenByName;
+    // keyed by the lower case name, count is how many children have that name ignoring case
+    struct LowerCaseChild {
+        LowerCaseChild() : count(0) {}
+        BoxedPtr<FsNode> node;
+        U32 count;
+    };
+    std::unordered_map<std::string, LowerCaseChild> childrenByLowerCaseName;
     BOXEDWINE_MUTEX childrenByNameMutex;
 
     std::vector<KFileLock> locks;       
     BOXEDWINE_CONDITION locksCS;    
 
     void loadChildren();
+    void removeChildFromIndex(const BoxedPtr<FsNode>& node);
 };
 
 #endif
@@ -10,25 +10,229 @@ extern "C"
 #include "fszip.h"
 #include "fszipnode.h"
 #include <time.h> 
+#include UNISTD
+#include <fcntl.h>
 
-void FsZip::setupZipRead(U64 zipOffset, U64 zipFileOffset) {
-#ifdef BOXEDWINE_ZLIB
-    char tmp[4096];
+U64 FsZip::getDataOffset(U64 zipOffset) {
+    U64 result = 0;
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->zipfileMutex);
 
-    if (zipOffset != lastZipOffset || zipFileOffset < lastZipFileOffset) {
+    if (unzSetOffset64(this->zipfile, zipOffset) == UNZ_OK && unzOpenCurrentFile(this->zipfile) == UNZ_OK) {
+        result = unzGetCurrentFileZStreamPos64(this->zipfile);
         unzCloseCurrentFile(this->zipfile);
-        unzSetOffset64(this->zipfile, zipOffset);
-        lastZipFileOffset = 0;
-        unzOpenCurrentFile(this->zipfile);
-        lastZipOffset = zipOffset;
-    }
-    if (zipFileOffset != lastZipFileOffset) {
-        U32 todo = (U32)(zipFileOffset - lastZipFileOffset);
-        while (todo) {
-            todo-=unzReadCurrentFile(this->zipfile, tmp, todo>4096?4096:todo);
+    }
+    return result;
+}
+
+U32 FsZip::maxReaders;
+
+FsZip::FsZip() : readersCond("FsZip::readersCond"), readerCount(0), nextStreamId(1) {
+}
+
+U32 FsZip::allocStreamId() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->readersCond);
+    return this->nextStreamId++;
+}
+
+FsZipReader* FsZip::getReader(U32 streamId) {
+    BOXEDWINE_CONDITION_LOCK(this->readersCond);
+    while (true) {
+        if (this->freeReaders.size()) {
+            // prefer the one this stream used last, its inflate state is probably right where it is needed
+            U32 index = 0;
+            for (U32 i = 0; i < (U32)this->freeReaders.size(); i++) {
+                if (this->freeReaders[i]->streamId == streamId) {
+                    index = i;
+                    break;
+                }
+            }
+            FsZipReader* result = this->freeReaders[index];
+            this->freeReaders.erase(this->freeReaders.begin() + index);
+            BOXEDWINE_CONDITION_UNLOCK(this->readersCond);
+            return result;
+        }
+#ifdef BOXEDWINE_MULTI_THREADED
+        U32 limit = maxReaders ? maxReaders : Platform::getCpuCount();
+        if (this->readerCount >= limit) {
+            BOXEDWINE_CONDITION_WAIT(this->readersCond);
+            continue;
         }
-    }  
 #endif
+        this->readerCount++;
+        BOXEDWINE_CONDITION_UNLOCK(this->readersCond);
+        return new FsZipReader(this->zipPath);
+    }
+}
+
+void FsZip::releaseReader(FsZipReader* reader) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->readersCond);
+    this->freeReaders.push_back(reader);
+    BOXEDWINE_CONDITION_SIGNAL(this->readersCond);
+}
+
+FsZipReader::FsZipReader(const std::string& zipPath) : streamId(0), zipNode(NULL), dataOffset(0), inflating(false), positioned(false), done(false), out(0), in(0) {
+    memset(&this->strm, 0, sizeof(this->strm));
+    this->handle = ::open(zipPath.c_str(), O_RDONLY | O_BINARY);
+    if (this->handle < 0) {
+        klog("FsZipReader could not open %s", zipPath.c_str());
+    }
+}
+
+FsZipReader::~FsZipReader() {
+    if (this->inflating) {
+        inflateEnd(&this->strm);
+    }
+    if (this->handle >= 0) {
+        ::close(this->handle);
+    }
+}
+
+bool FsZipReader::restart(FsZipCheckpoint* checkpoint) {
+    if (!this->inflating) {
+        // negative window bits because zip entries are raw deflate streams
+        if (inflateInit2(&this->strm, -15) != Z_OK) {
+            return false;
+        }
+        this->inflating = true;
+    } else {
+        inflateReset(&this->strm);
+    }
+    this->positioned = true;
+    this->done = false;
+    this->strm.avail_in = 0;
+    this->strm.next_out = this->window;
+    if (!checkpoint) {
+        this->in = 0;
+        this->out = 0;
+        lseek64(this->handle, this->dataOffset, SEEK_SET);
+        return true;
+    }
+    this->in = checkpoint->in - (checkpoint->bits ? 1 : 0);
+    this->out = checkpoint->out;
+    lseek64(this->handle, this->dataOffset + this->in, SEEK_SET);
+    if (checkpoint->bits) {
+        U8 c;
+        if (::read(this->handle, &c, 1) != 1) {
+            return false;
+        }
+        this->in++;
+        inflatePrime(&this->strm, checkpoint->bits, c >> (8 - checkpoint->bits));
+    }
+    inflateSetDictionary(&this->strm, checkpoint->window, FS_ZIP_WINDOW_SIZE);
+    // so that checkpoints made in the next 32k still have the full window
+    memcpy(this->window, checkpoint->window, FS_ZIP_WINDOW_SIZE);
+    return true;
+}
+
+void FsZipReader::fillInput() {
+    U64 todo = this->zipNode->getInfo().compressedLength - this->in;
+
+    if (todo > FS_ZIP_INPUT_SIZE) {
+        todo = FS_ZIP_INPUT_SIZE;
+    }
+    if (todo) {
+        int didRead = ::read(this->handle, this->input, (U32)todo);
+        if (didRead > 0) {
+            this->strm.next_in = this->input;
+            this->strm.avail_in = didRead;
+            this->in += didRead;
+        }
+    }
+}
+
+void FsZipReader::addCheckpoint() {
+    FsZipCheckpoint* checkpoint = new FsZipCheckpoint();
+    U32 windowPos = (U32)(this->strm.next_out - this->window);
+
+    checkpoint->out = this->out;
+    checkpoint->in = this->in - this->strm.avail_in;
+    checkpoint->bits = this->strm.data_type & 7;
+    // the window is circular, the oldest data starts at next_out
+    memcpy(checkpoint->window, this->window + windowPos, FS_ZIP_WINDOW_SIZE - windowPos);
+    memcpy(checkpoint->window + FS_ZIP_WINDOW_SIZE - windowPos, this->window, windowPos);
+    this->zipNode->addCheckpoint(checkpoint);
+}
+
+// inflates at most len bytes into buffer, buffer can be NULL to skip data, this->out says how much was produced
+void FsZipReader::inflateNext(U8* buffer, U32 len) {
+    U32 room = FS_ZIP_WINDOW_SIZE - (U32)(this->strm.next_out - this->window);
+
+    if (!room) {
+        this->strm.next_out = this->window;
+        room = FS_ZIP_WINDOW_SIZE;
+    }
+    if (!this->strm.avail_in) {
+        fillInput();
+    }
+    this->strm.avail_out = (room < len) ? room : len;
+
+    U8* start = this->strm.next_out;
+    // Z_BLOCK stops at the end of each deflate block so that a checkpoint can be made
+    int ret = inflate(&this->strm, Z_BLOCK);
+    U32 produced = (U32)(this->strm.next_out - start);
+
+    if (buffer) {
+        memcpy(buffer, start, produced);
+    }
+    this->out += produced;
+    if (ret == Z_STREAM_END) {
+        this->done = true;
+    } else if (ret != Z_OK) {
+        if (ret != Z_BUF_ERROR || !produced) {
+            klog("FsZipReader inflate failed %d: %s", ret, this->zipNode->getInfo().filename.c_str());
+            this->done = true;
+        }
+    } else if ((this->strm.data_type & 128) && !(this->strm.data_type & 64) && this->zipNode->needsCheckpoint(this->out)) {
+        addCheckpoint();
+    }
+}
+
+U32 FsZipReader::read(FsZipNode* zipNode, U32 streamId, U64 pos, U8* buffer, U32 len) {
+    const fsZipInfo& info = zipNode->getInfo();
+
+    if (this->handle < 0) {
+        return 0;
+    }
+    if (this->streamId != streamId || this->zipNode != zipNode) {
+        this->streamId = streamId;
+        this->zipNode = zipNode;
+        this->positioned = false;
+        this->dataOffset = zipNode->getDataOffset();
+    }
+    if (!this->dataOffset) {
+        return 0;
+    }
+    if (pos >= info.length) {
+        return 0;
+    }
+    if (len > info.length - pos) {
+        len = (U32)(info.length - pos);
+    }
+    if (info.compressionMethod == 0) {
+        lseek64(this->handle, this->dataOffset + pos, SEEK_SET);
+        int result = ::read(this->handle, buffer, len);
+        return result < 0 ? 0 : (U32)result;
+    }
+    if (info.compressionMethod != Z_DEFLATED) {
+        kwarn("FsZipReader unsupported compression method %d: %s", info.compressionMethod, info.filename.c_str());
+        return 0;
+    }
+    FsZipCheckpoint* checkpoint = this->zipNode->getCheckpoint(pos);
+    if (!this->positioned || pos < this->out || (checkpoint && checkpoint->out > this->out)) {
+        if (!restart(checkpoint)) {
+            return 0;
+        }
+    }
+    while (this->out < pos && !this->done) {
+        U64 todo = pos - this->out;
+        inflateNext(NULL, todo > FS_ZIP_WINDOW_SIZE ? FS_ZIP_WINDOW_SIZE : (U32)todo);
+    }
+    U64 start = this->out;
+    while (this->out - start < len && !this->done) {
+        U32 result = (U32)(this->out - start);
+        inflateNext(buffer + result, len - result);
+    }
+    return (U32)(this->out - start);
 }
 
 bool FsZip::init(const std::string& zipPath, const std::string& mount) {
@@ -41,7 +245,7 @@ bool FsZip::init(const std::string& zipPath, const std::string& mount) {
         Fs::makeLocalDirs(mount);
         strippedMount = mount.substr(0, mount.length() - 1);
     }
-    this->lastZipOffset = 0xFFFFFFFFFFFFFFFFl;
+    this->zipPath = zipPath;
     if (zipPath.length()) {
         unz_global_info global_info;
         U32 i;
@@ -71,6 +275,8 @@ bool FsZip::init(const std::string& zipPath, const std::string& mount) {
             }
             zipInfo[i].filename.append(tmp);
             zipInfo[i].offset = unzGetOffset64(this->zipfile);
+            zipInfo[i].compressedLength = file_info.compressed_size;
+            zipInfo[i].compressionMethod = file_info.compression_method;
             Fs::remoteNameToLocal(zipInfo[i].filename); // converts special characters like :
             if (stringHasEnding(zipInfo[i].filename, ".link")) {
                 U32 read;
@@ -117,9 +323,13 @@ bool FsZip::init(const std::string& zipPath, const std::string& mount) {
             BoxedPtr<FsNode> parent = Fs::getNodeFromLocalPath("", parentPath, true);            
             std::string localFileName = Fs::getFileNameFromPath(localPath);
             std::string nativePath = Fs::getNativePathFromParentAndLocalFilename(parent, localFileName);
+            // the parent's children were loaded from the host, so if there is no child yet then the file only exists in the zip
+            BoxedPtr<FsNode> existing = parent->getChildByName(localFileName);
+            bool zipOnly = !existing || existing->type != FsNode::File || ((FsFileNode*)existing.get())->zipNode;
             BoxedPtr<FsFileNode> node = (FsFileNode*)Fs::addFileNode(localPath, zipInfo[i].link, nativePath, zipInfo[i].isDirectory, parent).get();
             std::shared_ptr<FsZip> thisShared = shared_from_this();
             node->zipNode = std::make_shared<FsZipNode>(zipInfo[i], thisShared);
+            node->zipOnly = zipOnly;
         }   
         delete[] zipInfo;
     }
@@ -131,6 +341,9 @@ FsZip::~FsZip() {
 #ifdef BOXEDWINE_ZLIB
     unzClose(this->zipfile);
 #endif
+    for (auto& reader : this->freeReaders) {
+        delete reader;
+    }
 }
 
 void FsZip::remove(const std::string& localPath) {
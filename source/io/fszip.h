@@ -15,7 +15,7 @@ extern "C"
 
 class fsZipInfo {
 public:
-    fsZipInfo() : isLink(false), isDirectory(false), length(0), lastModified(0), offset(0) {}
+    fsZipInfo() : isLink(false), isDirectory(false), length(0), lastModified(0), offset(0), compressedLength(0), compressionMethod(0) {}
     std::string filename;
     std::string link;
     bool isLink;
@@ -23,20 +23,77 @@ public:
     U64 length;
     U64 lastModified;
     U64 offset;
+    U64 compressedLength;
+    U32 compressionMethod;
+};
+
+#define FS_ZIP_WINDOW_SIZE 32768
+#define FS_ZIP_INPUT_SIZE 16384
+// a checkpoint costs FS_ZIP_WINDOW_SIZE bytes of memory
+#define FS_ZIP_CHECKPOINT_SPACING (256 * 1024)
+
+// snapshot of the inflate state at a deflate block boundary so that reading can resume from
+// the middle of an entry, this is the same idea as zlib's examples/zran.c
+class FsZipCheckpoint {
+public:
+    U64 out; // uncompressed offset
+    U64 in; // offset into the compressed data of the first full byte of the next block
+    U32 bits; // number of bits in the byte before in that belong to the next block
+    U8 window[FS_ZIP_WINDOW_SIZE]; // the uncompressed data right before out
+};
+
+class FsZipNode;
+
+// a file handle and inflate state for reading the entries of one zip.  FsZip keeps a pool of these and
+// an open node borrows one for each read, so reads of different entries can inflate at the same time
+class FsZipReader {
+public:
+    FsZipReader(const std::string& zipPath);
+    ~FsZipReader();
+
+    // if streamId was the last one to use this reader then inflating continues from where it stopped
+    U32 read(FsZipNode* zipNode, U32 streamId, U64 pos, U8* buffer, U32 len);
+
+    U32 streamId;
+private:
+    bool restart(FsZipCheckpoint* checkpoint);
+    void fillInput();
+    void inflateNext(U8* buffer, U32 len);
+    void addCheckpoint();
+
+    FsZipNode* zipNode;
+    int handle;
+    U64 dataOffset;
+    bool inflating;
+    bool positioned; // false until restart is called for the current stream
+    bool done;
+    U64 out; // uncompressed offset of the next byte inflate will produce
+    U64 in; // compressed offset of the next byte that will be read into input
+    z_stream strm;
+    U8 input[FS_ZIP_INPUT_SIZE];
+    U8 window[FS_ZIP_WINDOW_SIZE];
 };
 
 class FsZip : public std::enable_shared_from_this<FsZip> {
 public:
+    FsZip();
     ~FsZip();
     bool init(const std::string& zipPath, const std::string& mount);
     unzFile zipfile;
+    std::string zipPath;
 
-    U64 lastZipOffset = 0xFFFFFFFFFFFFFFFFl;
-    U64 lastZipFileOffset;
-
-    void setupZipRead(U64 zipOffset, U64 zipFileOffset);
+    // returns where the compressed data for the entry starts in the zip file, 0 on failure
+    U64 getDataOffset(U64 zipOffset);
     void remove(const std::string& localPath);
 
+    // each open node gets its own stream id so that it can find the reader it used last
+    U32 allocStreamId();
+    FsZipReader* getReader(U32 streamId);
+    void releaseReader(FsZipReader* reader);
+
+    // the most readers each zip will inflate with at the same time, 0 means the number of host cores
+    static U32 maxReaders;
+
     static bool readFileFromZip(const std::string& zipFile, const std::string& file, std::string& result);
     static bool extractFileFromZip(const std::string& zipFile, const std::string& file, const std::string& path);
     static std::string unzip(const std::string& zipFile, const std::string& path, std::function<void(U32, std::string)> percentDone);
@@ -44,6 +101,12 @@ public:
 
 private:
     std::string deleteFilePath;
+    BOXEDWINE_MUTEX zipfileMutex;
+
+    BOXEDWINE_CONDITION readersCond;
+    std::vector<FsZipReader*> freeReaders; // least recently used first
+    U32 readerCount;
+    U32 nextStreamId;
 };
 #endif
 #endif
@@ -6,10 +6,52 @@
 #include <fcntl.h>
 #include "fszipopennode.h"
 
-FsZipNode::FsZipNode(const fsZipInfo& zipInfo, std::shared_ptr<FsZip>& fsZip) : fsZip(fsZip) {
+FsZipNode::FsZipNode(const fsZipInfo& zipInfo, std::shared_ptr<FsZip>& fsZip) : fsZip(fsZip), dataOffset(0) {
     this->zipInfo = zipInfo;
 }
 
+FsZipNode::~FsZipNode() {
+    for (auto& checkpoint : this->checkpoints) {
+        delete checkpoint;
+    }
+}
+
+U64 FsZipNode::getDataOffset() {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->checkpointMutex);
+    if (!this->dataOffset) {
+        this->dataOffset = this->fsZip->getDataOffset(this->zipInfo.offset);
+    }
+    return this->dataOffset;
+}
+
+FsZipCheckpoint* FsZipNode::getCheckpoint(U64 offset) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->checkpointMutex);
+    auto it = std::upper_bound(this->checkpoints.begin(), this->checkpoints.end(), offset, [](U64 offset, FsZipCheckpoint* checkpoint) {
+        return offset < checkpoint->out;
+        });
+    if (it == this->checkpoints.begin()) {
+        return NULL;
+    }
+    return *(it - 1);
+}
+
+bool FsZipNode::needsCheckpoint(U64 offset) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->checkpointMutex);
+    U64 last = this->checkpoints.size() ? this->checkpoints.back()->out : 0;
+    return offset >= last + FS_ZIP_CHECKPOINT_SPACING;
+}
+
+void FsZipNode::addCheckpoint(FsZipCheckpoint* checkpoint) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->checkpointMutex);
+    U64 last = this->checkpoints.size() ? this->checkpoints.back()->out : 0;
+    // another stream might have gotten here first
+    if (checkpoint->out >= last + FS_ZIP_CHECKPOINT_SPACING) {
+        this->checkpoints.push_back(checkpoint);
+    } else {
+        delete checkpoint;
+    }
+}
+
 bool FsZipNode::moveToFileSystem(BoxedPtr<FsNode> node) {
     if (node->isDirectory())
         return false;
@@ -41,7 +83,7 @@ U64 FsZipNode::length() {
 
 FsOpenNode* FsZipNode::open(BoxedPtr<FsNode> node, U32 flags) {
     std::shared_ptr<FsZipNode> zipNode = shared_from_this();
-    return new FsZipOpenNode(node, zipNode, flags, (U64)this->zipInfo.offset);
+    return new FsZipOpenNode(node, zipNode, flags);
 }
 
 #endif
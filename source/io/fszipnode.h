@@ -11,14 +11,28 @@ class FsFileNode;
 class FsZipNode : public std::enable_shared_from_this<FsZipNode> {
 public:
     FsZipNode(const fsZipInfo& zipInfo, std::shared_ptr<FsZip>& fsZip);
+    ~FsZipNode();
     U64 lastModified();
     U64 length();
     FsOpenNode* open(BoxedPtr<FsNode> node, U32 flags);
     bool moveToFileSystem(BoxedPtr<FsNode> node);
 
+    const fsZipInfo& getInfo() {return this->zipInfo;}
+    U64 getDataOffset();
+
+    // the closest checkpoint at or before offset, NULL if inflating needs to start at the beginning
+    FsZipCheckpoint* getCheckpoint(U64 offset);
+    bool needsCheckpoint(U64 offset);
+    void addCheckpoint(FsZipCheckpoint* checkpoint);
+
     std::shared_ptr<FsZip> fsZip;
 private:
     fsZipInfo zipInfo;
+    U64 dataOffset;
+
+    BOXEDWINE_MUTEX checkpointMutex;
+    // sorted by out, checkpoints are never removed so they can be used after the mutex is released
+    std::vector<FsZipCheckpoint*> checkpoints;
 };
 #endif
 #endif
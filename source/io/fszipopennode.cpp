@@ -7,7 +7,8 @@
 #include "fszip.h"
 
 
-FsZipOpenNode::FsZipOpenNode(BoxedPtr<FsNode> node, std::shared_ptr<FsZipNode>& zipNode, U32 flags, U64 offset) : FsOpenNode(node, flags), zipNode(zipNode), pos(0), offset(offset) {
+FsZipOpenNode::FsZipOpenNode(BoxedPtr<FsNode> node, std::shared_ptr<FsZipNode>& zipNode, U32 flags) : FsOpenNode(node, flags), zipNode(zipNode), pos(0) {
+    this->streamId = zipNode->fsZip->allocStreamId();
 }
 
 S64 FsZipOpenNode::length() {
@@ -73,13 +74,11 @@ bool FsZipOpenNode::canMap() {
 }
 
 U32 FsZipOpenNode::readNative(U8* buffer, U32 len) {
-    U32 result;
-    BOXEDWINE_CRITICAL_SECTION;
-
-    this->zipNode->fsZip->setupZipRead(this->offset, this->pos);    
-    result = unzReadCurrentFile(this->zipNode->fsZip->zipfile, buffer, len);
+    FsZip* fsZip = this->zipNode->fsZip.get();
+    FsZipReader* reader = fsZip->getReader(this->streamId);
+    U32 result = reader->read(this->zipNode.get(), this->streamId, this->pos, buffer, len);
+    fsZip->releaseReader(reader);
     this->pos+=result;
-    this->zipNode->fsZip->lastZipFileOffset = this->pos;
     return result;
 }
 
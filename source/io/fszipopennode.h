@@ -7,7 +7,7 @@ class FsZipNode;
 
 class FsZipOpenNode : public FsOpenNode {
 public:
-    FsZipOpenNode(BoxedPtr<FsNode> node, std::shared_ptr<FsZipNode>& zipNode, U32 flags, U64 offset);
+    FsZipOpenNode(BoxedPtr<FsNode> node, std::shared_ptr<FsZipNode>& zipNode, U32 flags);
     virtual S64  length();
     virtual bool setLength(S64 length);
     virtual S64  getFilePointer();
@@ -29,7 +29,7 @@ public:
 private:
     std::shared_ptr<FsZipNode> zipNode;
     S64 pos;
-    U64 offset;
+    U32 streamId;
 };
 
 #endif
\ No newline at end of file
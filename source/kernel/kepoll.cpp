@@ -22,12 +22,18 @@
 
 #include <string.h>
 
-KEPoll::KEPoll() : KObject(KTYPE_EPOLL) {
+KEPoll::KEPoll() : KObject(KTYPE_EPOLL), readyCond("KEPoll::readyCond") {
 }
 
 KEPoll::~KEPoll() {
-     for( const auto& n : this->data ) {
-         delete n.second;
+    for (const auto& n : this->entries) {
+        KEPollEntry* entry = n.second;
+        std::shared_ptr<KObject> object = entry->object.lock();
+        if (object && !entry->pollOnEveryWait) {
+            object->removeEPollEntry(entry);
+        }
+        entry->node.remove();
+        delete entry;
     }
 }
 
@@ -125,81 +131,257 @@ void KEPoll::close() {
 }
 
 
-#define K_EPOLL_CTL_ADD 1
-#define K_EPOLL_CTL_DEL 2
-#define K_EPOLL_CTL_MOD 3
+void KEPoll::onReady(KEPollEntry* entry) {
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+        // if it is already in the ready list then the next wait will check it anyway
+        if (entry->disabled || entry->node.isInList()) {
+            return;
+        }
+        this->readyList.addToBack(&entry->node);
+    }
+    BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(this->readyCond);
+}
+
+void KEPoll::removeEntry(KEPollEntry* entry) {
+    // once the object no longer knows about the entry it can't be put back in the ready list
+    std::shared_ptr<KObject> object = entry->object.lock();
+    if (object && !entry->pollOnEveryWait) {
+        object->removeEPollEntry(entry);
+    }
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+        entry->node.remove();
+    }
+    delete entry;
+}
+
+void KEPoll::unlinkClosedEntry(KEPollEntry* entry) {
+    // like Linux, the entry is no longer reported once the object is closed.  It is only deleted while holding
+    // ctlMutex, by ctl when the fd is looked up again or by the destructor, since ctl keeps using an entry after
+    // it lets go of entriesMutex
+    entry->node.remove();
+    entry->disabled = true;
+}
 
 U32 KEPoll::ctl(U32 op, FD fd, U32 address) {
     KFileDescriptor* targetFD = KThread::currentThread()->process->getFileDescriptor(fd);
-    Data* existing = NULL;
+    KEPollEntry* existing = NULL;
+    U32 events = 0;
+    U64 data = 0;
 
     if (!targetFD) {
         return -K_EBADF;
     }
+    if (op == K_EPOLL_CTL_ADD || op == K_EPOLL_CTL_MOD) {
+        // read these before taking any locks in case the address is bad
+        events = readd(address);
+        data = readq(address + 4);
+    }
 
-    if (this->data.count(fd))
-        existing = this->data[fd];
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->ctlMutex);
+    KEPollEntry* closed = NULL;
+    {
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+        auto it = this->entries.find(fd);
+        if (it != this->entries.end()) {
+            existing = it->second;
+            // the fd was closed and its number reused, the old entry went away with the object it was for
+            if (existing->object.lock() != targetFD->kobject) {
+                this->entries.erase(it);
+                closed = existing;
+                existing = NULL;
+            }
+        }
+    }
+    if (closed) {
+        removeEntry(closed);
+    }
 
     switch (op) {
         case K_EPOLL_CTL_ADD:
             if (existing) {
                 return -K_EEXIST;
             }
-            existing = new Data();
-            existing->fd = fd;
-            existing->events = readd(address);
-            existing->data = readq(address + 4);
-            this->data[fd] = existing;
+            existing = new KEPollEntry(this, fd, targetFD->kobject);
+            existing->events = events;
+            existing->data = data;
+            if (!existing->pollOnEveryWait) {
+                targetFD->kobject->addEPollEntry(existing);
+            }
+            {
+                BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+                this->entries[fd] = existing;
+                if (existing->pollOnEveryWait) {
+                    this->pollList.addToBack(&existing->node);
+                } else if (!existing->node.isInList()) {
+                    // check its current state on the next wait
+                    this->readyList.addToBack(&existing->node);
+                }
+            }
             break;
         case K_EPOLL_CTL_DEL:
             if (!existing)
                 return -K_ENOENT;
-            this->data.erase(fd);
-            delete existing;
-            break;
+            {
+                BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+                this->entries.erase(fd);
+            }
+            removeEntry(existing);
+            return 0;
         case K_EPOLL_CTL_MOD:
             if (!existing)
                 return -K_ENOENT;
-            existing->events = readd(address);
-            existing->data = readq(address + 4);
+            {
+                BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+                existing->events = events;
+                existing->data = data;
+                existing->disabled = false;
+                if (!existing->pollOnEveryWait && !existing->node.isInList()) {
+                    this->readyList.addToBack(&existing->node);
+                }
+            }
             break;
         default:
             return -K_EINVAL;
     }
+    // a thread might already be waiting on this epoll
+    BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(this->readyCond);
     return 0;
 }
 
-U32 KEPoll::wait(U32 events, U32 maxevents, U32 timeout) {    
-    S32 result = 0;
-    U32 i;
-    THREAD_LOCAL static KPollData pollData[256];	
-    U32 pollCount=0;
+// returns true if the entry should be reported, caller must hold entriesMutex
+static bool checkEPollEntry(KEPollEntry* entry, const std::shared_ptr<KObject>& object, std::vector<KPollData>& results) {
+    U32 revents = getPollReadyEvents(object.get(), entry->events);
 
-    for( const auto& n : this->data ) {
-        if (pollCount>=256) {
-            kpanic("Wasn't expect a poll count of more than 256");
-            break;
-        }
-        Data* next = n.second;
-        pollData[pollCount].events = next->events;
-        pollData[pollCount].fd = next->fd;
-        pollData[pollCount].data = next->data;
-        pollCount++;	
+    if (!revents) {
+        return false;
     }
-    result = internal_poll(pollData, pollCount, timeout);
-    if (result >= 0) {
-        result = 0;
-        for (i=0;i<pollCount;i++) {
-            if (pollData[i].revents!=0) {
-                writed(events + result * 12, pollData[i].revents);        
-                writeq(events + result * 12 + 4, pollData[i].data);
-                result++;
-                if (result>=(S32)maxevents) {
-                    kwarn("possible starvation in epoll, more events are ready than can be received.");
-                    break;
+    KPollData result;
+    result.fd = entry->fd;
+    result.events = entry->events;
+    result.revents = revents;
+    result.data = entry->data;
+    results.push_back(result);
+    if (entry->events & K_EPOLLONESHOT) {
+        entry->disabled = true;
+    }
+    return true;
+}
+
+U32 KEPoll::wait(U32 events, U32 maxevents, U32 timeout) {
+    KThread* thread = KThread::currentThread();
+    std::vector<std::shared_ptr<KObject>> polledObjects;
+    std::vector<U32> polledEvents;
+    std::vector<KPollData> results;
+
+    if (!maxevents || maxevents > 0x7FFFFFFF / 12) {
+        return -K_EINVAL;
+    }
+    while (true) {
+        BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(thread->pollCond);
+        bool interrupted = !thread->inSignal && thread->interrupted;
+
+        if (interrupted)
+            thread->interrupted = false;
+
+        // objects that can't notify us still need to be waited on and checked each time
+        polledObjects.clear();
+        polledEvents.clear();
+        {
+            BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+            for (KListNode<KEPollEntry*>* node = this->pollList.front(); node; node = node->getNext()) {
+                std::shared_ptr<KObject> object = node->data->object.lock();
+                if (object && !node->data->disabled) {
+                    polledObjects.push_back(object);
+                    polledEvents.push_back(node->data->events);
+                }
+            }
+        }
+
+        // gather locks before we check the entries so that we don't miss one
+        BOXEDWINE_CONDITION_ADD_CHILD_CONDITION(thread->pollCond, this->readyCond, nullptr);
+        for (U32 i = 0; i < (U32)polledObjects.size(); i++) {
+            polledObjects[i]->waitForEvents(thread->pollCond, polledEvents[i]);
+        }
+
+        results.clear();
+        {
+            BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->entriesMutex);
+            KListNode<KEPollEntry*>* node = this->pollList.front();
+            while (node && results.size() < maxevents) {
+                KListNode<KEPollEntry*>* next = node->getNext();
+                KEPollEntry* entry = node->data;
+                std::shared_ptr<KObject> object = entry->object.lock();
+
+                if (!object) {
+                    unlinkClosedEntry(entry);
+                } else if (!entry->disabled) {
+                    checkEPollEntry(entry, object, results);
+                }
+                node = next;
+            }
+            // level triggered entries that are still ready go to the back so that others get a turn when there are more than maxevents
+            U32 count = this->readyList.size();
+            node = this->readyList.front();
+            while (node && count && results.size() < maxevents) {
+                KListNode<KEPollEntry*>* next = node->getNext();
+                KEPollEntry* entry = node->data;
+                std::shared_ptr<KObject> object = entry->object.lock();
+
+                count--;
+                node->remove();
+                if (!object) {
+                    unlinkClosedEntry(entry);
+                } else if (checkEPollEntry(entry, object, results) && !(entry->events & K_EPOLLET) && !entry->disabled) {
+                    this->readyList.addToBack(node);
                 }
-            }        
+                node = next;
+            }
+        }
+        if (results.size()) {
+            thread->condStartWaitTime = 0;
+            thread->pollCond.unlockAndRemoveChildren();
+            break;
+        }
+        if (timeout==0) {
+            thread->pollCond.unlockAndRemoveChildren();
+            return 0;
+        }
+        if (interrupted) {
+            thread->condStartWaitTime = 0;
+            thread->pollCond.unlockAndRemoveChildren();
+            return -K_EINTR;
         }
+        if (!thread->condStartWaitTime) {
+            thread->condStartWaitTime = KSystem::getMilliesSinceStart();
+        } else {
+            U32 diff = KSystem::getMilliesSinceStart()-thread->condStartWaitTime;
+            if (diff>timeout) {
+                thread->condStartWaitTime = 0;
+                thread->pollCond.unlockAndRemoveChildren();
+                return 0;
+            }
+            timeout-=diff;
+        }
+        if (timeout>0xF0000000) {
+            BOXEDWINE_CONDITION_WAIT(thread->pollCond);
+        } else {
+            BOXEDWINE_CONDITION_WAIT_TIMEOUT(thread->pollCond, timeout);
+        }
+#ifdef BOXEDWINE_MULTI_THREADED
+        if (thread->terminating) {
+            return -K_EINTR;
+        }
+        if (thread->startSignal) {
+            thread->startSignal = false;
+            return -K_CONTINUE;
+        }
+#endif
+    }
+    for (U32 i = 0; i < (U32)results.size(); i++) {
+        writed(events + i * 12, results[i].revents);
+        writeq(events + i * 12 + 4, results[i].data);
     }
-    return result;
+    return (U32)results.size();
 }
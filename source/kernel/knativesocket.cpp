@@ -638,6 +638,10 @@ U32 KNativeSocketObject::accept(KFileDescriptor* fd, U32 address, U32 len, U32 f
         std::shared_ptr<KNativeSocketObject> s = std::make_shared<KNativeSocketObject>(this->domain, this->type, this->protocol);
         KFileDescriptor* resultFD = KThread::currentThread()->process->allocFileDescriptor(s, K_O_RDWR, 0, -1, 0);
 
+        if (!resultFD) {
+            closesocket(result);
+            return -K_EMFILE;
+        }
         if (flags & FD_CLOEXEC) {
             resultFD->descriptorFlags|=FD_CLOEXEC;
         }
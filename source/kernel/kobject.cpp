@@ -1,5 +1,6 @@
 #include "boxedwine.h"
 #include "kobject.h"
+#include "kepoll.h"
 
 KObject::KObject(U32 type) : type(type) {
     if (KThread::currentThread()) {
@@ -87,4 +88,21 @@ U32 KObject::write(U32 address, U32 len) {
         address+=todo;
     }
     return wrote;
-}
\ No newline at end of file
+}
+void KObject::addEPollEntry(KEPollEntry* entry) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->epollEntriesMutex);
+    this->epollEntries.push_back(entry);
+}
+
+void KObject::removeEPollEntry(KEPollEntry* entry) {
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->epollEntriesMutex);
+    VECTOR_REMOVE(this->epollEntries, entry);
+}
+
+void KObject::notifyEPoll() {
+    // the entry can't be deleted while we hold this mutex, KEPoll removes it from us first
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(this->epollEntriesMutex);
+    for (auto& entry : this->epollEntries) {
+        entry->epoll->onReady(entry);
+    }
+}
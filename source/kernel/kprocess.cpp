@@ -80,9 +80,14 @@ KProcess::KProcess(U32 id) : id(id),
     phnum(0),
     phentsize(0),
     entry(0),
+    vdsoAddress(0),
     eventQueueFD(0),
     exitOrExecCond("KProcess::exitOrExecCond"),
+    mmapFaults(0),
+    mmapPagesPopulated(0),
+    mmapBytesRead(0),
     hasSetStackMask(false),
+    fds(new KFileDescriptorTable(KPROCESS_INITIAL_FDS)),
     threadsCondition("KProcess::threadsCond"),
     systemProcess(false) {
 
@@ -133,9 +138,9 @@ KProcess::KProcess(U32 id) : id(id),
 }
 
 void KProcess::onExec() {
-    std::unordered_map<U32, KFileDescriptor*> fdsToClose = this->fds; // make a copy since we can't remove from it while iterating
-    for( const auto& n : fdsToClose ) {
-        KFileDescriptor* fd = n.second;
+    std::vector<KFileDescriptor*> fdsToClose; // make a copy since we can't remove from it while iterating
+    this->getFileDescriptors(fdsToClose);
+    for (auto& fd : fdsToClose) {
         if (fd->descriptorFlags) {
             fd->refCount = 1; // make sure it is really closed
             fd->close();
@@ -210,14 +215,18 @@ KProcess::~KProcess() {
 	if (this->memory) {
 		this->memory->decRefCount();
 	}
+    delete this->fds.load();
+    for (auto& table : this->retiredFds) {
+        delete table;
+    }
 }
 
 void KProcess::cleanupProcess() {    
     removeTimer(&this->timer);
 
-    std::unordered_map<U32, KFileDescriptor*> fdsToClose = this->fds; // make a copy since we can't remove from it while iterating
-    for( const auto& n : fdsToClose ) {
-        KFileDescriptor* fd = n.second;
+    std::vector<KFileDescriptor*> fdsToClose; // make a copy since we can't remove from it while iterating
+    this->getFileDescriptors(fdsToClose);
+    for (auto& fd : fdsToClose) {
         fd->refCount = 1; // make sure it is really closed
         fd->close();
     }
@@ -311,10 +320,11 @@ void KProcess::clone(const std::shared_ptr<KProcess>& from) {
     this->effectiveGroupId = from->effectiveGroupId;
     this->currentDirectory = from->currentDirectory;
     this->brkEnd = from->brkEnd;
-    for (auto& n : from->fds) {
-        KFileDescriptor* fd = n.second;
-        this->fds[n.first] = this->allocFileDescriptor(fd->kobject, fd->accessFlags, fd->descriptorFlags, n.first, 0);
-        this->fds[n.first]->refCount = fd->refCount;
+    std::vector<KFileDescriptor*> fromFds;
+    from->getFileDescriptors(fromFds);
+    for (auto& fd : fromFds) {
+        KFileDescriptor* result = this->allocFileDescriptor(fd->kobject, fd->accessFlags, fd->descriptorFlags, fd->handle, 0);
+        result->refCount = fd->refCount;
     }
     // :TODO: not thread safe if from has multiple threads
     this->mappedFiles = from->mappedFiles;
@@ -341,6 +351,7 @@ void KProcess::clone(const std::shared_ptr<KProcess>& from) {
     this->phdr = from->phdr;
     this->phnum = from->phnum;
     this->entry = from->entry;
+    this->vdsoAddress = from->vdsoAddress;
 
     for (i=0;i<6;i++) {
         this->hasSetSeg[i] = from->hasSetSeg[i];
@@ -404,6 +415,10 @@ static void pushThreadStack(KThread* thread, CPU* cpu, int argc, U32* a, int env
     cpu->push32(0);		
     
 
+    if (process->vdsoAddress) {
+        cpu->push32(process->vdsoAddress);
+        cpu->push32(33); // AT_SYSINFO_EHDR
+    }
     cpu->push32(randomAddress);
     cpu->push32(25); // AT_RANDOM
     cpu->push32(100);
@@ -478,15 +493,18 @@ static void setupThreadStack(KThread* thread, CPU* cpu, const std::string& progr
     pushThreadStack(thread, cpu, (U32)args.size(), a, (U32)env.size(), e);
 }
 
-U32 KProcess::getNextFileDescriptorHandle(int after) {
+// returns -1 if every handle from after up to MAX_NUMBER_OF_FILES is in use
+S32 KProcess::getNextFileDescriptorHandle(int after) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(fdsMutex);
-    U32 i=after;
+    S32 i=after;
 
-    while (1) {
-		if (!this->fds[i])
-            return i;
+    while (i<MAX_NUMBER_OF_FILES && this->getFileDescriptor(i)) {
         i++;
     }
+    if (i>=MAX_NUMBER_OF_FILES) {
+        return -1;
+    }
+    return i;
 }
 
 KFileDescriptor* KProcess::allocFileDescriptor(const std::shared_ptr<KObject>& kobject, U32 accessFlags, U32 descriptorFlags, S32 handle, U32 afterHandle) {
@@ -495,13 +513,16 @@ KFileDescriptor* KProcess::allocFileDescriptor(const std::shared_ptr<KObject>& k
 
     if (handle<0) {
         handle = this->getNextFileDescriptorHandle(afterHandle);
+        if (handle<0) {
+            return NULL;
+        }
     }
     result = new KFileDescriptor(shared_from_this(), kobject, accessFlags, descriptorFlags, handle);
 
     KFileDescriptor* old = this->getFileDescriptor(handle);
     if (old)
         old->close();  
-    this->fds[handle] = result;
+    this->setFileDescriptor(handle, result);
     return result;
 }
 
@@ -572,6 +593,9 @@ U32 KProcess::openFileDescriptor(const std::string& currentDirectory, std::strin
         kobject = std::make_shared<KFile>(openNode);
     }
     KFileDescriptor* f = this->allocFileDescriptor(kobject, accessFlags, descriptorFlags, handle, afterHandle);
+    if (!f) {
+        return -K_EMFILE;
+    }
     if (result) {
         *result = f;
     }
@@ -680,16 +704,66 @@ U32 KProcess::exit(U32 code) {
     return 0;
 }
 
+KProcess::KFileDescriptorTable::KFileDescriptorTable(U32 size) : size(size), slots(new std::atomic<KFileDescriptor*>[size]) {
+    for (U32 i = 0; i < size; i++) {
+        this->slots[i].store(NULL, std::memory_order_relaxed);
+    }
+}
+
+KProcess::KFileDescriptorTable::~KFileDescriptorTable() {
+    delete[] this->slots;
+}
+
 KFileDescriptor* KProcess::getFileDescriptor(FD handle) {
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(fdsMutex);
-    if (this->fds.count(handle))
-        return this->fds[handle];
+    KFileDescriptorTable* table = this->fds.load(std::memory_order_acquire);
+    if ((U32)handle < table->size) {
+        return table->slots[handle].load(std::memory_order_acquire);
+    }
     return NULL;
 }
 
+// fdsMutex must be held
+void KProcess::setFileDescriptor(U32 handle, KFileDescriptor* fd) {
+    KFileDescriptorTable* table = this->fds.load(std::memory_order_relaxed);
+
+    if (handle >= table->size) {
+        if (!fd) {
+            return;
+        }
+        U32 size = table->size * 2;
+        while (size <= handle) {
+            size *= 2;
+        }
+        KFileDescriptorTable* bigger = new KFileDescriptorTable(size);
+        for (U32 i = 0; i < table->size; i++) {
+            bigger->slots[i].store(table->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        this->retiredFds.push_back(table);
+        table = bigger;
+        this->fds.store(table, std::memory_order_release);
+    }
+    table->slots[handle].store(fd, std::memory_order_release);
+    // a thread that loaded an old table before it was replaced should still see the change
+    for (auto& retired : this->retiredFds) {
+        if (handle < retired->size) {
+            retired->slots[handle].store(fd, std::memory_order_release);
+        }
+    }
+}
+
+void KProcess::getFileDescriptors(std::vector<KFileDescriptor*>& results) {
+    KFileDescriptorTable* table = this->fds.load(std::memory_order_acquire);
+    for (U32 i = 0; i < table->size; i++) {
+        KFileDescriptor* fd = table->slots[i].load(std::memory_order_acquire);
+        if (fd) {
+            results.push_back(fd);
+        }
+    }
+}
+
 void KProcess::clearFdHandle(FD handle) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(fdsMutex);
-    this->fds.erase(handle);
+    this->setFileDescriptor(handle, NULL);
 }
 
 bool KProcess::isStopped() {
@@ -732,12 +806,8 @@ U32 KProcess::alarm(U32 seconds) {
         }
     } else {
         this->timer.resetMillies = 0;
-        if (this->timer.millies!=0) {
-            this->timer.millies = seconds*1000 + KSystem::getMilliesSinceStart();
-        } else {
-            this->timer.millies = seconds*1000 + KSystem::getMilliesSinceStart();
-            addTimer(&this->timer);
-        }
+        this->timer.millies = seconds*1000 + KSystem::getMilliesSinceStart();
+        addTimer(&this->timer); // also moves it if it was already queued
     }
     if (prev) {
         return (prev - KSystem::getMilliesSinceStart())/1000;
@@ -936,7 +1006,11 @@ U32 KProcess::dup(U32 fildes) {
     if (!fd) {
         return -K_EBADF;
     }
-    return this->allocFileDescriptor(fd->kobject, fd->accessFlags, 0, -1, 0)->handle; // do not copy file descriptor flags
+    KFileDescriptor* result = this->allocFileDescriptor(fd->kobject, fd->accessFlags, 0, -1, 0); // do not copy file descriptor flags
+    if (!result) {
+        return -K_EMFILE;
+    }
+    return result->handle;
 }
 
 U32 KProcess::rmdir(const std::string& path) {
@@ -1209,7 +1283,7 @@ U32 KProcess::dup2(FD fildes, FD fildes2) {
     KFileDescriptor* fd = this->getFileDescriptor(fildes);
     KFileDescriptor* fd2;
 
-    if (!fd || fildes2<0) {
+    if (!fd || fildes2<0 || fildes2>=MAX_NUMBER_OF_FILES) {
         return -K_EBADF;
     }
     if (fildes == fildes2) {
@@ -1594,12 +1668,8 @@ U32 KProcess::setitimer(U32 which, U32 newValue, U32 oldValue) {
             }
         } else {
             this->timer.resetMillies = resetMillies;			
-            if (this->timer.millies!=0) {
-                this->timer.millies = millies + KSystem::getMilliesSinceStart();
-            } else {
-                this->timer.millies = millies + KSystem::getMilliesSinceStart();
-                addTimer(&this->timer);
-            }
+            this->timer.millies = millies + KSystem::getMilliesSinceStart();
+            addTimer(&this->timer); // also moves it if it was already queued
         }
     }	
     return 0;
@@ -1990,7 +2060,11 @@ U32 KProcess::memfd_create(const std::string& name, U32 flags) {
     if (!(flags & 2)) { // MFD_ALLOW_SEALING	
         openNode->addSeals(K_F_SEAL_SEAL);
     }
-    return this->allocFileDescriptor(kobject, K_O_RDWR, descriptorFlags, -1, 0)->handle;
+    KFileDescriptor* result = this->allocFileDescriptor(kobject, K_O_RDWR, descriptorFlags, -1, 0);
+    if (!result) {
+        return -K_EMFILE;
+    }
+    return result->handle;
 }
 
 U32 KProcess::mlock(U32 addr, U32 len) {
@@ -2216,11 +2290,23 @@ U32 KProcess::fcntrl(FD fildes, U32 cmd, U32 arg) {
             }
             return 0;
         case K_F_DUPFD: {
+            if (arg >= MAX_NUMBER_OF_FILES) {
+                return -K_EINVAL;
+            }
             KFileDescriptor* result = this->allocFileDescriptor(fd->kobject, fd->accessFlags, fd->descriptorFlags, -1, arg);        
+            if (!result) {
+                return -K_EMFILE;
+            }
             return result->handle;
         }
         case K_F_DUPFD_CLOEXEC: {
+            if (arg >= MAX_NUMBER_OF_FILES) {
+                return -K_EINVAL;
+            }
             KFileDescriptor* result = this->allocFileDescriptor(fd->kobject, fd->accessFlags, fd->descriptorFlags, -1, arg);
+            if (!result) {
+                return -K_EMFILE;
+            }
             result->descriptorFlags=FD_CLOEXEC;
             return result->handle;
         }
@@ -2339,6 +2425,9 @@ U32 KProcess::set_thread_area(U32 info) {
 U32 KProcess::epollcreate(U32 size, U32 flags) {
     std::shared_ptr<KObject> o = std::make_shared<KEPoll>();
     KFileDescriptor* result = this->allocFileDescriptor(o, K_O_RDWR, flags, -1, 0);
+    if (!result) {
+        return -K_EMFILE;
+    }
     return result->handle;
 }
 
@@ -2677,8 +2766,9 @@ U32 KProcess::signal(U32 signal) {
 }
 
 void KProcess::signalFd(KThread* thread, U32 signal) {
-    for (auto& n : this->fds) {
-        KFileDescriptor* fd = n.second;
+    std::vector<KFileDescriptor*> fds;
+    this->getFileDescriptors(fds);
+    for (auto& fd : fds) {
         if (fd->kobject->type == KTYPE_SIGNAL) {
             std::shared_ptr<KSignal> p = std::dynamic_pointer_cast<KSignal>(fd->kobject);
             if ((p->mask & signal) && (!thread || thread->waitingCond == &p->lockCond)) {
@@ -2699,6 +2789,7 @@ void KProcess::printMappedFiles() {
         const BoxedPtr<MappedFile>& mappedFile = n.second;
         klog("    %.8X - %.8X %s\n", mappedFile->address, mappedFile->address+(int)mappedFile->len, mappedFile->file->openFile->node->path.c_str());
     }
+    klog("    %d file faults, %d pages populated, %lld bytes read\n", this->mmapFaults, this->mmapPagesPopulated, this->mmapBytesRead);
 }
 
 #ifdef BOXEDWINE_64BIT_MMU
@@ -16,57 +16,135 @@
  *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 #include "boxedwine.h"
-
-#ifdef BOXEDWINE_MULTI_THREADED
-static KList<KTimer*> timers;
+#include "kvdso.h"
+
+// Timers are kept in a binary min-heap ordered by millies, each timer remembers where it is in the heap so
+// that removing one doesn't need to search for it.  The next timer to fire is always timers[0].
+static std::vector<KTimer*> timers;
+// timers that are due are taken out of the heap before any of them run, since run() can add or remove
+// any timer, including itself
+static std::vector<KTimer*> dueTimers;
 static BOXEDWINE_MUTEX timerMutex;
+
+static void setTimerAt(U32 index, KTimer* timer) {
+    timers[index] = timer;
+    timer->heapIndex = index;
+}
+
+static void siftTimerUp(U32 index) {
+    KTimer* timer = timers[index];
+    while (index) {
+        U32 parent = (index - 1) / 2;
+        if (timers[parent]->millies <= timer->millies) {
+            break;
+        }
+        setTimerAt(index, timers[parent]);
+        index = parent;
+    }
+    setTimerAt(index, timer);
+}
+
+static void siftTimerDown(U32 index) {
+    KTimer* timer = timers[index];
+    U32 count = (U32)timers.size();
+    while (true) {
+        U32 child = index * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && timers[child + 1]->millies < timers[child]->millies) {
+            child++;
+        }
+        if (timer->millies <= timers[child]->millies) {
+            break;
+        }
+        setTimerAt(index, timers[child]);
+        index = child;
+    }
+    setTimerAt(index, timer);
+}
+
+static void removeTimerAt(U32 index) {
+    KTimer* last = timers.back();
+    timers.pop_back();
+    if (index < timers.size()) {
+        setTimerAt(index, last);
+        siftTimerDown(index);
+        siftTimerUp(last->heapIndex);
+    }
+}
+
 void runTimers() {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
     U32 millies = KSystem::getMilliesSinceStart();
-    timers.for_each([millies](KListNode<KTimer*>* node) {
-        KTimer* timer = node->data;
-
-        if (timer->millies <= millies) {
-            if (timer->run()) {
-                timer->node.remove();
-            }
+    while (timers.size() && timers[0]->millies <= millies) {
+        KTimer* timer = timers[0];
+        removeTimerAt(0);
+        timer->heapIndex = K_TIMER_RUNNING;
+        dueTimers.push_back(timer);
+    }
+    // removeTimer sets the entry to NULL if a timer that hasn't run yet is removed or deleted
+    for (U32 i = 0; i < dueTimers.size(); i++) {
+        KTimer* timer = dueTimers[i];
+        if (!timer) {
+            continue;
+        }
+        if (timer->run()) {
+            removeTimer(timer);
+        } else if (timer->heapIndex == K_TIMER_RUNNING) {
+            dueTimers[i] = NULL;
+            timer->heapIndex = K_TIMER_NOT_QUEUED;
+            addTimer(timer);
         }
-        });
+    }
+    dueTimers.clear();
 }
 
 U32 getNextTimer() {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
+    if (timers.empty()) {
+        return 0xFFFFFFFF;
+    }
     U32 millies = KSystem::getMilliesSinceStart();
-    U32 result = 0xFFFFFFFF;
-
-    timers.for_each([millies, &result](KListNode<KTimer*>* node) {
-        KTimer* timer = node->data;
-        U32 next;
-        if (timer->millies <= millies) {
-            next = 0;
-        }
-        else {
-            next = timer->millies - millies;
-        }
-        if (next < result) {
-            result = next;
-        }
-        });
-    return result;
+    U32 next = timers[0]->millies;
+    if (next <= millies) {
+        return 0;
+    }
+    return next - millies;
 }
 
+// if the timer is already queued it is moved to where its current millies belongs
 void addTimer(KTimer* timer) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
-    timers.addToBack(&timer->node);
+    if (timer->heapIndex < timers.size()) {
+        siftTimerDown(timer->heapIndex);
+        siftTimerUp(timer->heapIndex);
+    } else {
+        if (timer->heapIndex == K_TIMER_RUNNING) {
+            removeTimer(timer);
+        }
+        timers.push_back(timer);
+        siftTimerUp((U32)timers.size() - 1);
+    }
     timer->active = true;
 }
 
 void removeTimer(KTimer* timer) {
     BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(timerMutex);
-    timer->node.remove();
+    if (timer->heapIndex < timers.size()) {
+        removeTimerAt(timer->heapIndex);
+    } else if (timer->heapIndex == K_TIMER_RUNNING) {
+        for (auto& due : dueTimers) {
+            if (due == timer) {
+                due = NULL;
+            }
+        }
+    }
+    timer->heapIndex = K_TIMER_NOT_QUEUED;
     timer->active = false;
 }
-#else
+
+#ifndef BOXEDWINE_MULTI_THREADED
 #include "devfb.h"
 #include "kscheduler.h"
 #include "knativewindow.h"
@@ -77,18 +155,6 @@ void removeTimer(KTimer* timer) {
 
 KList<KThread*> scheduledThreads;
 KList<KThread*> waitThreads;
-KList<KTimer*> timers;
-
-void addTimer(KTimer* timer) {
-    timers.addToBack(&timer->node);
-    timer->active = true;
-}
-
-void removeTimer(KTimer* timer) {
-    timer->node.remove();
-    timer->active = false;
-}
-
 void scheduleThread(KThread* thread) {
 #ifdef _DEBUG
     if (thread->waitingCond) {
@@ -148,19 +214,6 @@ void runThreadSlice(KThread* thread) {
     cpu->instructionCount+=cpu->blockInstructionCount;
 }
 
-void runTimers() {
-    U32 millies = KSystem::getMilliesSinceStart();
-    timers.for_each([millies] (KListNode<KTimer*>* node) {
-        KTimer* timer = node->data;
-
-        if (timer->millies<=millies) {
-            if (timer->run()) {                
-                timer->node.remove();
-            }
-        }
-    });
-}
-
 extern U64 sysCallTime;
 U64 elapsedTimeMIPS;
 U64 elapsedInstructionsMIPS;
@@ -189,6 +242,9 @@ bool runSlice() {
         ChangeThread c(currentThread);
         static U64 rdtsc;
         currentThread->cpu->instructionCount = rdtsc;
+#ifdef BOXEDWINE_VDSO
+        KVdso::updateTime(rdtsc, threadStartTime);
+#endif
         platformRunThreadSlice(currentThread);
         rdtsc = currentThread->cpu->instructionCount;
 
@@ -30,6 +30,7 @@
 
 bool KSystem::modesInitialized = false;
 U32 KSystem::skipFrameFPS = 0;
+U32 KSystem::faultAroundPages = 256;
 bool KSystem::videoEnabled = true;
 #ifdef BOXEDWINE_OPENGL_SDL
 U32 KSystem::openglType = OPENGL_TYPE_SDL;
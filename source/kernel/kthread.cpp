@@ -30,13 +30,28 @@ THREAD_LOCAL
 #endif
 KThread* KThread::runningThread;
 
-BOXEDWINE_MUTEX KThread::futexesMutex;
+// A thread can only wait on one futex at a time, so each thread owns a single waiter that gets
+// queued on the hash bucket for the host address it is waiting on.
+class KFutexWaiter {
+public:
+    KFutexWaiter(KThread* thread) : thread(thread), address(NULL), waitAddress(NULL), expireTimeInMillies(0), mask(0), wake(false), active(false), node(this), cond("futex") {}
+    KThread* thread;
+    U8* address; // can change while queued because of FUTEX_REQUEUE
+    U8* waitAddress; // the address passed to FUTEX_WAIT, used to resume the wait in the single threaded build
+    U32 expireTimeInMillies;
+    U32 mask;
+    bool wake;
+    bool active;
+    KListNode<KFutexWaiter*> node;
+    BOXEDWINE_CONDITION cond;
+};
 
 KThread::~KThread() {    
     this->cleanup();
     CPU* cpu = this->cpu;
     this->cpu = NULL;
     delete cpu;
+    delete this->futexWaiter;
 }
 
 void KThread::cleanup() {
@@ -125,7 +140,8 @@ KThread::KThread(U32 id, const std::shared_ptr<KProcess>& process) :
     waitThreadNode(this),            
 #endif
     condStartWaitTime(0),
-    sleepCond("KThread::sleepCond")
+    sleepCond("KThread::sleepCond"),
+    futexWaiter(NULL)
     {
     int i;
 
@@ -230,69 +246,142 @@ U32 KThread::signal(U32 signal, bool wait) {
 
 #define FUTEX_WAIT 0
 #define FUTEX_WAKE 1
-#define FUTEX_WAIT_PRIVATE 128
-#define FUTEX_WAKE_PRIVATE 129
-#define FUTEX_WAIT_BITSET_PRIVATE 137
-#define FUTEX_WAKE_BITSET_PRIVATE 138
+#define FUTEX_REQUEUE 3
+#define FUTEX_CMP_REQUEUE 4
+#define FUTEX_WAKE_OP 5
+#define FUTEX_WAIT_BITSET 9
+#define FUTEX_WAKE_BITSET 10
+#define FUTEX_PRIVATE_FLAG 128
 #define FUTEX_CLOCK_REALTIME 256
-
-struct futex {
+#define FUTEX_CMD_MASK ~(FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME)
+
+#define FUTEX_BITSET_MATCH_ANY 0xFFFFFFFF
+
+#define FUTEX_OP_SET 0
+#define FUTEX_OP_ADD 1
+#define FUTEX_OP_OR 2
+#define FUTEX_OP_ANDN 3
+#define FUTEX_OP_XOR 4
+#define FUTEX_OP_OPARG_SHIFT 8
+
+#define FUTEX_OP_CMP_EQ 0
+#define FUTEX_OP_CMP_NE 1
+#define FUTEX_OP_CMP_LT 2
+#define FUTEX_OP_CMP_LE 3
+#define FUTEX_OP_CMP_GT 4
+#define FUTEX_OP_CMP_GE 5
+
+// Waiters are kept in FIFO order per bucket.  Lock order is bucket mutex then waiter cond, when
+// two buckets are needed the one with the lower index is locked first.
+class KFutexBucket {
 public:
-    futex() : cond("futex") {}
-    KThread* thread;
-    U8* address;  
-    U32 expireTimeInMillies;
-    U32 mask;
-    bool wake;
-    BOXEDWINE_CONDITION cond;
+    BOXEDWINE_MUTEX mutex;
+    KList<KFutexWaiter*> waiters;
 };
 
-#define MAX_FUTEXES 128
+#define FUTEX_HASH_BITS 8
+#define FUTEX_HASH_SIZE (1 << FUTEX_HASH_BITS)
+
+static KFutexBucket futexBuckets[FUTEX_HASH_SIZE];
+
+static KFutexBucket* getFutexBucket(U8* address) {
+    U64 key = ((U64)(uintptr_t)address) >> 2;
+    return &futexBuckets[(key * 0x9E3779B97F4A7C15ull) >> (64 - FUTEX_HASH_BITS)];
+}
+
+static void lockFutexBuckets(KFutexBucket* bucket1, KFutexBucket* bucket2) {
+    if (bucket1 == bucket2) {
+        BOXEDWINE_MUTEX_LOCK(bucket1->mutex);
+    } else if (bucket1 < bucket2) {
+        BOXEDWINE_MUTEX_LOCK(bucket1->mutex);
+        BOXEDWINE_MUTEX_LOCK(bucket2->mutex);
+    } else {
+        BOXEDWINE_MUTEX_LOCK(bucket2->mutex);
+        BOXEDWINE_MUTEX_LOCK(bucket1->mutex);
+    }
+}
 
-struct futex system_futex[MAX_FUTEXES];
+static void unlockFutexBuckets(KFutexBucket* bucket1, KFutexBucket* bucket2) {
+    BOXEDWINE_MUTEX_UNLOCK(bucket1->mutex);
+    if (bucket1 != bucket2) {
+        BOXEDWINE_MUTEX_UNLOCK(bucket2->mutex);
+    }
+}
 
-struct futex* getFutex(KThread* thread, U8* address) {
-    int i=0;
+// caller must hold bucket->mutex
+static U32 wakeFutexWaiters(KFutexBucket* bucket, U8* address, U32 count, U32 mask) {
+    U32 result = 0;
+    KListNode<KFutexWaiter*>* node = bucket->waiters.front();
 
-    for (i=0;i<MAX_FUTEXES;i++) {
-        if (system_futex[i].address == address && system_futex[i].thread==thread) {
-            return &system_futex[i];
+    while (node && result < count) {
+        KListNode<KFutexWaiter*>* next = node->getNext();
+        KFutexWaiter* f = node->data;
+        if (f->address == address && (f->mask & mask)) {
+            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(f->cond);
+            f->wake = true;
+            // once it is removed from the bucket, the waiter knows it was woken up
+            node->remove();
+            BOXEDWINE_CONDITION_SIGNAL(f->cond);
+            result++;
         }
+        node = next;
     }
-    return 0;
+    return result;
 }
 
-struct futex* allocFutex(KThread* thread, U8* address, U32 millies) {
-    BOXEDWINE_CRITICAL_SECTION;
-    int i=0;
-
-    for (i=0;i<MAX_FUTEXES;i++) {
-        if (system_futex[i].thread==0) {
-            system_futex[i].thread = thread;
-            system_futex[i].address = address;
-            system_futex[i].expireTimeInMillies = millies;
-            system_futex[i].wake = false;
-            system_futex[i].mask = 0;
-            return &system_futex[i];
+static U32 futexWake(U8* address, U32 count, U32 mask) {
+    KFutexBucket* bucket = getFutexBucket(address);
+    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(bucket->mutex);
+    return wakeFutexWaiters(bucket, address, count, mask);
+}
+
+// returns false if the waiter was already removed from its bucket by a wake
+static bool unqueueFutex(KFutexWaiter* f) {
+    while (true) {
+        U8* address = f->address;
+        KFutexBucket* bucket = getFutexBucket(address);
+        BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(bucket->mutex);
+        if (address != f->address) {
+            // requeued to another address while we were waiting for the lock
+            continue;
         }
+        if (!f->node.isInList()) {
+            return false;
+        }
+        f->node.remove();
+        return true;
     }
-    kpanic("ran out of futexes");
-    return 0;
 }
 
-void freeFutex(struct futex* f) {
-    f->thread = 0;
-    f->address = 0;
+static bool futexCompare(S32 oldValue, U32 cmp, S32 cmpArg) {
+    switch (cmp) {
+    case FUTEX_OP_CMP_EQ: return oldValue == cmpArg;
+    case FUTEX_OP_CMP_NE: return oldValue != cmpArg;
+    case FUTEX_OP_CMP_LT: return oldValue < cmpArg;
+    case FUTEX_OP_CMP_LE: return oldValue <= cmpArg;
+    case FUTEX_OP_CMP_GT: return oldValue > cmpArg;
+    case FUTEX_OP_CMP_GE: return oldValue >= cmpArg;
+    }
+    return false;
+}
+
+static U32 futexOp(U32 oldValue, U32 op, U32 opArg) {
+    switch (op) {
+    case FUTEX_OP_SET: return opArg;
+    case FUTEX_OP_ADD: return oldValue + opArg;
+    case FUTEX_OP_OR: return oldValue | opArg;
+    case FUTEX_OP_ANDN: return oldValue & ~opArg;
+    case FUTEX_OP_XOR: return oldValue ^ opArg;
+    }
+    return oldValue;
 }
 
 void KThread::clearFutexes() {
-    U32 i;
+    KFutexWaiter* f = this->futexWaiter;
 
-    BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(KThread::futexesMutex);
-    for (i=0;i<MAX_FUTEXES;i++) {
-        if (system_futex[i].thread == this) {
-            freeFutex(&system_futex[i]);
-        }
+    if (f && f->active) {
+        unqueueFutex(f);
+        f->active = false;
     }
 }
 
@@ -302,81 +391,174 @@ U32 KThread::futex(U32 addr, U32 op, U32 value, U32 pTime, U32 val2, U32 val3) {
     if (ramAddress==0) {
         kpanic("Could not find futex address: %0.8X", addr);
     }
-    op = op & ~FUTEX_CLOCK_REALTIME;
-    if (op==FUTEX_WAIT || op==FUTEX_WAIT_PRIVATE || op == FUTEX_WAIT_BITSET_PRIVATE) {
-        struct futex* f=getFutex(this, ramAddress);
-        U32 expireTime;
-
-        if (pTime == 0) {
-            expireTime = 0xFFFFFFFF;
-        } else {
-            U32 seconds = readd(pTime);
-            U32 nano = readd(pTime + 4);
-            expireTime = seconds * 1000 + nano / 1000000 + KSystem::getMilliesSinceStart();
+    U32 cmd = op & FUTEX_CMD_MASK;
+    if (cmd==FUTEX_WAIT || cmd==FUTEX_WAIT_BITSET) {
+        if (cmd == FUTEX_WAIT_BITSET && !val3) {
+            return -K_EINVAL;
+        }
+        if (!this->futexWaiter) {
+            this->futexWaiter = new KFutexWaiter(this);
         }
-        bool checkValue = false;
+        KFutexWaiter* f = this->futexWaiter;
 
-        if (!f) {
-            checkValue = true;
-            f = allocFutex(this, ramAddress, expireTime);
-            if (op == FUTEX_WAIT_BITSET_PRIVATE) {
-                f->mask = val3;
+        // in the single threaded build a blocked wait returns -K_WAIT and the syscall is run again when the thread is woken up
+        if (!f->active || f->waitAddress != ramAddress) {
+            if (f->active) {
+                unqueueFutex(f);
+                f->active = false;
             }
+            U32 expireTime;
+
+            if (pTime == 0) {
+                expireTime = 0xFFFFFFFF;
+            } else {
+                U32 seconds = readd(pTime);
+                U32 nano = readd(pTime + 4);
+                expireTime = seconds * 1000 + nano / 1000000 + KSystem::getMilliesSinceStart();
+            }
+            KFutexBucket* bucket = getFutexBucket(ramAddress);
+            BOXEDWINE_CRITICAL_SECTION_WITH_MUTEX(bucket->mutex);
+            // checking the value while holding the bucket lock guarantees a wake can't be missed
+            if (readd(addr) != value) {
+                return -K_EWOULDBLOCK;
+            }
+            f->address = ramAddress;
+            f->waitAddress = ramAddress;
+            f->expireTimeInMillies = expireTime;
+            f->mask = (cmd == FUTEX_WAIT_BITSET) ? val3 : FUTEX_BITSET_MATCH_ANY;
+            f->wake = false;
+            f->active = true;
+            bucket->waiters.addToBack(&f->node);
         }
         while (true) {
-            BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(f->cond);
-            if (checkValue) {
-                checkValue = false;
-                if (readd(addr) != value) { // needs to be protected
-                    freeFutex(f);
-                    return -K_EWOULDBLOCK;
-                } 
-            }
-            if (this->pendingSignals) {
-                // I know this is a nested if statement, but it makes setting a break point easier
-                if (runSignals()) {
-                    return -K_CONTINUE;
+            U32 result = 0;
+            {
+                BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(f->cond);
+                if (f->wake) {
+                    f->active = false;
+                    return 0;
+                }
+                if (this->pendingSignals && runSignals()) {
+                    result = -K_CONTINUE;
+                } else if (f->expireTimeInMillies<0x7FFFFFFF) {
+                    S32 diff = f->expireTimeInMillies - KSystem::getMilliesSinceStart();
+                    if (diff<=0) {
+                        result = -K_ETIMEDOUT;
+                    } else {
+                        BOXEDWINE_CONDITION_WAIT_TIMEOUT(f->cond, (U32)diff);
+                    }
+                } else {
+                    BOXEDWINE_CONDITION_WAIT(f->cond);
                 }
+#ifdef BOXEDWINE_MULTI_THREADED
+                if (!result) {
+                    if (this->terminating) {
+                        result = -K_EINTR;
+                    } else if (KThread::currentThread()->startSignal) {
+                        KThread::currentThread()->startSignal = false;
+                        result = -K_CONTINUE;
+                    }
+                }
+#endif
             }
-            if (f->wake) {
-                freeFutex(f);
-                return 0;
-            }            
-            if (f->expireTimeInMillies<0x7FFFFFFF) {
-                S32 diff = f->expireTimeInMillies - KSystem::getMilliesSinceStart();
-                if (diff<=0) {
-                    freeFutex(f);
-                    return -K_ETIMEDOUT;
+            if (result) {
+                // the bucket lock can't be taken while holding f->cond
+                if (!unqueueFutex(f)) {
+                    // a wake raced with us leaving
+                    if (result == (U32)-K_CONTINUE) {
+                        // the signal handler is already set up so pass the wake on instead of losing it
+                        futexWake(f->address, 1, FUTEX_BITSET_MATCH_ANY);
+                    } else {
+                        result = 0;
+                    }
                 }
-                BOXEDWINE_CONDITION_WAIT_TIMEOUT(f->cond, (U32)diff);
-            } else {
-                BOXEDWINE_CONDITION_WAIT(f->cond);
+                f->active = false;
+                return result;
             }
-#ifdef BOXEDWINE_MULTI_THREADED
-			if (this->terminating) {
-				return -K_EINTR;
-			}
-            if (KThread::currentThread()->startSignal) {
-                KThread::currentThread()->startSignal = false;
-                return -K_CONTINUE;
+        }
+    } else if (cmd==FUTEX_WAKE || cmd==FUTEX_WAKE_BITSET) {
+        if (cmd == FUTEX_WAKE_BITSET && !val3) {
+            return -K_EINVAL;
+        }
+        return futexWake(ramAddress, value, (cmd == FUTEX_WAKE_BITSET) ? val3 : FUTEX_BITSET_MATCH_ANY);
+    } else if (cmd==FUTEX_REQUEUE || cmd==FUTEX_CMP_REQUEUE) {
+        // pTime is used as the requeue count for these ops
+        U8* ramAddress2 = getPhysicalReadAddress(val2, 4);
+        if (!ramAddress2) {
+            return -K_EFAULT;
+        }
+        KFutexBucket* bucket1 = getFutexBucket(ramAddress);
+        KFutexBucket* bucket2 = getFutexBucket(ramAddress2);
+        U32 result = 0;
+
+        lockFutexBuckets(bucket1, bucket2);
+        if (cmd == FUTEX_CMP_REQUEUE && readd(addr) != val3) {
+            unlockFutexBuckets(bucket1, bucket2);
+            return -K_EAGAIN;
+        }
+        result = wakeFutexWaiters(bucket1, ramAddress, value, FUTEX_BITSET_MATCH_ANY);
+
+        U32 requeued = 0;
+        KListNode<KFutexWaiter*>* node = bucket1->waiters.front();
+        while (node && requeued < pTime) {
+            KListNode<KFutexWaiter*>* next = node->getNext();
+            KFutexWaiter* f = node->data;
+            if (f->address == ramAddress) {
+                f->address = ramAddress2;
+                if (bucket1 != bucket2) {
+                    node->remove();
+                    bucket2->waiters.addToBack(node);
+                }
+                requeued++;
             }
-#endif
+            node = next;
+        }
+        unlockFutexBuckets(bucket1, bucket2);
+        return result + requeued;
+    } else if (cmd==FUTEX_WAKE_OP) {
+        // pTime is used as the second wake count for this op
+        U8* ramAddress2 = getPhysicalWriteAddress(val2, 4);
+        if (!ramAddress2) {
+            return -K_EFAULT;
         }
-    } else if (op==FUTEX_WAKE_PRIVATE || op==FUTEX_WAKE || op==FUTEX_WAKE_BITSET_PRIVATE) {
-        int i;
-        U32 count = 0;
-        for (i=0;i<MAX_FUTEXES && count<value;i++) {
-            if (system_futex[i].address==ramAddress && !system_futex[i].wake && (op!= FUTEX_WAKE_BITSET_PRIVATE || (system_futex[i].mask & val3))) {
-                BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(system_futex[i].cond);
-                system_futex[i].wake = true;
-                BOXEDWINE_CONDITION_SIGNAL(system_futex[i].cond);
-                count++;
+        U32 wakeOp = (val3 >> 28) & 0xf;
+        U32 cmp = (val3 >> 24) & 0xf;
+        U32 opArg = (U32)(((S32)(val3 << 8)) >> 20);
+        S32 cmpArg = ((S32)(val3 << 20)) >> 20;
+
+        if (wakeOp & FUTEX_OP_OPARG_SHIFT) {
+            wakeOp &= ~FUTEX_OP_OPARG_SHIFT;
+            if (opArg > 31) {
+                return -K_EINVAL;
             }
+            opArg = 1 << opArg;
+        }
+        if (wakeOp > FUTEX_OP_XOR || cmp > FUTEX_OP_CMP_GE) {
+            return -K_ENOSYS;
+        }
+        KFutexBucket* bucket1 = getFutexBucket(ramAddress);
+        KFutexBucket* bucket2 = getFutexBucket(ramAddress2);
+
+        lockFutexBuckets(bucket1, bucket2);
+#ifdef BOXEDWINE_MULTI_THREADED
+        // other guest threads can access this address with atomic instructions without going through the kernel
+        std::atomic<U32>* p = (std::atomic<U32>*)ramAddress2;
+        U32 oldValue = p->load();
+        while (!p->compare_exchange_weak(oldValue, futexOp(oldValue, wakeOp, opArg))) {
         }
-        return count;
+#else
+        U32 oldValue = *(U32*)ramAddress2;
+        *(U32*)ramAddress2 = futexOp(oldValue, wakeOp, opArg);
+#endif
+        U32 result = wakeFutexWaiters(bucket1, ramAddress, value, FUTEX_BITSET_MATCH_ANY);
+        if (futexCompare((S32)oldValue, cmp, cmpArg)) {
+            result += wakeFutexWaiters(bucket2, ramAddress2, pTime, FUTEX_BITSET_MATCH_ANY);
+        }
+        unlockFutexBuckets(bucket1, bucket2);
+        return result;
     } else {
         kwarn("syscall __NR_futex op %d not implemented", op);
-        return -1;
+        return -K_ENOSYS;
     }
 }
 
@@ -23,6 +23,7 @@ KUnixSocketObject::~KUnixSocketObject() {
             con->inClosed = true;
             con->outClosed = true;
             BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
+            con->notifyEPoll();
         }
     }        
     
@@ -46,6 +47,7 @@ KUnixSocketObject::~KUnixSocketObject() {
         if (s) {
             s->connecting.reset();
             BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(s->lockCond);
+            s->notifyEPoll();
         }
     }    
     BOXEDWINE_CONDITION_SIGNAL_ALL(this->lockCond);
@@ -85,13 +87,17 @@ bool KUnixSocketObject::isOpen() {
 
 bool KUnixSocketObject::isReadReady() {
     //BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->lockCond);
-    return this->inClosed || this->recvBuffer.size() || this->pendingConnections.size() || this->msgs.size();
+    return this->inClosed || !this->recvBuffer.isEmpty() || this->pendingConnections.size() || this->msgs.size();
 }
 
 bool KUnixSocketObject::isWriteReady() {
     return !this->connection.expired();
 }
 
+bool KUnixSocketObject::supportsEPollNotify() {
+    return true;
+}
+
 void KUnixSocketObject::waitForEvents(BOXEDWINE_CONDITION& parentCondition, U32 events) {
     bool addedLock = false;
 
@@ -132,21 +138,11 @@ U32 KUnixSocketObject::internal_write(const std::shared_ptr<KUnixSocketObject>&
     
     //printf("internal_write: %0.8X size=%d capacity=%d writeLen=%d", (int)&this->connection->recvBuffer, (int)this->connection->recvBuffer.size(), (int)this->connection->recvBuffer.capacity(), len);
 
-    while (len) {
-        S8 tmp[4096];
-        U32 todo = len;
-
-        if (todo>4096)
-            todo = 4096;
-        if (!KThread::currentThread()->memory->isValidReadAddress(buffer, todo)) {
-            kwarn("KUnixSocketObject::internal_write about to crash reading buffer to buffer");
-        }
-        memcopyToNative(buffer, tmp, todo);
-        con->recvBuffer.insert(con->recvBuffer.end(), tmp, tmp + todo);
-        buffer+=todo;
-        len-=todo;
-        count+=todo;
-    }     
+    if (!KThread::currentThread()->memory->isValidReadAddress(buffer, len)) {
+        kwarn("KUnixSocketObject::internal_write about to crash reading buffer to buffer");
+    }
+    con->recvBuffer.writeFromMemory(buffer, len);
+    count = len;
     return count;
 }
 
@@ -174,6 +170,7 @@ U32 KUnixSocketObject::writev(U32 iov, S32 iovcnt) {
     }    
     if (con) {
         BOXEDWINE_CONDITION_SIGNAL_ALL(cond);
+        con->notifyEPoll();
     }
     return len;
 }
@@ -185,6 +182,7 @@ U32 KUnixSocketObject::write(U32 buffer, U32 len) {
     U32 result = this->internal_write(con, cond, buffer, len);    
     if (con) {
         BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
+        con->notifyEPoll();
     }
     return result;
 }
@@ -201,8 +199,9 @@ U32 KUnixSocketObject::writeNative(U8* buffer, U32 len) {
         return -K_EPIPE;
 
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(con->lockCond); 
-    con->recvBuffer.insert(con->recvBuffer.end(), buffer, buffer + len);
+    con->recvBuffer.write(buffer, len);
     BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
+    con->notifyEPoll();
     return len;
 }
 
@@ -220,8 +219,9 @@ U32 KUnixSocketObject::unixsocket_write_native_nowait(const std::shared_ptr<KObj
 
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(con->lockCond);
     //printf("SOCKET write len=%d bufferSize=%d pos=%d\n", len, s->connection->recvBufferLen, s->connection->recvBufferWritePos);
-    con->recvBuffer.insert(con->recvBuffer.end(), value, value + len);
+    con->recvBuffer.write(value, len);
     BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
+    con->notifyEPoll();
 
     return len;
 }
@@ -232,7 +232,7 @@ U32 KUnixSocketObject::readNative(U8* buffer, U32 len) {
         return -K_EPIPE;
     con = nullptr; // don't hold a strong reference to this, if we are blocking then it would prevent the con object from being destroyed when its process is closed
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->lockCond);
-    while (this->recvBuffer.size()==0) {
+    while (this->recvBuffer.isEmpty()) {
         if (this->inClosed) {
             return 0;
         }
@@ -251,11 +251,7 @@ U32 KUnixSocketObject::readNative(U8* buffer, U32 len) {
 #endif
     }
     //printf("readNative: %0.8X size=%d capacity=%d writeLen=%d", (int)&this->recvBuffer, (int)this->recvBuffer.size(), (int)this->recvBuffer.capacity(), len);
-    if (len > this->recvBuffer.size()) {
-        len = (U32)this->recvBuffer.size();
-    }
-    std::copy(this->recvBuffer.begin(), this->recvBuffer.begin() + len, buffer);
-    this->recvBuffer.erase(this->recvBuffer.begin(), this->recvBuffer.begin() + len);
+    len = this->recvBuffer.read(buffer, len);
     if (con) {
         BOXEDWINE_CONDITION_SIGNAL_ALL(this->lockCond);
     }
@@ -270,7 +266,7 @@ U32 KUnixSocketObject::read(U32 buffer, U32 len) {
         return -K_EPIPE;
     con = nullptr; // don't hold a strong reference to this, if we are blocking then it would prevent the con object from being destroyed when its process is closed
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->lockCond);
-    while (this->recvBuffer.size()==0) {
+    while (this->recvBuffer.isEmpty()) {
         if (this->inClosed) {
             return 0;
         }
@@ -288,28 +284,14 @@ U32 KUnixSocketObject::read(U32 buffer, U32 len) {
         }
 #endif
     }
-    // :TODO: remove extra copy
-    while (len && this->recvBuffer.size()!=0) {
-        S8 tmp[4096];
-        U32 todo = len;
-
-        if (todo > 4096)
-            todo = 4096;
-        if (todo > this->recvBuffer.size())
-            todo = (U32)this->recvBuffer.size();
-
-        std::copy(this->recvBuffer.begin(), this->recvBuffer.begin() + todo, tmp);
-        this->recvBuffer.erase(this->recvBuffer.begin(), this->recvBuffer.begin() + todo);
-
-        if (!KThread::currentThread()->memory->isValidWriteAddress(buffer, todo)) {
-            kwarn("KUnixSocketObject::read about to crash writing to buffer");
-        }
-        memcopyFromNative(buffer, tmp, todo);
-
-        buffer += todo;
-        count += todo;
-        len -= todo;
-    }      
+    U32 todo = len;
+    if (todo > this->recvBuffer.size()) {
+        todo = this->recvBuffer.size();
+    }
+    if (!KThread::currentThread()->memory->isValidWriteAddress(buffer, todo)) {
+        kwarn("KUnixSocketObject::read about to crash writing to buffer");
+    }
+    count = this->recvBuffer.readToMemory(buffer, todo);
     if (con) {
         BOXEDWINE_CONDITION_SIGNAL_ALL(this->lockCond);
     }
@@ -459,6 +441,7 @@ U32 KUnixSocketObject::connect(KFileDescriptor* fd, U32 address, U32 len) {
                 std::shared_ptr< KUnixSocketObject> t = std::dynamic_pointer_cast<KUnixSocketObject>(shared_from_this());
                 destination->pendingConnections.push_back(t);
                 BOXEDWINE_CONDITION_SIGNAL_ALL(destination->lockCond);
+                destination->notifyEPoll();
                 BOXEDWINE_CONDITION_UNLOCK(destination->lockCond);
 
                 if (!this->blocking) {
@@ -525,14 +508,20 @@ U32 KUnixSocketObject::accept(KFileDescriptor* fd, U32 address, U32 len, U32 fla
 #endif
     }
     
+    // allocate the handle first so that the connection stays queued if there isn't one
+    std::shared_ptr<KUnixSocketObject> resultSocket = std::make_shared<KUnixSocketObject>(this->pid, domain, type, protocol);
+    KFileDescriptor* result = KThread::currentThread()->process->allocFileDescriptor(resultSocket, K_O_RDWR, 0, -1, 0);
+    if (!result) {
+        BOXEDWINE_CONDITION_UNLOCK(this->lockCond);
+        return -K_EMFILE;
+    }
+
     std::shared_ptr<KUnixSocketObject> pendingConnection = this->pendingConnections.front().lock();
     this->pendingConnections.pop_front();
 
     BOXEDWINE_CONDITION_UNLOCK(this->lockCond);
 
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(pendingConnection->lockCond);
-    std::shared_ptr<KUnixSocketObject> resultSocket = std::make_shared<KUnixSocketObject>(this->pid, domain, type, protocol);
-    KFileDescriptor* result = KThread::currentThread()->process->allocFileDescriptor(resultSocket, K_O_RDWR, 0, -1, 0);
 
     if (flags & FD_CLOEXEC) {
         result->descriptorFlags|=FD_CLOEXEC;
@@ -548,6 +537,7 @@ U32 KUnixSocketObject::accept(KFileDescriptor* fd, U32 address, U32 len, U32 fla
     resultSocket->connection = pendingConnection; // weak reference
     
     BOXEDWINE_CONDITION_SIGNAL_ALL(pendingConnection->lockCond);
+    pendingConnection->notifyEPoll();
 
     return result->handle;
 }
@@ -602,18 +592,22 @@ U32 KUnixSocketObject::shutdown(KFileDescriptor* fd, U32 how) {
         this->inClosed=true;
         con->outClosed=true;
         BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(con->lockCond);
+        con->notifyEPoll();
     } else if (how == K_SHUT_WR) {
         this->outClosed=true;
         con->inClosed=true;
         BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(con->lockCond);
+        con->notifyEPoll();
     } else if (how == K_SHUT_RDWR) {
         this->outClosed=true;
         this->inClosed=true;
         con->outClosed=true;
         con->inClosed=true;
         BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(con->lockCond);
+        con->notifyEPoll();
     }
     BOXEDWINE_CONDITION_SIGNAL_ALL_NEED_LOCK(this->lockCond);
+    this->notifyEPoll();
     return 0;
 }
 
@@ -744,6 +738,7 @@ U32 KUnixSocketObject::sendmsg(KFileDescriptor* fd, U32 address, U32 flags) {
     }
     con->msgs.push(msg);
     BOXEDWINE_CONDITION_SIGNAL_ALL(con->lockCond);
+    con->notifyEPoll();
 
     return result;
 }
@@ -756,7 +751,7 @@ U32 KUnixSocketObject::recvmsg(KFileDescriptor* fd, U32 address, U32 flags) {
         return -K_EIO;
     BOXEDWINE_CRITICAL_SECTION_WITH_CONDITION(this->lockCond);
     while (!this->msgs.size()) {
-        if (this->recvBuffer.size()) {
+        if (!this->recvBuffer.isEmpty()) {
             readMsgHdr(address, &hdr);        
             for (U32 i = 0; i < hdr.msg_iovlen; i++) {
                 U32 p = readd(hdr.msg_iov + 8 * i);
@@ -798,6 +793,9 @@ U32 KUnixSocketObject::recvmsg(KFileDescriptor* fd, U32 address, U32 flags) {
 
         for (;i<hdr.msg_controllen/16 && i<msg->objects.size();i++) {
             KFileDescriptor* recvFd = thread->process->allocFileDescriptor(msg->objects[i].object, msg->objects[i].accessFlags, 0, -1, 0);
+            if (!recvFd) {
+                break; // out of handles, like Linux the rest of the passed fds are dropped
+            }
             writeCMsgHdr(hdr.msg_control + i * 16, 16, K_SOL_SOCKET, K_SCM_RIGHTS);
             writed(hdr.msg_control + i * 16 + 12, recvFd->handle);
         }
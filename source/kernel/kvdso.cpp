@@ -0,0 +1,488 @@
+/*
+ *  Copyright (C) 2016  The BoxedWine Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include "boxedwine.h"
+#include "kvdso.h"
+
+#ifdef BOXEDWINE_VDSO
+
+#include "loader/kelf.h"
+#include "../emulation/softmmu/soft_ram.h"
+#include "../emulation/softmmu/soft_ro_page.h"
+
+#define VDSO_ADDRESS (ADDRESS_PROCESS_VDSO << K_PAGE_SHIFT)
+#define VDSO_TIME_ADDRESS (VDSO_ADDRESS + K_PAGE_SIZE)
+
+// layout of the time page, all U32
+#define VDSO_TIME_SEQ 0
+#define VDSO_TIME_TSC 4 // low 32 bits of the guest rdtsc when the page was written
+#define VDSO_TIME_MULT 8 // ns per instruction << 16
+#define VDSO_TIME_MAX_DELTA 12 // the most instructions the guest will add to the time
+#define VDSO_TIME_BILLION 16 // 1000000000 so that it can be used as a div operand
+#define VDSO_TIME_CLOCKS 32 // U64 ns for each clock id below VDSO_CLOCK_COUNT
+
+#define VDSO_CLOCK_COUNT 8
+// CLOCK_REALTIME, CLOCK_MONOTONIC, CLOCK_MONOTONIC_RAW, CLOCK_REALTIME_COARSE and CLOCK_MONOTONIC_COARSE
+#define VDSO_CLOCK_MASK 0x73
+#define VDSO_CLOCK_IS_MONOTONIC(id) ((id) == 1 || (id) == 4 || (id) == 6)
+
+// layout of the image
+#define VDSO_PHDR_OFFSET 0x34
+#define VDSO_DYNAMIC_OFFSET 0x80
+#define VDSO_HASH_OFFSET 0xd0
+#define VDSO_SYMTAB_OFFSET 0x100
+#define VDSO_VERSYM_OFFSET 0x180
+#define VDSO_VERDEF_OFFSET 0x1a0
+#define VDSO_STRTAB_OFFSET 0x200
+#define VDSO_CODE_OFFSET 0x400
+
+#define VDSO_DYNAMIC_COUNT 10
+#define VDSO_FUNCTION_COUNT 4
+#define VDSO_SYMBOL_COUNT (VDSO_FUNCTION_COUNT + 1)
+
+// guest time can run at most this far ahead of the last update
+#define VDSO_MAX_EXTRAPOLATE_NS 1000000
+// how often the difference between the realtime and monotonic clocks is read again
+#define VDSO_REALTIME_REFRESH_NS 10000000
+// the ns per instruction is measured over intervals with at least this many instructions that are not too long
+#define VDSO_MIN_SAMPLE_INSTRUCTIONS 100000
+#define VDSO_MAX_SAMPLE_NS 20000000
+
+#define VDSO_PT_LOAD 1
+#define VDSO_PT_DYNAMIC 2
+#define VDSO_DT_NULL 0
+#define VDSO_DT_HASH 4
+#define VDSO_DT_STRTAB 5
+#define VDSO_DT_SYMTAB 6
+#define VDSO_DT_STRSZ 10
+#define VDSO_DT_SYMENT 11
+#define VDSO_DT_SONAME 14
+#define VDSO_DT_VERSYM 0x6ffffff0
+#define VDSO_DT_VERDEF 0x6ffffffc
+#define VDSO_DT_VERDEFNUM 0x6ffffffd
+
+#define VDSO_SONAME "linux-gate.so.1"
+#define VDSO_VERSION "LINUX_2.6"
+
+struct VdsoFunction {
+    const char* name;
+    U32 offset;
+};
+
+static U8* codeRam;
+static U8* timeRam;
+static VdsoFunction functions[VDSO_FUNCTION_COUNT] = {
+    {"__vdso_clock_gettime", 0},
+    {"__vdso_clock_gettime64", 0},
+    {"__vdso_gettimeofday", 0},
+    {"__vdso_time", 0}
+};
+
+// what the guest is currently extrapolating from
+static U64 baseTsc;
+static U64 baseMonotonic;
+static U32 mult = 1 << 16;
+static U32 maxDelta;
+
+// start of the interval the next ns per instruction sample is measured over
+static U64 sampleTsc;
+static U64 sampleTime;
+
+static U64 realtimeOffset;
+static U64 realtimeOffsetTime;
+
+static U32 pos;
+
+static void emit8(U32 value) {
+    codeRam[pos++] = (U8)value;
+}
+
+static void emit32(U32 value) {
+    emit8(value);
+    emit8(value >> 8);
+    emit8(value >> 16);
+    emit8(value >> 24);
+}
+
+static void emit(const char* bytes, U32 len) {
+    for (U32 i = 0; i < len; i++) {
+        emit8((U8)bytes[i]);
+    }
+}
+
+// emits a jcc/jmp rel8 to a label that isn't known yet, returns where to patch it
+static U32 emitJump(U8 op) {
+    emit8(op);
+    emit8(0);
+    return pos - 1;
+}
+
+static void bindJump(U32 patch) {
+    U32 distance = pos - (patch + 1);
+    if (distance > 127) {
+        kpanic("vdso jump is too far: %d", distance);
+    }
+    codeRam[patch] = (U8)distance;
+}
+
+static void emitJumpBack(U8 op, U32 target) {
+    emit8(op);
+    emit8(target - (pos + 1));
+}
+
+// op reg, [absolute]
+static void emitAbsolute(U8 op, U8 rm, U32 offset) {
+    emit8(op);
+    emit8(rm);
+    emit32(VDSO_TIME_ADDRESS + offset);
+}
+
+static void write16(U32 offset, U16 value) {
+    codeRam[offset] = (U8)value;
+    codeRam[offset + 1] = (U8)(value >> 8);
+}
+
+static void write32(U32 offset, U32 value) {
+    write16(offset, (U16)value);
+    write16(offset + 2, (U16)(value >> 16));
+}
+
+static U32 writeString(U32* offset, const char* s) {
+    U32 result = *offset - VDSO_STRTAB_OFFSET;
+    U32 len = (U32)strlen(s) + 1;
+    memcpy(codeRam + *offset, s, len);
+    *offset += len;
+    return result;
+}
+
+static U32 elfHash(const char* name) {
+    U32 h = 0;
+    while (*name) {
+        h = (h << 4) + (U8)*name++;
+        U32 g = h & 0xf0000000;
+        if (g) {
+            h ^= g >> 24;
+        }
+        h &= ~g;
+    }
+    return h;
+}
+
+// Each conditional jump ends a block in the interpreter, which costs more than the instructions in it, so
+// the functions are as close to straight line code as they can be.
+//
+// The host only writes the page between guest instructions, so the guest doesn't need to wait for an
+// even count, it just starts over if the count changed while it was reading.
+//
+// clock is the offset of a clock in the page or -1 for the clock id in ebx, eax = sec, edx = nsec, trashes ecx
+static void emitReadTime(S32 clock) {
+    U32 retry = pos;
+    emitAbsolute(0x8b, 0x0d, VDSO_TIME_SEQ); // mov ecx, [seq]
+    emit("\x0f\x31", 2); // rdtsc
+    emitAbsolute(0x2b, 0x05, VDSO_TIME_TSC); // sub eax, [tsc]
+    emitAbsolute(0x3b, 0x05, VDSO_TIME_MAX_DELTA); // cmp eax, [maxDelta]
+    emit8(0x0f); emitAbsolute(0x47, 0x05, VDSO_TIME_MAX_DELTA); // cmova eax, [maxDelta]
+    emitAbsolute(0xf7, 0x25, VDSO_TIME_MULT); // mul dword [mult]
+    emit("\x0f\xac\xd0\x10", 4); // shrd eax, edx, 16
+    emit("\x31\xd2", 2); // xor edx, edx
+    if (clock < 0) {
+        emit("\x03\x04\xdd", 3); emit32(VDSO_TIME_ADDRESS + VDSO_TIME_CLOCKS); // add eax, [clocks+ebx*8]
+        emit("\x13\x14\xdd", 3); emit32(VDSO_TIME_ADDRESS + VDSO_TIME_CLOCKS + 4); // adc edx, [clocks+ebx*8+4]
+    } else {
+        emitAbsolute(0x03, 0x05, clock); // add eax, [clock]
+        emitAbsolute(0x13, 0x15, clock + 4); // adc edx, [clock+4]
+    }
+    emitAbsolute(0xf7, 0x35, VDSO_TIME_BILLION); // div dword [billion]
+    emitAbsolute(0x3b, 0x0d, VDSO_TIME_SEQ); // cmp ecx, [seq]
+    emitJumpBack(0x75, retry); // jne retry
+}
+
+// stores eax = sec, edx = nsec to the timespec at [esp+argOffset] and returns 0
+static void emitStoreTimespec(U32 argOffset, bool is64) {
+    emit("\x8b\x4c\x24", 3); emit8(argOffset); // mov ecx, [esp+argOffset]
+    emit("\x89\x01", 2); // mov [ecx], eax
+    if (is64) {
+        emit("\xc7\x41\x04\x00\x00\x00\x00", 7); // mov dword [ecx+4], 0
+        emit("\x89\x51\x08", 3); // mov [ecx+8], edx
+        emit("\xc7\x41\x0c\x00\x00\x00\x00", 7); // mov dword [ecx+12], 0
+    } else {
+        emit("\x89\x51\x04", 3); // mov [ecx+4], edx
+    }
+    emit("\x31\xc0", 2); // xor eax, eax
+}
+
+// int clock_gettime(clockid_t clk, struct timespec* tp), clocks that aren't in the time page use the syscall
+//
+// CLOCK_MONOTONIC is what QueryPerformanceCounter uses, it gets a path of its own
+static U32 emitClockGettime(U32 syscallNo, bool is64) {
+    U32 result = pos;
+
+    emit("\x83\x7c\x24\x04\x01", 5); // cmp dword [esp+4], 1 (CLOCK_MONOTONIC)
+    U32 notMonotonic = emitJump(0x75); // jne
+    emitReadTime(VDSO_TIME_CLOCKS + 1 * 8);
+    emitStoreTimespec(8, is64);
+    emit8(0xc3); // ret
+    bindJump(notMonotonic);
+    emit8(0x53); // push ebx
+    emit("\x8b\x5c\x24\x08", 4); // mov ebx, [esp+8]
+    emit("\x83\xfb", 2); emit8(VDSO_CLOCK_COUNT); // cmp ebx, VDSO_CLOCK_COUNT
+    emit("\x19\xc9", 2); // sbb ecx, ecx
+    emit("\x83\xe1", 2); emit8(VDSO_CLOCK_MASK); // and ecx, VDSO_CLOCK_MASK
+    emit("\x0f\xa3\xd9", 3); // bt ecx, ebx
+    U32 fallback = emitJump(0x73); // jnc
+    emitReadTime(-1);
+    emitStoreTimespec(12, is64);
+    emit8(0x5b); // pop ebx
+    emit8(0xc3); // ret
+    bindJump(fallback);
+    emit("\x8b\x4c\x24\x0c", 4); // mov ecx, [esp+12]
+    emit8(0xb8); emit32(syscallNo); // mov eax, syscallNo
+    emit("\xcd\x80", 2); // int 0x80
+    emit8(0x5b); // pop ebx
+    emit8(0xc3); // ret
+    return result;
+}
+
+// int gettimeofday(struct timeval* tv, struct timezone* tz), tz is ignored just like the syscall
+static U32 emitGettimeofday() {
+    U32 result = pos;
+
+    emit("\x83\x7c\x24\x04\x00", 5); // cmp dword [esp+4], 0
+    U32 done = emitJump(0x74); // je
+    emitReadTime(VDSO_TIME_CLOCKS);
+    emit("\x8b\x4c\x24\x04", 4); // mov ecx, [esp+4]
+    emit("\x89\x01", 2); // mov [ecx], eax
+    emit("\x89\xd0", 2); // mov eax, edx
+    emit("\x31\xd2", 2); // xor edx, edx
+    emit8(0xb9); emit32(1000); // mov ecx, 1000
+    emit("\xf7\xf1", 2); // div ecx
+    emit("\x8b\x4c\x24\x04", 4); // mov ecx, [esp+4]
+    emit("\x89\x41\x04", 3); // mov [ecx+4], eax
+    bindJump(done);
+    emit("\x31\xc0", 2); // xor eax, eax
+    emit8(0xc3); // ret
+    return result;
+}
+
+// time_t time(time_t* t)
+static U32 emitTime() {
+    U32 result = pos;
+
+    emitReadTime(VDSO_TIME_CLOCKS);
+    emit("\x8b\x4c\x24\x04", 4); // mov ecx, [esp+4]
+    emit("\x85\xc9", 2); // test ecx, ecx
+    U32 done = emitJump(0x74); // je
+    emit("\x89\x01", 2); // mov [ecx], eax
+    bindJump(done);
+    emit8(0xc3); // ret
+    return result;
+}
+
+// The image is linked at 0 and only has what libc looks at: the program headers, the dynamic section,
+// the symbols with their hash table and the version the symbols are looked up with
+static void buildImage() {
+    struct k_Elf32_Ehdr* hdr = (struct k_Elf32_Ehdr*)codeRam;
+    U32 strings = VDSO_STRTAB_OFFSET;
+    U32 i;
+
+    writeString(&strings, "");
+    U32 soname = writeString(&strings, VDSO_SONAME);
+    U32 version = writeString(&strings, VDSO_VERSION);
+    U32 names[VDSO_FUNCTION_COUNT];
+    for (i = 0; i < VDSO_FUNCTION_COUNT; i++) {
+        names[i] = writeString(&strings, functions[i].name);
+    }
+    if (strings > VDSO_CODE_OFFSET) {
+        kpanic("vdso strings overlap the code");
+    }
+
+    pos = VDSO_CODE_OFFSET;
+    functions[0].offset = emitClockGettime(265, false); // __NR_clock_gettime
+    functions[1].offset = emitClockGettime(403, true); // __NR_clock_gettime64
+    functions[2].offset = emitGettimeofday();
+    functions[3].offset = emitTime();
+
+    hdr->e_ident[0] = 0x7f;
+    hdr->e_ident[1] = 'E';
+    hdr->e_ident[2] = 'L';
+    hdr->e_ident[3] = 'F';
+    hdr->e_ident[4] = 1; // 32-bit
+    hdr->e_ident[5] = 1; // little endian
+    hdr->e_ident[6] = 1; // EV_CURRENT
+    write16(16, 3); // e_type = ET_DYN
+    write16(18, 3); // e_machine = EM_386
+    write32(20, 1); // e_version
+    write32(28, VDSO_PHDR_OFFSET); // e_phoff
+    write16(40, sizeof(struct k_Elf32_Ehdr)); // e_ehsize
+    write16(42, sizeof(struct k_Elf32_Phdr)); // e_phentsize
+    write16(44, 2); // e_phnum
+    write16(46, sizeof(struct k_Elf32_Shdr)); // e_shentsize
+
+    U32 phdr = VDSO_PHDR_OFFSET;
+    write32(phdr, VDSO_PT_LOAD);
+    write32(phdr + 16, K_PAGE_SIZE); // p_filesz
+    write32(phdr + 20, K_PAGE_SIZE); // p_memsz
+    write32(phdr + 24, 5); // p_flags = R|X
+    write32(phdr + 28, K_PAGE_SIZE); // p_align
+    phdr += sizeof(struct k_Elf32_Phdr);
+    write32(phdr, VDSO_PT_DYNAMIC);
+    write32(phdr + 4, VDSO_DYNAMIC_OFFSET); // p_offset
+    write32(phdr + 8, VDSO_DYNAMIC_OFFSET); // p_vaddr
+    write32(phdr + 12, VDSO_DYNAMIC_OFFSET); // p_paddr
+    write32(phdr + 16, VDSO_DYNAMIC_COUNT * 8); // p_filesz
+    write32(phdr + 20, VDSO_DYNAMIC_COUNT * 8); // p_memsz
+    write32(phdr + 24, 4); // p_flags = R
+    write32(phdr + 28, 4); // p_align
+
+    U32 dynamic[VDSO_DYNAMIC_COUNT * 2] = {
+        VDSO_DT_HASH, VDSO_HASH_OFFSET,
+        VDSO_DT_STRTAB, VDSO_STRTAB_OFFSET,
+        VDSO_DT_SYMTAB, VDSO_SYMTAB_OFFSET,
+        VDSO_DT_STRSZ, strings - VDSO_STRTAB_OFFSET,
+        VDSO_DT_SYMENT, 16,
+        VDSO_DT_SONAME, soname,
+        VDSO_DT_VERSYM, VDSO_VERSYM_OFFSET,
+        VDSO_DT_VERDEF, VDSO_VERDEF_OFFSET,
+        VDSO_DT_VERDEFNUM, 2,
+        VDSO_DT_NULL, 0
+    };
+    for (i = 0; i < VDSO_DYNAMIC_COUNT * 2; i++) {
+        write32(VDSO_DYNAMIC_OFFSET + i * 4, dynamic[i]);
+    }
+
+    // one bucket that chains through every symbol
+    write32(VDSO_HASH_OFFSET, 1); // nbucket
+    write32(VDSO_HASH_OFFSET + 4, VDSO_SYMBOL_COUNT); // nchain
+    write32(VDSO_HASH_OFFSET + 8, VDSO_SYMBOL_COUNT - 1); // bucket[0]
+    for (i = 1; i < VDSO_SYMBOL_COUNT; i++) {
+        write32(VDSO_HASH_OFFSET + 12 + i * 4, i - 1);
+    }
+
+    // symbol 0 is the null symbol
+    for (i = 0; i < VDSO_FUNCTION_COUNT; i++) {
+        U32 sym = VDSO_SYMTAB_OFFSET + (i + 1) * 16;
+        write32(sym, names[i]); // st_name
+        write32(sym + 4, functions[i].offset); // st_value
+        write32(sym + 8, 0); // st_size
+        codeRam[sym + 12] = 0x12; // st_info = STB_GLOBAL, STT_FUNC
+        write16(sym + 14, 1); // st_shndx, anything but SHN_UNDEF and SHN_ABS
+        write16(VDSO_VERSYM_OFFSET + (i + 1) * 2, 2); // VDSO_VERSION
+    }
+
+    // version 1 is the library itself, version 2 is VDSO_VERSION
+    U32 verdef = VDSO_VERDEF_OFFSET;
+    write16(verdef, 1); // vd_version
+    write16(verdef + 2, 1); // vd_flags = VER_FLG_BASE
+    write16(verdef + 4, 1); // vd_ndx
+    write16(verdef + 6, 1); // vd_cnt
+    write32(verdef + 8, elfHash(VDSO_SONAME)); // vd_hash
+    write32(verdef + 12, 20); // vd_aux
+    write32(verdef + 16, 28); // vd_next
+    write32(verdef + 20, soname); // vda_name
+    verdef += 28;
+    write16(verdef, 1);
+    write16(verdef + 4, 2);
+    write16(verdef + 6, 1);
+    write32(verdef + 8, elfHash(VDSO_VERSION));
+    write32(verdef + 12, 20);
+    write32(verdef + 20, version);
+}
+
+void KVdso::init() {
+    if (codeRam) {
+        return;
+    }
+    codeRam = ramPageAlloc();
+    timeRam = ramPageAlloc();
+    buildImage();
+    updateTime(0, KSystem::getMicroCounter());
+}
+
+U32 KVdso::map(Memory* memory) {
+    init();
+    memory->setPage(ADDRESS_PROCESS_VDSO, ROPage::alloc(codeRam, VDSO_ADDRESS, PAGE_READ | PAGE_EXEC | PAGE_SHARED));
+    memory->setPage(ADDRESS_PROCESS_VDSO + 1, ROPage::alloc(timeRam, VDSO_TIME_ADDRESS, PAGE_READ | PAGE_SHARED));
+    return VDSO_ADDRESS;
+}
+
+U32 KVdso::getFunctionAddress(const char* name) {
+    init();
+    for (U32 i = 0; i < VDSO_FUNCTION_COUNT; i++) {
+        if (!strcmp(functions[i].name, name)) {
+            return VDSO_ADDRESS + functions[i].offset;
+        }
+    }
+    return 0;
+}
+
+void KVdso::updateTime(U64 tsc, U64 microCounter) {
+    if (!timeRam) {
+        return;
+    }
+    U64 now = microCounter * 1000;
+    if (!realtimeOffsetTime || now - realtimeOffsetTime > VDSO_REALTIME_REFRESH_NS) {
+        // this is called for every syscall, it shouldn't read the host clock more than it needs to
+        realtimeOffset = KSystem::getSystemTimeAsMicroSeconds() * 1000 - now;
+        realtimeOffsetTime = now;
+    }
+
+    // the guest could already have seen the time extrapolated up to tsc, it can't go backwards from there
+    U64 delta = tsc > baseTsc ? tsc - baseTsc : 0;
+    if (delta > maxDelta) {
+        delta = maxDelta;
+    }
+    U64 monotonic = baseMonotonic + ((delta * mult) >> 16);
+    if (monotonic < now) {
+        monotonic = now;
+    }
+
+    if (!sampleTime || now < sampleTime || tsc < sampleTsc || now - sampleTime > VDSO_MAX_SAMPLE_NS) {
+        // too long, it was probably waiting instead of running instructions
+        sampleTsc = tsc;
+        sampleTime = now;
+    } else if (tsc - sampleTsc >= VDSO_MIN_SAMPLE_INSTRUCTIONS) {
+        U64 sample = ((now - sampleTime) << 16) / (tsc - sampleTsc);
+        if (sample < 1) {
+            sample = 1;
+        } else if (sample > 0xffffffff) {
+            sample = 0xffffffff;
+        }
+        mult = (U32)(((U64)mult * 3 + sample) / 4);
+        sampleTsc = tsc;
+        sampleTime = now;
+    }
+    maxDelta = (U32)(((U64)VDSO_MAX_EXTRAPOLATE_NS << 16) / mult);
+    baseTsc = tsc;
+    baseMonotonic = monotonic;
+
+    U32* p = (U32*)timeRam;
+    p[VDSO_TIME_SEQ / 4]++;
+    p[VDSO_TIME_TSC / 4] = (U32)tsc;
+    p[VDSO_TIME_MULT / 4] = mult;
+    p[VDSO_TIME_MAX_DELTA / 4] = maxDelta;
+    p[VDSO_TIME_BILLION / 4] = 1000000000;
+    U64 realtime = monotonic + realtimeOffset;
+    for (U32 i = 0; i < VDSO_CLOCK_COUNT; i++) {
+        U64 ns = VDSO_CLOCK_IS_MONOTONIC(i) ? monotonic : realtime;
+        p[VDSO_TIME_CLOCKS / 4 + i * 2] = (U32)ns;
+        p[VDSO_TIME_CLOCKS / 4 + i * 2 + 1] = (U32)(ns >> 32);
+    }
+    p[VDSO_TIME_SEQ / 4]++;
+}
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "kelf.h"
 #include "loader.h"
+#include "kvdso.h"
 
 #include <string.h>
 
@@ -303,5 +304,8 @@ bool ElfLoader::loadProgram(const std::shared_ptr<KProcess>& process, FsOpenNode
 
     *eip = hdr->e_entry+reloc;
     process->entry = *eip; 
+#ifdef BOXEDWINE_VDSO
+    process->vdsoAddress = KVdso::map(process->memory);
+#endif
     return true;
 }
@@ -22,6 +22,7 @@
 #include "ksignal.h"
 #include "ksocket.h"
 #include "kepoll.h"
+#include "kvdso.h"
 
 #include <stdarg.h>
 #include <random>
@@ -1158,6 +1159,12 @@ static const char* getFutexOp(U32 op) {
     if (op==129) return "WAKE PRIVATE";
     if (op == 137) return "WAIT BITSET PRIVATE";
     if (op == 138) return "WAKE BITSET PRIVATE";
+    if (op == 3) return "REQUEUE";
+    if (op == 131) return "REQUEUE PRIVATE";
+    if (op == 4) return "CMP REQUEUE";
+    if (op == 132) return "CMP REQUEUE PRIVATE";
+    if (op == 5) return "WAKE OP";
+    if (op == 133) return "WAKE OP PRIVATE";
     static std::string tmp;
     tmp = std::to_string(op);
     return tmp.c_str();
@@ -2048,9 +2055,13 @@ void ksyscall(CPU* cpu, U32 eipCount) {
 #endif
         result = syscallFunc[EAX](cpu, eipCount);
 #ifndef BOXEDWINE_MULTI_THREADED
-        U64 diff = KSystem::getMicroCounter()-startTime;
+        U64 endTime = KSystem::getMicroCounter();
+        U64 diff = endTime-startTime;
         sysCallTime+=diff;  
         cpu->blockInstructionCount+=(U32)(contextTime*diff/10000);
+#ifdef BOXEDWINE_VDSO
+        KVdso::updateTime(cpu->instructionCount+cpu->blockInstructionCount, endTime);
+#endif
 #endif
     }    
 #ifdef BOXEDWINE_MULTI_THREADED
@@ -5,7 +5,30 @@
 #include "glcommon.h"
 #include "glMarshal.h"
 
-#define MARSHAL_TYPE(type, p, m, s) type* buffer##p; U32 buffer##p##_len; type* marshal##p(CPU* cpu, U32 address, U32 count) {U32 i; if (!address) return NULL; if (buffer##p && buffer##p##_len<count) { delete[] buffer##p; buffer##p=NULL;} if (!buffer##p) {buffer##p = new type[count]; buffer##p##_len = count;}for (i=0;i<count;i++) {buffer##p[i] = read##m(address);address+=s;} return buffer##p;}
+// copies a guest array a page at a time, only pages that can't be read directly fall back to readb
+static void marshalArray(U8* dst, U32 address, U32 len) {
+    while (len) {
+        U32 todo = K_PAGE_SIZE - (address & K_PAGE_MASK);
+        if (todo > len) {
+            todo = len;
+        }
+        U8* ram = getPhysicalReadAddress(address, todo);
+        if (ram) {
+            memcpy(dst, ram, todo);
+        } else {
+            for (U32 i = 0; i < todo; i++) {
+                dst[i] = readb(address + i);
+            }
+        }
+        dst += todo;
+        address += todo;
+        len -= todo;
+    }
+}
+
+// The scratch buffers are per thread, more than one emulated thread can be in GL at the same time.
+// The guest array is copied in bulk unless the host type is a different size than the guest's (GLsizeiptr on 64-bit)
+#define MARSHAL_TYPE(type, p, m, s) THREAD_LOCAL static type* buffer##p; THREAD_LOCAL static U32 buffer##p##_len; type* marshal##p(CPU* cpu, U32 address, U32 count) {U32 i; if (!address) return NULL; if (buffer##p && buffer##p##_len<count) { delete[] buffer##p; buffer##p=NULL;} if (!buffer##p) {buffer##p = new type[count]; buffer##p##_len = count;} if (sizeof(type) == s) {marshalArray((U8*)buffer##p, address, count*s);} else {for (i=0;i<count;i++) {buffer##p[i] = (type)read##m(address);address+=s;}} return buffer##p;}
 
 #ifdef BOXEDWINE_64BIT_MMU
 
@@ -181,8 +204,6 @@ const GLcharARB** marshalszArrayARB(CPU* cpu, U32 count, U32 address, U32 addres
 }
 
 #else 
-#define MARSHAL_TYPE_CUSTOM(type, p, m, s, conv, get, set) type* buffer##p; U32 buffer##p##_len; type* marshal##p(CPU* cpu, U32 address, U32 count) {U32 i; if (!address) return NULL; if (buffer##p && buffer##p##_len<count) { delete[] buffer##p; buffer##p=NULL;} if (!buffer##p) {buffer##p = new type[count]; buffer##p##_len = count;}for (i=0;i<count;i++) {struct conv d; get = read##m(address);address+=s;buffer##p[i] = set;} return buffer##p;}
-
 MARSHAL_TYPE(GLbyte, b, b, 1)
 MARSHAL_TYPE(GLbyte, 2b, b, 1)
 
@@ -253,13 +274,13 @@ MARSHAL_TYPE(GLsizei, si, d, 4)
 
 MARSHAL_TYPE(GLhalfNV, hf, w, 2)
 
-MARSHAL_TYPE_CUSTOM(GLfloat, f, d, 4, int2Float, d.i, d.f)
-MARSHAL_TYPE_CUSTOM(GLfloat, 2f, d, 4, int2Float, d.i, d.f)
-MARSHAL_TYPE_CUSTOM(GLfloat, 3f, d, 4, int2Float, d.i, d.f)
-MARSHAL_TYPE_CUSTOM(GLfloat, 4f, d, 4, int2Float, d.i, d.f)
+MARSHAL_TYPE(GLfloat, f, d, 4)
+MARSHAL_TYPE(GLfloat, 2f, d, 4)
+MARSHAL_TYPE(GLfloat, 3f, d, 4)
+MARSHAL_TYPE(GLfloat, 4f, d, 4)
 
-MARSHAL_TYPE_CUSTOM(GLdouble, d, q, 8, long2Double, d.l, d.d)
-MARSHAL_TYPE_CUSTOM(GLdouble, 2d, q, 8, long2Double, d.l, d.d)
+MARSHAL_TYPE(GLdouble, d, q, 8)
+MARSHAL_TYPE(GLdouble, 2d, q, 8)
 
 void marshalBackd(CPU* cpu, U32 address, GLdouble* buffer, U32 count) {
     U32 i;
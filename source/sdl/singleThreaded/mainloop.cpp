@@ -42,7 +42,7 @@ bool doMainLoop() {
                 KNativeWindow::getNativeWindow()->setTitle(KSystem::title.c_str());
             } else {
                 char tmp[256];
-                snprintf(tmp, sizeof(tmp), "BoxedWine " BOXEDWINE_VERSION_DISPLAY " %u MIPS", getMIPS());
+                snprintf(tmp, sizeof(tmp), "BoxedWine " BOXEDWINE_VERSION_DISPLAY " %u MIPS %u KB/frame", getMIPS(), KNativeWindow::getNativeWindow()->getBytesUploadedPerFrame() >> 10);
                 KNativeWindow::getNativeWindow()->setTitle(tmp);
             }            
             checkWaitingNativeSockets(0); // just so it doesn't starve if the system is busy
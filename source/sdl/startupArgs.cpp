@@ -22,6 +22,10 @@
 #include "mainloop.h"
 #include "../io/fsfilenode.h"
 #include "../io/fszip.h"
+#include "../emulation/cpu/normal/normalCPU.h"
+#ifdef BOXEDWINE_X64
+#include "../emulation/cpu/x64/x64CodeCache.h"
+#endif
 #include "loader.h"
 #include "kstat.h"
 #include "knativesystem.h"
@@ -342,6 +346,7 @@ bool StartUpArgs::apply() {
                     BoxedPtr<FsNode> freeTypeNode = Fs::getNodeFromLocalPath("", "/usr/lib/i386-linux-gnu/libfreetype.so.6", false);
                     if (freeTypeNode) {
                         freeTypeNode->link = "libfreetype.so.6.12.3";
+                        Fs::invalidatePathCache();
                     }
                 }
             }
@@ -511,6 +516,15 @@ bool StartUpArgs::apply() {
 #ifdef GENERATE_SOURCE
     if (gensrc)
         writeSource();
+#endif
+#ifdef BOXEDWINE_DYNAMIC
+    klog("%u blocks were promoted to the dynamic core (%u KB of code), promote threshold is %u runs", NormalCPU::promotedBlocks, (U32)(NormalCPU::promotedBytes >> 10), NormalCPU::promoteThreshold);
+#endif
+#ifdef BOXEDWINE_X64
+    if (X64CodeCache::path.length()) {
+        klog("%u chunks were loaded from the code cache, %u were translated", X64CodeCache::hits.load(), X64CodeCache::misses.load());
+        X64CodeCache::save();
+    }
 #endif
     klog("Boxedwine has shutdown"); // must call before KSystem::destroy()
 	KSystem::destroy();
@@ -702,6 +716,29 @@ bool StartUpArgs::parseStartupArgs(int argc, const char **argv) {
         } else if (!strcmp(argv[i], "-skipFrameFPS") && i+1<argc) {
             this->skipFrameFPS = atoi(argv[i+1]);
             i++;
+        } else if (!strcmp(argv[i], "-faultAround") && i + 1 < argc) {
+            KSystem::faultAroundPages = atoi(argv[i + 1]);
+            i++;
+        } else if (!strcmp(argv[i], "-zipReaders") && i + 1 < argc) {
+#ifdef BOXEDWINE_ZLIB
+            FsZip::maxReaders = atoi(argv[i + 1]);
+#endif
+            i++;
+        } else if (!strcmp(argv[i], "-promoteThreshold") && i + 1 < argc) {
+#ifdef BOXEDWINE_DYNAMIC
+            NormalCPU::promoteThreshold = atoi(argv[i + 1]);
+#else
+            klog("ignoring -promoteThreshold, it is only supported by the dynamic cores");
+#endif
+            i++;
+        } else if (!strcmp(argv[i], "-codeCache") && i + 1 < argc) {
+#ifdef BOXEDWINE_X64
+            X64CodeCache::path = argv[i + 1];
+            X64CodeCache::load();
+#else
+            klog("ignoring -codeCache, it is only supported by the x64 binary translator");
+#endif
+            i++;
         } else if (!strcmp(argv[i], "-log") && i + 1 < argc) {
             this->logPath = argv[i + 1];
             i++;
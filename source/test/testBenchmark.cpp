@@ -0,0 +1,125 @@
+#include "boxedwine.h"
+
+#ifdef __TEST
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "testCPU.h"
+#include "testBenchmark.h"
+#include "testBenchmarkKernel.h"
+#include "testBenchmarkCPU.h"
+#include "testBenchmarkFs.h"
+#include "testBenchmarkVulkan.h"
+
+void setup();
+
+static int benchmarkFails;
+
+BenchmarkClock::BenchmarkClock() : startTime(KSystem::getMicroCounter()), stopTime(0) {
+}
+
+void BenchmarkClock::stop() {
+    stopTime = KSystem::getMicroCounter();
+}
+
+double BenchmarkClock::getSeconds() {
+    U64 micro = stopTime - startTime;
+    // a timer with a coarse resolution can see no time pass at all
+    if (!micro) {
+        micro = 1;
+    }
+    return (double)micro / 1000000.0;
+}
+
+void BenchmarkClock::reportRate(const char* name, double count, double scale, const char* units) {
+    printf("%-40s %10.1f %s\n", name, count / scale / getSeconds(), units);
+}
+
+void BenchmarkClock::reportThroughput(const char* name, U64 bytes) {
+    reportRate(name, (double)bytes, 1024.0 * 1024.0, "MB/s");
+}
+
+void BenchmarkClock::reportTime(const char* name) {
+    printf("%-40s %10.1f ms\n", name, getSeconds() * 1000.0);
+}
+
+void benchmarkFailed(const char* name, const char* format, ...) {
+    printf("%-40s FAILED", name);
+    if (format) {
+        va_list args;
+
+        va_start(args, format);
+        printf(" ");
+        vprintf(format, args);
+        va_end(args);
+    }
+    printf("\n");
+    benchmarkFails++;
+}
+
+void fillBenchmarkPattern(U32 address, U32 len, U32 seed) {
+    for (U32 i = 0; i < len; i++) {
+        writeb(address + i, (U8)(i * 31 + seed));
+    }
+}
+
+bool checkBenchmarkPattern(U32 address, U32 len, U32 seed) {
+    for (U32 i = 0; i < len; i++) {
+        if (readb(address + i) != (U8)(i * 31 + seed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Benchmark {
+    void (*functionPtr)();
+    const char* name;
+};
+
+static Benchmark benchmarks[] = {
+    {benchmarkSocketPairLarge, "socketpair"},
+    {benchmarkSocketPairSmall, "socketpair"},
+    {benchmarkSocketPairMedium, "socketpair"},
+    {benchmarkEPoll, "epoll"},
+    {benchmarkFdTable, "fd"},
+    {benchmarkTimers, "timers"},
+#ifndef BOXEDWINE_BINARY_TRANSLATOR
+    {benchmarkCall, "call"},
+    {benchmarkRepMovs, "rep movs"},
+    {benchmarkRepStos, "rep stos"},
+    {benchmarkRepCmps, "rep cmps"},
+    {benchmarkRepScas, "rep scas"},
+    {benchmarkDecode, "decode"},
+#endif
+#ifdef BOXEDWINE_VDSO
+    {benchmarkVdso, "vdso"},
+#endif
+#ifdef BOXEDWINE_X64
+    {benchmarkCodeCache, "codecache"},
+#endif
+    {benchmarkIgnoreCase, "ignorecase"},
+#ifdef BOXEDWINE_VULKAN
+    {benchmarkVulkanMarshal, "vulkan"},
+#endif
+#ifdef BOXEDWINE_ZLIB
+    {benchmarkZip, "zip"},
+#endif
+};
+
+int runBenchmarks(const char* filter) {
+    for (U32 i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (filter && !strstr(benchmarks[i].name, filter)) {
+            continue;
+        }
+        setup();
+        benchmarks[i].functionPtr();
+    }
+    if (benchmarkFails) {
+        printf("%d benchmarks FAILED\n", benchmarkFails);
+        return 1;
+    }
+    return 0;
+}
+
+#endif
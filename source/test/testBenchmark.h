@@ -0,0 +1,37 @@
+#ifndef __TEST_BENCHMARK_H__
+#define __TEST_BENCHMARK_H__
+
+// benchmarks are not run as part of the normal tests, use "-benchmark [name]" on the command line
+int runBenchmarks(const char* filter);
+
+// guest memory in the heap set up by setup() in testCPU.cpp
+#define BENCHMARK_BUFFER_SIZE (32 * 1024)
+#define BENCHMARK_SRC_ADDRESS (HEAP_ADDRESS + K_PAGE_SIZE)
+#define BENCHMARK_DST_ADDRESS (BENCHMARK_SRC_ADDRESS + BENCHMARK_BUFFER_SIZE)
+#define BENCHMARK_TOTAL_BYTES (256 * 1024 * 1024)
+
+// times the work between the constructor and stop() and prints the result in the same columns as every other benchmark
+class BenchmarkClock {
+public:
+    BenchmarkClock();
+
+    void stop();
+    // prints count / scale per second, so 1000000.0 for "M calls/s"
+    void reportRate(const char* name, double count, double scale, const char* units);
+    void reportThroughput(const char* name, U64 bytes);
+    void reportTime(const char* name);
+
+private:
+    double getSeconds();
+
+    U64 startTime;
+    U64 stopTime;
+};
+
+// format is printf style and can be NULL, runBenchmarks will return 1 once any benchmark has failed
+void benchmarkFailed(const char* name, const char* format, ...);
+
+void fillBenchmarkPattern(U32 address, U32 len, U32 seed);
+bool checkBenchmarkPattern(U32 address, U32 len, U32 seed);
+
+#endif
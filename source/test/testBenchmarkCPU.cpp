@@ -0,0 +1,259 @@
+#include "boxedwine.h"
+
+#ifdef __TEST
+#include <stdio.h>
+
+#include "testCPU.h"
+#include "testBenchmark.h"
+#include "testBenchmarkCPU.h"
+#ifndef BOXEDWINE_BINARY_TRANSLATOR
+#include "../emulation/cpu/normal/normalCPU.h"
+#endif
+#ifdef BOXEDWINE_X64
+#include "../emulation/cpu/binaryTranslation/btCpu.h"
+#include "../emulation/cpu/x64/x64CodeCache.h"
+#endif
+
+#define BENCHMARK_CALL_ITERATIONS 5000000
+
+#define BENCHMARK_DECODE_BLOCKS 64
+#define BENCHMARK_DECODE_BLOCK_SIZE 49
+#define BENCHMARK_DECODE_ITERATIONS 20000
+
+#define BENCHMARK_CODE_CACHE_CHUNKS 2000
+#define BENCHMARK_CODE_CACHE_CHUNK_SIZE 49
+
+#ifndef BOXEDWINE_BINARY_TRANSLATOR
+static void reportHitRate(const char* name, U64 hits, U64 misses) {
+    printf("%-40s %10.1f %% hits\n", name, (hits + misses) ? (double)hits * 100.0 / (double)(hits + misses) : 0.0);
+}
+
+// a loop that makes a direct and an indirect call to a function that just returns
+void benchmarkCall() {
+    NormalCPU* normalCPU = (NormalCPU*)cpu;
+
+    newInstruction(0);
+    pushCode8(0xb9); // mov ecx, BENCHMARK_CALL_ITERATIONS
+    pushCode32(BENCHMARK_CALL_ITERATIONS);
+    pushCode8(0xb8); // mov eax, 24
+    pushCode32(24);
+    pushCode8(0xe8); // 10: call 24
+    pushCode32(24 - 15);
+    pushCode8(0xff); // call eax
+    pushCode8(0xd0);
+    pushCode8(0x49); // dec ecx
+    pushCode8(0x75); // jnz 10
+    pushCode8(0xf6);
+    pushCode8(0x70); // 20: jo, stops the benchmark
+    pushCode8(0);
+    pushCode8(0x70);
+    pushCode8(0);
+    pushCode8(0xc3); // 24: ret
+
+    normalCPU->blockCacheHits = 0;
+    normalCPU->blockCacheMisses = 0;
+    normalCPU->returnPredictionHits = 0;
+    normalCPU->returnPredictionMisses = 0;
+
+    BenchmarkClock clock;
+    cpu->nextBlock = cpu->getNextBlock();
+    while (cpu->nextBlock->op->inst != JumpO) {
+        cpu->run();
+    }
+    clock.stop();
+
+    if (ECX != 0 || ESP != 4096) {
+        benchmarkFailed("call/ret", "ecx=%X esp=%X", ECX, ESP);
+        return;
+    }
+    clock.reportRate("call/ret", (double)BENCHMARK_CALL_ITERATIONS * 2, 1000000.0, "M calls/s");
+    reportHitRate("call/ret block cache", normalCPU->blockCacheHits, normalCPU->blockCacheMisses);
+    reportHitRate("call/ret return prediction", normalCPU->returnPredictionHits, normalCPU->returnPredictionMisses);
+}
+
+// a guest loop around a single rep string instruction over BENCHMARK_BUFFER_SIZE bytes
+static void benchmarkRepString(const char* name, U8 inst, U32 width) {
+    U32 iterations = BENCHMARK_TOTAL_BYTES / BENCHMARK_BUFFER_SIZE;
+
+    cpu->big = true;
+    newInstruction(0);
+    cpu->seg[DS].address = 0;
+    cpu->seg[ES].address = 0;
+    pushCode8(0xba); // mov edx, iterations
+    pushCode32(iterations);
+    pushCode8(0xbe); // 5: mov esi, BENCHMARK_SRC_ADDRESS
+    pushCode32(BENCHMARK_SRC_ADDRESS);
+    pushCode8(0xbf); // mov edi, BENCHMARK_DST_ADDRESS
+    pushCode32(BENCHMARK_DST_ADDRESS);
+    pushCode8(0xb9); // mov ecx, BENCHMARK_BUFFER_SIZE / width
+    pushCode32(BENCHMARK_BUFFER_SIZE / width);
+    pushCode8(0xf3); // rep/repz
+    if (width == 2) {
+        pushCode8(0x66);
+    }
+    pushCode8(inst);
+    pushCode8(0x4a); // dec edx
+    pushCode8(0x75); // jnz 5
+    pushCode8((U8)(5 - (width == 2 ? 26 : 25)));
+    pushCode8(0x70); // jo, stops the benchmark
+    pushCode8(0);
+    pushCode8(0x70);
+    pushCode8(0);
+
+    // movs copies the pattern, stos writes 0 and cmps/scas compare 0 so that they run the whole buffer
+    fillBenchmarkPattern(BENCHMARK_SRC_ADDRESS, BENCHMARK_BUFFER_SIZE, 7);
+    if (inst == 0xa4 || inst == 0xa5) {
+        fillBenchmarkPattern(BENCHMARK_DST_ADDRESS, BENCHMARK_BUFFER_SIZE, 3);
+    } else {
+        zeroMemory(BENCHMARK_DST_ADDRESS, BENCHMARK_BUFFER_SIZE);
+        if (inst == 0xa6 || inst == 0xa7) {
+            zeroMemory(BENCHMARK_SRC_ADDRESS, BENCHMARK_BUFFER_SIZE);
+        }
+    }
+
+    BenchmarkClock clock;
+    cpu->nextBlock = cpu->getNextBlock();
+    while (cpu->nextBlock->op->inst != JumpO) {
+        cpu->run();
+    }
+    clock.stop();
+
+    if (ECX != 0 || EDX != 0 || EDI != BENCHMARK_DST_ADDRESS + BENCHMARK_BUFFER_SIZE || ((inst == 0xa4 || inst == 0xa5) && !checkBenchmarkPattern(BENCHMARK_DST_ADDRESS, BENCHMARK_BUFFER_SIZE, 7))) {
+        benchmarkFailed(name, "ecx=%X edx=%X edi=%X", ECX, EDX, EDI);
+        return;
+    }
+    clock.reportThroughput(name, (U64)iterations * BENCHMARK_BUFFER_SIZE);
+}
+
+void benchmarkRepMovs() {
+    benchmarkRepString("rep movsb", 0xa4, 1);
+    benchmarkRepString("rep movsw", 0xa5, 2);
+    benchmarkRepString("rep movsd", 0xa5, 4);
+}
+
+void benchmarkRepStos() {
+    benchmarkRepString("rep stosb", 0xaa, 1);
+    benchmarkRepString("rep stosw", 0xab, 2);
+    benchmarkRepString("rep stosd", 0xab, 4);
+}
+
+void benchmarkRepCmps() {
+    benchmarkRepString("repz cmpsb", 0xa6, 1);
+    benchmarkRepString("repz cmpsw", 0xa7, 2);
+    benchmarkRepString("repz cmpsd", 0xa7, 4);
+}
+
+void benchmarkRepScas() {
+    benchmarkRepString("repz scasb", 0xae, 1);
+    benchmarkRepString("repz scasw", 0xaf, 2);
+    benchmarkRepString("repz scasd", 0xaf, 4);
+}
+
+// decodes the same blocks over and over, none of it is run
+void benchmarkDecode() {
+    U64 bytes = 0;
+
+    newInstruction(0);
+    for (U32 i = 0; i < BENCHMARK_DECODE_BLOCKS; i++) {
+        for (U32 j = 0; j < 4; j++) {
+            pushCode8(0x01); // add eax, ecx
+            pushCode8(0xc8);
+            pushCode8(0x8b); // mov edx, [ebx+4]
+            pushCode8(0x53);
+            pushCode8(0x04);
+            pushCode8(0x89); // mov [esi+8], edx
+            pushCode8(0x56);
+            pushCode8(0x08);
+            pushCode8(0x83); // add ecx, 3
+            pushCode8(0xc1);
+            pushCode8(0x03);
+        }
+        pushCode8(0xe9); // jmp to the next block
+        pushCode32(0);
+    }
+
+    BenchmarkClock clock;
+    for (U32 i = 0; i < BENCHMARK_DECODE_ITERATIONS; i++) {
+        for (U32 j = 0; j < BENCHMARK_DECODE_BLOCKS; j++) {
+            DecodedBlock* block = NormalCPU::getBlockForInspectionButNotUsed(CODE_ADDRESS + j * BENCHMARK_DECODE_BLOCK_SIZE, true);
+            bytes += block->bytes;
+            block->dealloc(false);
+        }
+    }
+    clock.stop();
+
+    if (bytes != (U64)BENCHMARK_DECODE_ITERATIONS * BENCHMARK_DECODE_BLOCKS * BENCHMARK_DECODE_BLOCK_SIZE) {
+        benchmarkFailed("decode", "decoded %lld bytes", bytes);
+        return;
+    }
+    clock.reportThroughput("decode", bytes);
+}
+#endif
+
+#ifdef BOXEDWINE_X64
+static void clearCodeCacheBenchmarkCode() {
+    for (U32 i = 0; i < BENCHMARK_CODE_CACHE_CHUNKS * BENCHMARK_CODE_CACHE_CHUNK_SIZE; i += K_PAGE_SIZE) {
+        KThread::currentThread()->memory->clearCodePageFromCache((CODE_ADDRESS + i) >> K_PAGE_SHIFT);
+    }
+}
+
+// translated from the last chunk to the first so that each one can link to the next one, none of it is run
+static BenchmarkClock translateCodeCacheBenchmarkCode() {
+    BenchmarkClock clock;
+    for (S32 i = BENCHMARK_CODE_CACHE_CHUNKS - 1; i >= 0; i--) {
+        ((BtCPU*)cpu)->translateEip(i * BENCHMARK_CODE_CACHE_CHUNK_SIZE);
+    }
+    clock.stop();
+    return clock;
+}
+
+// time to translate code the first time it is seen compared to loading it from a code cache file saved by an earlier run
+void benchmarkCodeCache() {
+    std::string path = (std::filesystem::temp_directory_path() / "boxedwineBenchmark.cache").string();
+
+    newInstruction(0);
+    for (U32 i = 0; i < BENCHMARK_CODE_CACHE_CHUNKS; i++) {
+        for (U32 j = 0; j < 4; j++) {
+            pushCode8(0x01); // add eax, ecx
+            pushCode8(0xc8);
+            pushCode8(0x8b); // mov edx, [ebx+4]
+            pushCode8(0x53);
+            pushCode8(0x04);
+            pushCode8(0x89); // mov [esi+8], edx
+            pushCode8(0x56);
+            pushCode8(0x08);
+            pushCode8(0x83); // add ecx, 3
+            pushCode8(0xc1);
+            pushCode8(0x03);
+        }
+        pushCode8(0xe9); // jmp to the next chunk
+        pushCode32(0);
+    }
+
+    X64CodeCache::path = path;
+    X64CodeCache::clear();
+    clearCodeCacheBenchmarkCode();
+    BenchmarkClock coldClock = translateCodeCacheBenchmarkCode();
+    bool saved = X64CodeCache::save();
+
+    X64CodeCache::clear();
+    clearCodeCacheBenchmarkCode();
+    bool loaded = X64CodeCache::load();
+    BenchmarkClock warmClock = translateCodeCacheBenchmarkCode();
+    U32 hits = X64CodeCache::hits;
+
+    clearCodeCacheBenchmarkCode();
+    X64CodeCache::clear();
+    X64CodeCache::path = "";
+    std::filesystem::remove(path);
+
+    if (!saved || !loaded || hits != BENCHMARK_CODE_CACHE_CHUNKS) {
+        benchmarkFailed("code cache", "saved=%d loaded=%d hits=%d", saved ? 1 : 0, loaded ? 1 : 0, hits);
+        return;
+    }
+    coldClock.reportTime("code cache cold");
+    warmClock.reportTime("code cache warm");
+}
+#endif
+
+#endif
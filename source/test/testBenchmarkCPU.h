@@ -0,0 +1,16 @@
+#ifndef __TEST_BENCHMARK_CPU_H__
+#define __TEST_BENCHMARK_CPU_H__
+
+#ifndef BOXEDWINE_BINARY_TRANSLATOR
+void benchmarkCall();
+void benchmarkRepMovs();
+void benchmarkRepStos();
+void benchmarkRepCmps();
+void benchmarkRepScas();
+void benchmarkDecode();
+#endif
+#ifdef BOXEDWINE_X64
+void benchmarkCodeCache();
+#endif
+
+#endif
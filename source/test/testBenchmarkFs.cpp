@@ -0,0 +1,180 @@
+#include "boxedwine.h"
+
+#ifdef __TEST
+#include <stdio.h>
+
+#include "testBenchmark.h"
+#include "testBenchmarkFs.h"
+#include "../io/fsfilenode.h"
+#ifdef BOXEDWINE_ZLIB
+#include "../io/fszip.h"
+// fszip.h undefines zconf's OF and the include guard keeps it from coming back
+#define OF(args) args
+extern "C"
+{
+#include "../../lib/zlib/contrib/minizip/zip.h"
+}
+#undef OF
+#endif
+#ifdef BOXEDWINE_MULTI_THREADED
+#include <thread>
+#endif
+
+#define BENCHMARK_ZIP_ENTRIES 8
+#define BENCHMARK_ZIP_ENTRY_SIZE (4 * 1024 * 1024)
+#ifdef BOXEDWINE_MULTI_THREADED
+#define BENCHMARK_ZIP_THREADS 4
+#else
+#define BENCHMARK_ZIP_THREADS 1
+#endif
+
+#define BENCHMARK_FS_CHILDREN 5000
+#define BENCHMARK_FS_LOOKUPS 1000000
+
+static void benchmarkChildLookup(const char* name, const BoxedPtr<FsNode>& dir, const std::vector<std::string>& names, const std::vector<std::string>& lookupNames, bool ignoreCase) {
+    U32 seed = 12345;
+    BenchmarkClock clock;
+    for (U32 i = 0; i < BENCHMARK_FS_LOOKUPS; i++) {
+        seed = seed * 1103515245 + 12345;
+        U32 index = (seed >> 8) % BENCHMARK_FS_CHILDREN;
+        BoxedPtr<FsNode> node = ignoreCase ? dir->getChildByNameIgnoreCase(lookupNames[index]) : dir->getChildByName(lookupNames[index]);
+        if (!node || node->name != names[index]) {
+            benchmarkFailed(name, "%s was not found", lookupNames[index].c_str());
+            return;
+        }
+    }
+    clock.stop();
+    clock.reportRate(name, BENCHMARK_FS_LOOKUPS, 1000000.0, "M lookups/s");
+}
+
+// a directory the size of system32, looked up in random order with the case of each name scrambled
+void benchmarkIgnoreCase() {
+    BoxedPtr<FsNode> parent(NULL);
+    BoxedPtr<FsNode> dir = new FsFileNode(0, 0, "/benchmark", "", "", true, false, parent);
+    std::vector<std::string> names;
+    std::vector<std::string> mixedCaseNames;
+
+    for (U32 i = 0; i < BENCHMARK_FS_CHILDREN; i++) {
+        std::string name = "file" + std::to_string(i) + ".dll";
+        std::string mixedCaseName = name;
+
+        for (U32 j = 0; j < mixedCaseName.length(); j++) {
+            if (((i * 7 + j * 13) % 3) == 0) {
+                mixedCaseName[j] = (char)toupper(mixedCaseName[j]);
+            }
+        }
+        Fs::addFileNode(dir->path + "/" + name, "", "", false, dir);
+        names.push_back(name);
+        mixedCaseNames.push_back(mixedCaseName);
+    }
+    benchmarkChildLookup("exact lookup 5000 entries", dir, names, names, false);
+    benchmarkChildLookup("ignore case lookup 5000 entries", dir, names, mixedCaseNames, true);
+    if (dir->getChildByNameIgnoreCase("FILE.DLL")) {
+        benchmarkFailed("ignore case lookup", "found a child that doesn't exist");
+    }
+}
+
+#ifdef BOXEDWINE_ZLIB
+static U8 zipBenchmarkByte(U32 entry, U32 pos) {
+    U32 word = ((pos >> 4) + entry) * 2654435761u;
+    return (U8)("abcdefghijklmnopqrstuvwxyz012345"[word >> 27] + (pos & 3));
+}
+
+static bool createBenchmarkZip(const std::string& path) {
+    zipFile z = zipOpen(path.c_str(), APPEND_STATUS_CREATE);
+    std::vector<U8> data(BENCHMARK_ZIP_ENTRY_SIZE);
+
+    if (!z) {
+        return false;
+    }
+    for (U32 i = 0; i < BENCHMARK_ZIP_ENTRIES; i++) {
+        zip_fileinfo info;
+        std::string name = "dll" + std::to_string(i);
+
+        memset(&info, 0, sizeof(info));
+        for (U32 pos = 0; pos < BENCHMARK_ZIP_ENTRY_SIZE; pos++) {
+            data[pos] = zipBenchmarkByte(i, pos);
+        }
+        zipOpenNewFileInZip(z, name.c_str(), &info, NULL, 0, NULL, 0, NULL, Z_DEFLATED, Z_DEFAULT_COMPRESSION);
+        zipWriteInFileInZip(z, data.data(), BENCHMARK_ZIP_ENTRY_SIZE);
+        zipCloseFileInZip(z);
+    }
+    zipClose(z, NULL);
+    return true;
+}
+
+// reads the pages of some entries out of order, like a process would when its dlls fault in on demand
+static void readBenchmarkZipEntries(const std::string& mount, U32 thread, bool* failed) {
+    U8 page[K_PAGE_SIZE];
+    U32 pageCount = BENCHMARK_ZIP_ENTRY_SIZE / K_PAGE_SIZE;
+
+    for (U32 entry = thread; entry < BENCHMARK_ZIP_ENTRIES; entry += BENCHMARK_ZIP_THREADS) {
+        BoxedPtr<FsNode> node = Fs::getNodeFromLocalPath("", mount + "/dll" + std::to_string(entry), false);
+        FsOpenNode* openNode = node ? node->open(K_O_RDONLY) : NULL;
+
+        if (!openNode) {
+            *failed = true;
+            return;
+        }
+        for (U32 i = 0; i < pageCount; i++) {
+            U32 pageIndex = (i * 37) % pageCount;
+            openNode->seek(pageIndex * K_PAGE_SIZE);
+            if (openNode->readNative(page, K_PAGE_SIZE) != K_PAGE_SIZE || page[100] != zipBenchmarkByte(entry, pageIndex * K_PAGE_SIZE + 100)) {
+                *failed = true;
+                break;
+            }
+        }
+        openNode->close();
+        delete openNode;
+    }
+}
+
+static void benchmarkZipReaders(const std::string& zipPath, U32 readers) {
+    std::string mount = "/zipbenchmark" + std::to_string(readers);
+    std::string name = "zip startup " + std::to_string(BENCHMARK_ZIP_THREADS) + " threads " + std::to_string(readers) + " readers";
+    bool failed[BENCHMARK_ZIP_THREADS] = {false};
+    BenchmarkClock clock;
+
+    FsZip::maxReaders = readers;
+    std::shared_ptr<FsZip> fsZip = std::make_shared<FsZip>();
+    fsZip->init(zipPath, mount + "/");
+#ifdef BOXEDWINE_MULTI_THREADED
+    std::vector<std::thread> threads;
+    for (U32 i = 0; i < BENCHMARK_ZIP_THREADS; i++) {
+        threads.push_back(std::thread(readBenchmarkZipEntries, mount, i, &failed[i]));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+#else
+    readBenchmarkZipEntries(mount, 0, &failed[0]);
+#endif
+    clock.stop();
+    FsZip::maxReaders = 0;
+    for (U32 i = 0; i < BENCHMARK_ZIP_THREADS; i++) {
+        if (failed[i]) {
+            benchmarkFailed(name.c_str(), NULL);
+            return;
+        }
+    }
+    clock.reportTime(name.c_str());
+}
+
+// several processes starting at once, each loading dlls out of the same zip
+void benchmarkZip() {
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "boxedwineBenchmark";
+    std::string zipPath = (std::filesystem::temp_directory_path() / "boxedwineBenchmark.zip").string();
+
+    if (!createBenchmarkZip(zipPath)) {
+        benchmarkFailed("zip", "to create %s", zipPath.c_str());
+        return;
+    }
+    Fs::initFileSystem(root.string());
+    benchmarkZipReaders(zipPath, 1);
+    benchmarkZipReaders(zipPath, BENCHMARK_ZIP_THREADS);
+    std::filesystem::remove(zipPath);
+    std::filesystem::remove_all(root);
+}
+#endif
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef __TEST_BENCHMARK_FS_H__
+#define __TEST_BENCHMARK_FS_H__
+
+void benchmarkIgnoreCase();
+#ifdef BOXEDWINE_ZLIB
+void benchmarkZip();
+#endif
+
+#endif
@@ -0,0 +1,447 @@
+#include "boxedwine.h"
+
+#ifdef __TEST
+#include <stdio.h>
+
+#include "testCPU.h"
+#include "testBenchmark.h"
+#include "testBenchmarkKernel.h"
+#include "ksocket.h"
+#include "kepoll.h"
+#include "kvdso.h"
+#ifdef BOXEDWINE_MULTI_THREADED
+#include <thread>
+#endif
+
+#define BENCHMARK_EPOLL_PAIRS 400
+#define BENCHMARK_EPOLL_ITERATIONS 200000
+#define BENCHMARK_EPOLL_MAX_EVENTS 16
+
+#ifdef BOXEDWINE_MULTI_THREADED
+#define BENCHMARK_FD_THREADS 4
+#else
+#define BENCHMARK_FD_THREADS 1
+#endif
+#define BENCHMARK_FD_ITERATIONS 1000000
+
+#define BENCHMARK_TIMER_SLEEPERS 5000
+#define BENCHMARK_TIMER_SLICES 1000000
+#define BENCHMARK_TIMER_REARMS 1000000
+
+#define BENCHMARK_CLOCK_ITERATIONS 2000000
+
+void runTimers();
+U32 getNextTimer();
+
+// writes chunkSize bytes then reads them back, the same way a pipe between 2 processes would be used
+static void benchmarkStream(const char* name, U32 chunkSize) {
+    KProcess* process = KThread::currentThread()->process.get();
+    U32 socks = HEAP_ADDRESS;
+
+    if (ksocketpair(K_AF_UNIX, K_SOCK_STREAM, 0, socks, 0) != 0) {
+        benchmarkFailed(name, "to create socket pair");
+        return;
+    }
+    FD fd1 = readd(socks);
+    FD fd2 = readd(socks + 4);
+
+    // make sure the data makes it through intact, including wrapping around the end of the ring
+    for (U32 i = 0; i < 3; i++) {
+        U32 len = BENCHMARK_BUFFER_SIZE - 1000 * i - 7;
+        fillBenchmarkPattern(BENCHMARK_SRC_ADDRESS, len, i);
+        process->write(fd1, BENCHMARK_SRC_ADDRESS, len);
+        U32 count = 0;
+        while (count < len) {
+            count += process->read(fd2, BENCHMARK_DST_ADDRESS + count, len - count);
+        }
+        if (!checkBenchmarkPattern(BENCHMARK_DST_ADDRESS, len, i)) {
+            benchmarkFailed(name, "data did not match");
+            process->close(fd1);
+            process->close(fd2);
+            return;
+        }
+    }
+
+    BenchmarkClock clock;
+    U64 total = 0;
+    while (total < BENCHMARK_TOTAL_BYTES) {
+        process->write(fd1, BENCHMARK_SRC_ADDRESS, chunkSize);
+        U32 count = 0;
+        while (count < chunkSize) {
+            count += process->read(fd2, BENCHMARK_DST_ADDRESS, chunkSize - count);
+        }
+        total += chunkSize;
+    }
+    clock.stop();
+    clock.reportThroughput(name, total);
+    process->close(fd1);
+    process->close(fd2);
+}
+
+// pipe and pipe2 are socketpairs in this kernel, this is the size of write a pipe usually sees
+void benchmarkSocketPairLarge() {
+    benchmarkStream("socketpair 32KB writes", BENCHMARK_BUFFER_SIZE);
+}
+
+void benchmarkSocketPairSmall() {
+    // similar in size to a wineserver request
+    benchmarkStream("socketpair 64 byte writes", 64);
+}
+
+void benchmarkSocketPairMedium() {
+    benchmarkStream("socketpair 1KB writes", 1024);
+}
+
+static void setEPollEvent(U32 address, U32 events, U64 data) {
+    writed(address, events);
+    writeq(address + 4, data);
+}
+
+static bool checkEPollWait(const char* name, const char* test, FD epfd, U32 expectedCount, U64 expectedData) {
+    KProcess* process = KThread::currentThread()->process.get();
+    U32 count = process->epollwait(epfd, BENCHMARK_DST_ADDRESS, BENCHMARK_EPOLL_MAX_EVENTS, 0);
+
+    if (count != expectedCount || (count && readq(BENCHMARK_DST_ADDRESS + 4) != expectedData)) {
+        benchmarkFailed(name, "%s", test);
+        return false;
+    }
+    return true;
+}
+
+// one fd becomes ready at a time out of many registered ones, which is what the wineserver main loop looks like
+void benchmarkEPoll() {
+    const char* name = "epoll_wait 1 ready of 400 fds";
+    KProcess* process = KThread::currentThread()->process.get();
+    U32 socks = HEAP_ADDRESS;
+    U32 event = BENCHMARK_SRC_ADDRESS;
+    FD fds[BENCHMARK_EPOLL_PAIRS][2];
+    FD epfd = process->epollcreate(1, 0);
+    U32 i;
+
+    for (i = 0; i < BENCHMARK_EPOLL_PAIRS; i++) {
+        ksocketpair(K_AF_UNIX, K_SOCK_STREAM, 0, socks, 0);
+        fds[i][0] = readd(socks);
+        fds[i][1] = readd(socks + 4);
+        setEPollEvent(event, K_POLLIN, i);
+        process->epollctl(epfd, K_EPOLL_CTL_ADD, fds[i][1], event);
+    }
+
+    writeb(event + 12, 1);
+    if (!checkEPollWait(name, "nothing ready", epfd, 0, 0)) {
+        goto done;
+    }
+    // level triggered keeps reporting until the data is read
+    process->write(fds[7][0], event + 12, 1);
+    if (!checkEPollWait(name, "level triggered", epfd, 1, 7) || !checkEPollWait(name, "level triggered again", epfd, 1, 7)) {
+        goto done;
+    }
+    process->read(fds[7][1], event + 13, 1);
+    if (!checkEPollWait(name, "level triggered after read", epfd, 0, 0)) {
+        goto done;
+    }
+    // edge triggered only reports new data
+    setEPollEvent(event, K_POLLIN | K_EPOLLET, 8);
+    process->epollctl(epfd, K_EPOLL_CTL_MOD, fds[8][1], event);
+    process->write(fds[8][0], event + 12, 1);
+    if (!checkEPollWait(name, "edge triggered", epfd, 1, 8) || !checkEPollWait(name, "edge triggered again", epfd, 0, 0)) {
+        goto done;
+    }
+    process->write(fds[8][0], event + 12, 1);
+    if (!checkEPollWait(name, "edge triggered new data", epfd, 1, 8)) {
+        goto done;
+    }
+    process->read(fds[8][1], event + 13, 2);
+    // one shot is disabled after the first report until it is modified
+    setEPollEvent(event, K_POLLIN | K_EPOLLONESHOT, 9);
+    process->epollctl(epfd, K_EPOLL_CTL_MOD, fds[9][1], event);
+    process->write(fds[9][0], event + 12, 1);
+    if (!checkEPollWait(name, "one shot", epfd, 1, 9) || !checkEPollWait(name, "one shot again", epfd, 0, 0)) {
+        goto done;
+    }
+    process->epollctl(epfd, K_EPOLL_CTL_MOD, fds[9][1], event);
+    if (!checkEPollWait(name, "one shot re-armed", epfd, 1, 9)) {
+        goto done;
+    }
+    process->read(fds[9][1], event + 13, 1);
+    process->epollctl(epfd, K_EPOLL_CTL_DEL, fds[9][1], 0);
+    // closing an fd drops its entry, so the number can be added again once it is reused
+    process->close(fds[10][0]);
+    process->close(fds[10][1]);
+    ksocketpair(K_AF_UNIX, K_SOCK_STREAM, 0, socks, 0);
+    fds[10][0] = readd(socks);
+    fds[10][1] = readd(socks + 4);
+    setEPollEvent(event, K_POLLIN, 10);
+    if (process->epollctl(epfd, K_EPOLL_CTL_ADD, fds[10][1], event) != 0) {
+        benchmarkFailed(name, "could not add a reused fd");
+        goto done;
+    }
+    process->write(fds[10][0], event + 12, 1);
+    if (!checkEPollWait(name, "reused fd", epfd, 1, 10)) {
+        goto done;
+    }
+    process->read(fds[10][1], event + 13, 1);
+
+    {
+        BenchmarkClock clock;
+        for (i = 0; i < BENCHMARK_EPOLL_ITERATIONS; i++) {
+            U32 index = (i * 7) % BENCHMARK_EPOLL_PAIRS;
+            if (index == 9) {
+                index = 10;
+            }
+            process->write(fds[index][0], event + 12, 1);
+            if (process->epollwait(epfd, BENCHMARK_DST_ADDRESS, BENCHMARK_EPOLL_MAX_EVENTS, 0) != 1) {
+                benchmarkFailed(name, "wrong event count");
+                goto done;
+            }
+            process->read(fds[index][1], event + 13, 1);
+        }
+        clock.stop();
+        clock.reportRate(name, BENCHMARK_EPOLL_ITERATIONS, 1000.0, "K waits/s");
+    }
+done:
+    for (i = 0; i < BENCHMARK_EPOLL_PAIRS; i++) {
+        process->close(fds[i][0]);
+        process->close(fds[i][1]);
+    }
+    process->close(epfd);
+}
+
+// the fd lookup and checks that every fd syscall starts with, the KObjects aren't used since these threads aren't KThreads
+static void lookupBenchmarkFds(KProcess* process, FD writeFd, FD readFd, KObject* writeObject, KObject* readObject, bool* failed) {
+    for (U32 i = 0; i < BENCHMARK_FD_ITERATIONS; i++) {
+        KFileDescriptor* fd = process->getFileDescriptor(writeFd);
+        if (!fd || !fd->canWrite() || fd->kobject.get() != writeObject) {
+            *failed = true;
+            return;
+        }
+        fd = process->getFileDescriptor(readFd);
+        if (!fd || !fd->canRead() || fd->kobject.get() != readObject) {
+            *failed = true;
+            return;
+        }
+    }
+}
+
+void benchmarkFdTable() {
+    KProcess* process = KThread::currentThread()->process.get();
+    std::string name = "fd lookup " + std::to_string(BENCHMARK_FD_THREADS) + " threads";
+    FD fds[BENCHMARK_FD_THREADS * 2];
+    bool failed[BENCHMARK_FD_THREADS] = {false};
+
+    for (U32 i = 0; i < BENCHMARK_FD_THREADS; i++) {
+        if (ksocketpair(K_AF_UNIX, K_SOCK_STREAM, 0, HEAP_ADDRESS, 0) != 0) {
+            benchmarkFailed(name.c_str(), "to create socket pair");
+            return;
+        }
+        fds[i * 2] = readd(HEAP_ADDRESS);
+        fds[i * 2 + 1] = readd(HEAP_ADDRESS + 4);
+    }
+
+    // dup to a handle past the end of the table so that it has to grow, then make sure everything is still there
+    FD high = KPROCESS_INITIAL_FDS * 4 + 3;
+    if (process->dup2(fds[0], high) != (U32)high || !process->getFileDescriptor(high) || process->getFileDescriptor(high)->kobject != process->getFileDescriptor(fds[0])->kobject || process->getFileDescriptor(high + 1) || process->getFileDescriptor(-1) || process->dup2(fds[0], MAX_NUMBER_OF_FILES) != (U32)-K_EBADF) {
+        benchmarkFailed(name.c_str(), "fd table lookup");
+        return;
+    }
+    for (U32 i = 0; i < BENCHMARK_FD_THREADS * 2; i++) {
+        if (!process->getFileDescriptor(fds[i]) || process->getFileDescriptor(fds[i])->handle != (U32)fds[i]) {
+            benchmarkFailed(name.c_str(), "fd table grow");
+            return;
+        }
+    }
+    process->close(high);
+    if (process->getFileDescriptor(high)) {
+        benchmarkFailed(name.c_str(), "fd table close");
+        return;
+    }
+
+    // once every handle below MAX_NUMBER_OF_FILES is used, new ones fail instead of growing the table past it
+    std::vector<FD> dups;
+    U32 dupResult = 0;
+    for (U32 i = 0; i < MAX_NUMBER_OF_FILES; i++) {
+        dupResult = process->dup(fds[0]);
+        if ((S32)dupResult < 0) {
+            break;
+        }
+        dups.push_back(dupResult);
+    }
+    bool full = dupResult == (U32)-K_EMFILE && !dups.empty() && dups.back() == MAX_NUMBER_OF_FILES - 1 && process->fcntrl(fds[0], K_F_DUPFD, 0) == (U32)-K_EMFILE && ksocket(K_AF_UNIX, K_SOCK_STREAM, 0) == (U32)-K_EMFILE;
+    for (FD d : dups) {
+        process->close(d);
+    }
+    if (!full || process->getFileDescriptor(MAX_NUMBER_OF_FILES - 1)) {
+        benchmarkFailed(name.c_str(), "fd table full");
+        return;
+    }
+
+    BenchmarkClock clock;
+#ifdef BOXEDWINE_MULTI_THREADED
+    std::vector<std::thread> threads;
+    for (U32 i = 0; i < BENCHMARK_FD_THREADS; i++) {
+        KObject* writeObject = process->getFileDescriptor(fds[i * 2])->kobject.get();
+        KObject* readObject = process->getFileDescriptor(fds[i * 2 + 1])->kobject.get();
+        threads.push_back(std::thread(lookupBenchmarkFds, process, fds[i * 2], fds[i * 2 + 1], writeObject, readObject, &failed[i]));
+    }
+    // change the table while the other threads read it
+    for (U32 i = 0; i < BENCHMARK_FD_ITERATIONS / 100; i++) {
+        process->close(process->dup(fds[0]));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+#else
+    lookupBenchmarkFds(process, fds[0], fds[1], process->getFileDescriptor(fds[0])->kobject.get(), process->getFileDescriptor(fds[1])->kobject.get(), &failed[0]);
+#endif
+    clock.stop();
+    for (U32 i = 0; i < BENCHMARK_FD_THREADS * 2; i++) {
+        process->close(fds[i]);
+    }
+    for (U32 i = 0; i < BENCHMARK_FD_THREADS; i++) {
+        if (failed[i]) {
+            benchmarkFailed(name.c_str(), NULL);
+            return;
+        }
+    }
+    clock.reportRate(name.c_str(), (double)BENCHMARK_FD_THREADS * BENCHMARK_FD_ITERATIONS * 2, 1000000.0, "M lookups/s");
+}
+
+class BenchmarkTimer : public KTimer {
+public:
+    BenchmarkTimer() : fired(0) {}
+    bool run() {
+        fired++;
+        return true;
+    }
+
+    U32 fired;
+};
+
+static U32 getBenchmarkTimerMillies(U32 now, U32 i) {
+    return now + 60000 + (i * 7919) % 60000;
+}
+
+// every pending nanosleep, futex or poll timeout is a timer, the scheduler looks for the next one each slice
+void benchmarkTimers() {
+    std::string name = "timers " + std::to_string(BENCHMARK_TIMER_SLEEPERS) + " sleepers";
+    std::vector<BenchmarkTimer> sleepers(BENCHMARK_TIMER_SLEEPERS);
+    U32 now = KSystem::getMilliesSinceStart();
+
+    for (U32 i = 0; i < BENCHMARK_TIMER_SLEEPERS; i++) {
+        sleepers[i].millies = getBenchmarkTimerMillies(now, i);
+        addTimer(&sleepers[i]);
+    }
+
+    BenchmarkClock sliceClock;
+    U64 next = 0;
+    for (U32 i = 0; i < BENCHMARK_TIMER_SLICES; i++) {
+        runTimers();
+        next += getNextTimer();
+    }
+    sliceClock.stop();
+
+    // a sleeper that wakes up early and goes back to sleep
+    BenchmarkClock rearmClock;
+    for (U32 i = 0; i < BENCHMARK_TIMER_REARMS; i++) {
+        KTimer* timer = &sleepers[(i * 31) % BENCHMARK_TIMER_SLEEPERS];
+        removeTimer(timer);
+        timer->millies = getBenchmarkTimerMillies(now, i);
+        addTimer(timer);
+    }
+    rearmClock.stop();
+
+    U32 first = 0xFFFFFFFF;
+    for (auto& sleeper : sleepers) {
+        if (sleeper.millies < first) {
+            first = sleeper.millies;
+        }
+    }
+    U32 before = KSystem::getMilliesSinceStart();
+    U32 nextTimer = getNextTimer();
+    U32 after = KSystem::getMilliesSinceStart();
+    bool failed = nextTimer > first - before || nextTimer < first - after;
+
+    // half of them are due, only those should run and be removed
+    for (U32 i = 0; i < BENCHMARK_TIMER_SLEEPERS; i += 2) {
+        sleepers[i].millies = 0;
+        addTimer(&sleepers[i]);
+    }
+    runTimers();
+    for (U32 i = 0; i < BENCHMARK_TIMER_SLEEPERS; i++) {
+        bool due = (i & 1) == 0;
+        if (sleepers[i].fired != (due ? 1u : 0u) || sleepers[i].active == due) {
+            failed = true;
+        }
+        removeTimer(&sleepers[i]);
+    }
+    if (failed || next == 0 || getNextTimer() != 0xFFFFFFFF) {
+        benchmarkFailed(name.c_str(), NULL);
+        return;
+    }
+    sliceClock.reportRate(name.c_str(), BENCHMARK_TIMER_SLICES, 1000000.0, "M slices/s");
+    rearmClock.reportRate(name.c_str(), BENCHMARK_TIMER_REARMS, 1000000.0, "M rearms/s");
+}
+
+#ifdef BOXEDWINE_VDSO
+// clock_gettime(CLOCK_MONOTONIC) in a guest loop, either with int 0x80 or by calling the vDSO like libc does
+static void benchmarkClockGettime(const char* name, bool vdso) {
+    U32 tp = HEAP_ADDRESS;
+
+    cpu->big = true;
+    newInstruction(0);
+    cpu->seg[DS].address = 0;
+    pushCode8(0xbe); // mov esi, BENCHMARK_CLOCK_ITERATIONS
+    pushCode32(BENCHMARK_CLOCK_ITERATIONS);
+    if (vdso) {
+        KVdso::map(cpu->thread->process->memory);
+        pushCode8(0x68); // 5: push tp
+        pushCode32(tp);
+        pushCode8(0x6a); // push 1
+        pushCode8(0x01);
+        pushCode8(0xe8); // call __vdso_clock_gettime
+        pushCode32(KVdso::getFunctionAddress("__vdso_clock_gettime") - CODE_ADDRESS - 17);
+        pushCode8(0x83); // add esp, 8
+        pushCode8(0xc4);
+        pushCode8(0x08);
+        pushCode8(0x4e); // dec esi
+        pushCode8(0x75); // jnz 5
+        pushCode8((U8)(5 - 23));
+    } else {
+        pushCode8(0xb8); // 5: mov eax, 265 (__NR_clock_gettime)
+        pushCode32(265);
+        pushCode8(0xbb); // mov ebx, 1
+        pushCode32(1);
+        pushCode8(0xb9); // mov ecx, tp
+        pushCode32(tp);
+        pushCode8(0xcd); // int 0x80
+        pushCode8(0x80);
+        pushCode8(0x4e); // dec esi
+        pushCode8(0x75); // jnz 5
+        pushCode8((U8)(5 - 25));
+    }
+    pushCode8(0x70); // jo, stops the benchmark
+    pushCode8(0);
+    pushCode8(0x70);
+    pushCode8(0);
+    writed(tp + 4, 0xffffffff);
+
+    BenchmarkClock clock;
+    cpu->nextBlock = cpu->getNextBlock();
+    while (cpu->nextBlock->op->inst != JumpO) {
+        cpu->run();
+    }
+    clock.stop();
+
+    if (ESI != 0 || EAX != 0 || ESP != 4096 || readd(tp + 4) >= 1000000000) {
+        benchmarkFailed(name, "esi=%X eax=%X esp=%X", ESI, EAX, ESP);
+        return;
+    }
+    clock.reportRate(name, BENCHMARK_CLOCK_ITERATIONS, 1000000.0, "M calls/s");
+}
+
+void benchmarkVdso() {
+    benchmarkClockGettime("clock_gettime syscall", false);
+    benchmarkClockGettime("clock_gettime vdso", true);
+}
+#endif
+
+#endif
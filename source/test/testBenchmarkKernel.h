@@ -0,0 +1,14 @@
+#ifndef __TEST_BENCHMARK_KERNEL_H__
+#define __TEST_BENCHMARK_KERNEL_H__
+
+void benchmarkSocketPairLarge();
+void benchmarkSocketPairSmall();
+void benchmarkSocketPairMedium();
+void benchmarkEPoll();
+void benchmarkFdTable();
+void benchmarkTimers();
+#ifdef BOXEDWINE_VDSO
+void benchmarkVdso();
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+#include "boxedwine.h"
+
+#if defined(__TEST) && defined(BOXEDWINE_VULKAN)
+#include <stdio.h>
+
+#include "testCPU.h"
+#include "testBenchmark.h"
+#include "testBenchmarkVulkan.h"
+#include "../vulkan/vk_host_marshal.h"
+
+#define BENCHMARK_VULKAN_COMMANDS 100
+#define BENCHMARK_VULKAN_COPY_REGIONS 4
+#define BENCHMARK_VULKAN_ITERATIONS 100000
+
+// guest sizes, a render pass begin, an image barrier and the buffer copy regions
+#define BENCHMARK_VULKAN_COMMAND_SIZE (48 + 60 + 32 * BENCHMARK_VULKAN_COPY_REGIONS)
+
+struct VulkanBenchmarkCommand {
+    VkRenderPassBeginInfo renderPass;
+    VkImageMemoryBarrier barrier;
+    VkBufferCopy2KHR regions[BENCHMARK_VULKAN_COPY_REGIONS];
+};
+
+static void writeVulkanBenchmarkCommand(U32 address, U32 seed) {
+    writed(address, VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO); address += 4;
+    writed(address, 0); address += 4; // pNext
+    writeq(address, 0x100000000ull + seed); address += 8; // renderPass
+    writeq(address, 0x200000000ull + seed); address += 8; // framebuffer
+    writed(address, seed); writed(address + 4, seed + 1); writed(address + 8, 640); writed(address + 12, 480); address += 16; // renderArea
+    writed(address, 0); address += 4; // clearValueCount
+    writed(address, 0); address += 4; // pClearValues
+
+    writed(address, VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER); address += 4;
+    writed(address, 0); address += 4; // pNext
+    for (U32 i = 0; i < 6; i++) {
+        writed(address, seed + i); address += 4; // access masks, layouts and queue family indexes
+    }
+    writeq(address, 0x300000000ull + seed); address += 8; // image
+    for (U32 i = 0; i < 5; i++) {
+        writed(address, i); address += 4; // subresourceRange
+    }
+
+    for (U32 i = 0; i < BENCHMARK_VULKAN_COPY_REGIONS; i++) {
+        writed(address, VK_STRUCTURE_TYPE_BUFFER_COPY_2_KHR); address += 4;
+        writed(address, 0); address += 4; // pNext
+        writeq(address, seed * 64 + i); address += 8;
+        writeq(address, seed * 128 + i); address += 8;
+        writeq(address, 256); address += 8;
+    }
+}
+
+// what the generator emitted before it grouped members into runs, the result must match the real read functions
+static U32 readVulkanBenchmarkCommandFields(U32 address, VulkanBenchmarkCommand* cmd) {
+    VkRenderPassBeginInfo* s = &cmd->renderPass;
+    s->sType = (VkStructureType)readd(address);address+=4;
+    U32 paramAddress = readd(address);address+=4;
+    s->pNext = paramAddress ? getPhysicalAddress(paramAddress, 0) : NULL;
+    s->renderPass = (VkRenderPass)readq(address);address+=8;
+    s->framebuffer = (VkFramebuffer)readq(address);address+=8;
+    memcopyToNative(address, &s->renderArea, 16);address+=16;
+    s->clearValueCount = (uint32_t)readd(address);address+=4;
+    paramAddress = readd(address);address+=4;
+    s->pClearValues = paramAddress ? (VkClearValue*)getPhysicalAddress(paramAddress, s->clearValueCount * sizeof(VkClearValue)) : NULL;
+
+    VkImageMemoryBarrier* b = &cmd->barrier;
+    b->sType = (VkStructureType)readd(address);address+=4;
+    paramAddress = readd(address);address+=4;
+    b->pNext = paramAddress ? getPhysicalAddress(paramAddress, 0) : NULL;
+    b->srcAccessMask = (VkAccessFlags)readd(address);address+=4;
+    b->dstAccessMask = (VkAccessFlags)readd(address);address+=4;
+    b->oldLayout = (VkImageLayout)readd(address);address+=4;
+    b->newLayout = (VkImageLayout)readd(address);address+=4;
+    b->srcQueueFamilyIndex = (uint32_t)readd(address);address+=4;
+    b->dstQueueFamilyIndex = (uint32_t)readd(address);address+=4;
+    b->image = (VkImage)readq(address);address+=8;
+    memcopyToNative(address, &b->subresourceRange, 20);address+=20;
+
+    for (U32 i = 0; i < BENCHMARK_VULKAN_COPY_REGIONS; i++) {
+        VkBufferCopy2KHR* r = &cmd->regions[i];
+        r->sType = (VkStructureType)readd(address);address+=4;
+        paramAddress = readd(address);address+=4;
+        r->pNext = paramAddress ? getPhysicalAddress(paramAddress, 0) : NULL;
+        r->srcOffset = (VkDeviceSize)readq(address);address+=8;
+        r->dstOffset = (VkDeviceSize)readq(address);address+=8;
+        r->size = (VkDeviceSize)readq(address);address+=8;
+    }
+    return address;
+}
+
+static U32 readVulkanBenchmarkCommandMarshal(U32 address, VulkanBenchmarkCommand* cmd) {
+    MarshalVkRenderPassBeginInfo::read(address, &cmd->renderPass);address+=48;
+    MarshalVkImageMemoryBarrier::read(address, &cmd->barrier);address+=60;
+    for (U32 i = 0; i < BENCHMARK_VULKAN_COPY_REGIONS; i++) {
+        MarshalVkBufferCopy2KHR::read(address, &cmd->regions[i]);address+=32;
+    }
+    return address;
+}
+
+static void benchmarkVulkanRecord(const char* name, U32 (*readCommand)(U32 address, VulkanBenchmarkCommand* cmd), VulkanBenchmarkCommand* cmds) {
+    BenchmarkClock clock;
+    for (U32 i = 0; i < BENCHMARK_VULKAN_ITERATIONS; i++) {
+        U32 address = BENCHMARK_SRC_ADDRESS;
+        for (U32 c = 0; c < BENCHMARK_VULKAN_COMMANDS; c++) {
+            address = readCommand(address, &cmds[c]);
+        }
+    }
+    clock.stop();
+    clock.reportRate(name, (double)BENCHMARK_VULKAN_ITERATIONS * BENCHMARK_VULKAN_COMMANDS, 1000000.0, "M commands/s");
+}
+
+void benchmarkVulkanMarshal() {
+    static_assert(BENCHMARK_VULKAN_COMMANDS * BENCHMARK_VULKAN_COMMAND_SIZE <= BENCHMARK_BUFFER_SIZE, "commands don't fit in the benchmark buffer");
+    std::vector<VulkanBenchmarkCommand> fields(BENCHMARK_VULKAN_COMMANDS);
+    std::vector<VulkanBenchmarkCommand> marshal(BENCHMARK_VULKAN_COMMANDS);
+
+    for (U32 c = 0; c < BENCHMARK_VULKAN_COMMANDS; c++) {
+        writeVulkanBenchmarkCommand(BENCHMARK_SRC_ADDRESS + c * BENCHMARK_VULKAN_COMMAND_SIZE, c);
+    }
+    // the padding is compared too
+    memset(fields.data(), 0, fields.size() * sizeof(VulkanBenchmarkCommand));
+    memset(marshal.data(), 0, marshal.size() * sizeof(VulkanBenchmarkCommand));
+    benchmarkVulkanRecord("vulkan record field by field", readVulkanBenchmarkCommandFields, fields.data());
+    benchmarkVulkanRecord("vulkan record vk_host marshal", readVulkanBenchmarkCommandMarshal, marshal.data());
+    if (memcmp(fields.data(), marshal.data(), fields.size() * sizeof(VulkanBenchmarkCommand))) {
+        benchmarkFailed("vulkan record", "commands did not match");
+    }
+}
+
+#endif
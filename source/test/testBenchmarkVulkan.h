@@ -0,0 +1,8 @@
+#ifndef __TEST_BENCHMARK_VULKAN_H__
+#define __TEST_BENCHMARK_VULKAN_H__
+
+#ifdef BOXEDWINE_VULKAN
+void benchmarkVulkanMarshal();
+#endif
+
+#endif
@@ -34,6 +34,8 @@
 #include "testMMX.h"
 #include "testSSE.h"
 #include "testSSE2.h"
+#include "testBenchmark.h"
+#include "kvdso.h"
 
 static int cseip;
 
@@ -4678,6 +4680,396 @@ void testScasd0x2af() {
     strTest(4, 0xf3, 0xaf, DF, NULL, 0, "1234123412341235", 16, 0x00000010, 0x00000020, 0x00000010, 0x00000010, 0x00000010, 0x0000000C, true, true, false, HEAP_ADDRESS + 256, 0x31323334);
 }
 
+// long REP string ops are done a page at a time on host memory, these cross pages and overlap
+void testRepStringPages() {
+    cpu->big = true;
+
+    // movsb with EDI one past ESI repeats the first byte, memmove would shift the data instead
+    newInstruction(0xf3, 0);
+    pushCode8(0xa4);
+    cpu->seg[ES].address = HEAP_ADDRESS;
+    for (U32 i = 0; i <= 6000; i++) {
+        writeb(HEAP_ADDRESS + 100 + i, (U8)(i + 0x55));
+    }
+    ESI = 100;
+    EDI = 101;
+    ECX = 6000;
+    runTestCPU();
+    assertTrue(ECX == 0 && ESI == 6100 && EDI == 6101);
+    for (U32 i = 0; i <= 6000; i++) {
+        if (readb(HEAP_ADDRESS + 100 + i) != 0x55) {
+            assertTrue(false);
+            break;
+        }
+    }
+
+    // the same thing going down (DF)
+    newInstruction(0xf3, DF);
+    pushCode8(0xa4);
+    cpu->seg[ES].address = HEAP_ADDRESS;
+    writeb(HEAP_ADDRESS + 7000, 0xAA);
+    ESI = 7000;
+    EDI = 6999;
+    ECX = 5000;
+    runTestCPU();
+    assertTrue(ECX == 0 && ESI == 2000 && EDI == 1999);
+    for (U32 i = 2000; i <= 7000; i++) {
+        if (readb(HEAP_ADDRESS + i) != 0xAA) {
+            assertTrue(false);
+            break;
+        }
+    }
+
+    // movsd (DF) without overlap
+    newInstruction(0xf3, DF);
+    pushCode8(0xa5);
+    cpu->seg[ES].address = HEAP_ADDRESS;
+    for (U32 i = 0; i < 2000; i++) {
+        writed(HEAP_ADDRESS + 0x2000 + i * 4, i);
+    }
+    ESI = 0x2000 + 1999 * 4;
+    EDI = 0x8000 + 1999 * 4;
+    ECX = 2000;
+    runTestCPU();
+    assertTrue(ECX == 0 && ESI == 0x1FFC && EDI == 0x7FFC);
+    for (U32 i = 0; i < 2000; i++) {
+        if (readd(HEAP_ADDRESS + 0x8000 + i * 4) != i) {
+            assertTrue(false);
+            break;
+        }
+    }
+
+    // stosw where the first element straddles a page
+    newInstruction(0xf3, 0);
+    pushCode8(0x66);
+    pushCode8(0xab);
+    cpu->seg[ES].address = HEAP_ADDRESS;
+    EAX = 0x1234;
+    EDI = 0xFFF;
+    ECX = 3000;
+    runTestCPU();
+    assertTrue(ECX == 0 && EDI == 0xFFF + 6000);
+    assertTrue(readw(HEAP_ADDRESS + 0xFFF) == 0x1234);
+    assertTrue(readw(HEAP_ADDRESS + 0x1FFF) == 0x1234);
+    assertTrue(readw(HEAP_ADDRESS + 0xFFF + 5998) == 0x1234);
+
+    // repnz scasb that finds the byte on the second page
+    newInstruction(0xf2, 0);
+    pushCode8(0xae);
+    cpu->seg[ES].address = HEAP_ADDRESS;
+    for (U32 i = 0; i < 6000; i++) {
+        writeb(HEAP_ADDRESS + 0x1000 + i, 1);
+    }
+    writeb(HEAP_ADDRESS + 0x1000 + 5000, 0);
+    EAX = 0;
+    EDI = 0x1000;
+    ECX = 6000;
+    runTestCPU();
+    assertTrue(ECX == 999 && EDI == 0x1000 + 5001);
+    assertTrue(cpu->getZF() != 0);
+
+    // repz cmpsb that finds the difference on the second page
+    newInstruction(0xf3, 0);
+    pushCode8(0xa6);
+    cpu->seg[ES].address = HEAP_ADDRESS;
+    for (U32 i = 0; i < 6000; i++) {
+        writeb(HEAP_ADDRESS + 0x2000 + i, (U8)i);
+        writeb(HEAP_ADDRESS + 0x6000 + i, (U8)i);
+    }
+    writeb(HEAP_ADDRESS + 0x6000 + 4500, 0xFF);
+    ESI = 0x2000;
+    EDI = 0x6000;
+    ECX = 6000;
+    runTestCPU();
+    assertTrue(ECX == 6000 - 4501 && ESI == 0x2000 + 4501 && EDI == 0x6000 + 4501);
+    assertTrue(cpu->getZF() == 0);
+    cpu->seg[ES].address = 0;
+}
+
+// the decoder reads the page a block starts on from host memory, the mov's immediate is split across 2 pages
+void testDecodeAcrossPages() {
+    cpu->big = true;
+    newInstruction(0);
+    while ((U32)cseip < CODE_ADDRESS + K_PAGE_SIZE - 3) {
+        pushCode8(0x90); // nop
+    }
+    pushCode8(0xb8); // mov eax, 0x12345678
+    pushCode32(0x12345678);
+    pushCode8(0x05); // add eax, 0x11111111
+    pushCode32(0x11111111);
+    EAX = 0;
+    runTestCPU();
+    assertTrue(EAX == 0x23456789);
+}
+
+// the normal core fuses these pairs into one op, make sure that happened or the tests below only cover the ops the
+// pair was made from
+static void assertFused(U32 inst) {
+#ifndef BOXEDWINE_BINARY_TRANSLATOR
+    bool found = false;
+    DecodedBlock* block = memory->getCodeBlock(CODE_ADDRESS);
+
+    for (DecodedOp* op = block ? block->op : NULL; op; op = op->next) {
+        if (op->inst == inst) {
+            found = true;
+        }
+    }
+    assertTrue(found);
+#endif
+}
+
+static bool isConditionTrue(U32 cc, bool cf, bool zf, bool sf, bool of, bool pf) {
+    bool result;
+
+    switch (cc >> 1) {
+    case 0: result = of; break;
+    case 1: result = cf; break;
+    case 2: result = zf; break;
+    case 3: result = cf || zf; break;
+    case 4: result = sf; break;
+    case 5: result = pf; break;
+    case 6: result = sf != of; break;
+    default: result = zf || sf != of; break;
+    }
+    return (cc & 1) ? !result : result;
+}
+
+static bool hasEvenParity(U32 value) {
+    U32 bits = 0;
+
+    for (U32 i = 0; i < 8; i++) {
+        bits += (value >> i) & 1;
+    }
+    return (bits & 1) == 0;
+}
+
+// between them every condition is both true and false
+static const U32 fusedJccOperands[][2] = {
+    {0, 0}, {1, 2}, {2, 1}, {0x80000000, 1}, {0x7FFFFFFF, 0xFFFFFFFF}, {0xFFFFFFFF, 1}, {3, 0x10}
+};
+
+// isTest selects test eax, ecx, otherwise it is cmp eax, ecx or cmp eax, imm32 if isImm
+static void doFusedJcc(bool isTest, bool isImm, U32 fusedInst) {
+    cpu->big = true;
+    for (U32 cc = 0; cc < 16; cc++) {
+        for (U32 i = 0; i < sizeof(fusedJccOperands) / sizeof(fusedJccOperands[0]); i++) {
+            U32 a = fusedJccOperands[i][0];
+            U32 b = fusedJccOperands[i][1];
+            U32 result = isTest ? (a & b) : (a - b);
+            bool cf = !isTest && a < b;
+            bool of = !isTest && (((a ^ b) & (a ^ result)) & 0x80000000) != 0;
+            bool zf = result == 0;
+            bool sf = (result & 0x80000000) != 0;
+            bool pf = hasEvenParity(result);
+
+            newInstruction(0);
+            if (isTest) {
+                pushCode8(0x85); // test eax, ecx
+                pushCode8(0xc8);
+            } else if (isImm) {
+                pushCode8(0x81); // cmp eax, imm32
+                pushCode8(0xf8);
+                pushCode32(b);
+            } else {
+                pushCode8(0x39); // cmp eax, ecx
+                pushCode8(0xc8);
+            }
+            pushCode8(0x70 + cc); // jcc
+            pushCode8(2); // jump over mov dl, 1
+            pushCode8(0xb2); // mov dl, 1 doesn't change the flags
+            pushCode8(1);
+            EAX = a;
+            ECX = b;
+            runTestCPU();
+            assertFused(fusedInst);
+            // if the condition was true, then EDX should be 0 because we jump over mov dl, 1
+            assertTrue(EDX == (isConditionTrue(cc, cf, zf, sf, of, pf) ? 0u : 1u));
+            assertTrue(EAX == a && ECX == b);
+            assertTrue((cpu->getCF() != 0) == cf && (cpu->getZF() != 0) == zf && (cpu->getSF() != 0) == sf && (cpu->getOF() != 0) == of && (cpu->getPF() != 0) == pf);
+        }
+    }
+}
+
+void testFusedCmpR32R32Jcc() {
+    doFusedJcc(false, false, CmpR32R32Jcc);
+}
+
+void testFusedCmpR32I32Jcc() {
+    doFusedJcc(false, true, CmpR32I32Jcc);
+}
+
+void testFusedTestR32R32Jcc() {
+    doFusedJcc(true, false, TestR32R32Jcc);
+}
+
+void testFusedDecJnz() {
+    cpu->big = true;
+
+    // loop until ecx is 0, dec leaves CF alone
+    newInstruction(CF);
+    pushCode8(0x42); // inc edx
+    pushCode8(0x49); // dec ecx
+    pushCode8(0x75); // jnz back to inc edx
+    pushCode8(0xfc);
+    ECX = 5;
+    runTestCPU();
+    assertFused(DecR32Jnz);
+    assertTrue(EDX == 5 && ECX == 0);
+    assertTrue(cpu->getZF() && !cpu->getSF() && !cpu->getOF() && cpu->getCF());
+
+    for (U32 i = 0; i < 2; i++) {
+        newInstruction(0);
+        pushCode8(0x49); // dec ecx
+        pushCode8(0x75); // jnz
+        pushCode8(2); // jump over mov dl, 1
+        pushCode8(0xb2); // mov dl, 1
+        pushCode8(1);
+        ECX = i ? 0x80000000 : 1;
+        runTestCPU();
+        assertFused(DecR32Jnz);
+        if (i) {
+            assertTrue(EDX == 0 && ECX == 0x7FFFFFFF);
+            assertTrue(!cpu->getZF() && !cpu->getSF() && cpu->getOF() && !cpu->getCF());
+        } else {
+            assertTrue(EDX == 1 && ECX == 0);
+            assertTrue(cpu->getZF() && !cpu->getSF() && !cpu->getOF() && !cpu->getCF());
+        }
+    }
+}
+
+void testFusedPushEbpMovEbpEsp() {
+    cpu->big = true;
+
+    // both encodings of mov ebp, esp
+    for (U32 i = 0; i < 2; i++) {
+        newInstruction(0);
+        pushCode8(0x55); // push ebp
+        if (i) {
+            pushCode8(0x8b);
+            pushCode8(0xec);
+        } else {
+            pushCode8(0x89);
+            pushCode8(0xe5);
+        }
+        EBP = 0x12345678;
+        runTestCPU();
+        assertFused(PushEbpMovEbpEsp);
+        assertTrue(ESP == 4092 && EBP == 4092);
+        assertTrue(readd(cpu->seg[SS].address + 4092) == 0x12345678);
+    }
+}
+
+void testFusedMovAdd() {
+    // memory, imm, result
+    static const U32 values[][3] = {
+        {0xFFFFFFFF, 1, 0}, {0x7FFFFFFF, 1, 0x80000000}, {0x10, 0x20, 0x30}
+    };
+    cpu->big = true;
+
+    for (U32 i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        U32 value = values[i][0];
+        U32 imm = values[i][1];
+        U32 result = values[i][2];
+        bool cf = result < value;
+        bool of = ((~(value ^ imm) & (value ^ result)) & 0x80000000) != 0;
+
+        for (U32 flagsLive = 0; flagsLive < 2; flagsLive++) {
+            newInstruction(0);
+            pushCode8(0x8b); // mov eax, [ebx]
+            pushCode8(0x03);
+            pushCode8(0x81); // add eax, imm32
+            pushCode8(0xc0);
+            pushCode32(imm);
+            if (!flagsLive) {
+                pushCode8(0x39); // cmp ecx, edx overwrites the add's flags before anything reads them
+                pushCode8(0xd1);
+                ECX = 1;
+                EDX = 2;
+            }
+            EBX = 0x100;
+            writed(HEAP_ADDRESS + 0x100, value);
+            runTestCPU();
+            assertTrue(EAX == result);
+            if (flagsLive) {
+                // the flags are still live at the end of the block
+                assertFused(MovR32E32AddR32I32);
+                assertTrue((cpu->getCF() != 0) == cf && (cpu->getOF() != 0) == of && (cpu->getZF() != 0) == (result == 0) && (cpu->getSF() != 0) == ((result & 0x80000000) != 0));
+            } else {
+                assertFused(MovR32E32AddR32I32NoFlags);
+                assertTrue(cpu->getCF() && cpu->getSF() && !cpu->getZF() && !cpu->getOF());
+            }
+        }
+    }
+}
+
+#ifdef BOXEDWINE_VDSO
+// the guest can be up to 1ms ahead of the host clock and the test might be slow
+#define VDSO_TEST_TOLERANCE 100000
+
+// calls a vDSO function the way libc would, CS is based at CODE_ADDRESS so the call is relative to that
+static void callVdso(const char* name, U32 arg1, U32 arg2) {
+    cpu->big = true;
+    newInstruction(0);
+    cpu->seg[DS].address = 0;
+    pushCode8(0x68); // push arg2
+    pushCode32(arg2);
+    pushCode8(0x68); // push arg1
+    pushCode32(arg1);
+    pushCode8(0xe8); // call
+    pushCode32(KVdso::getFunctionAddress(name) - CODE_ADDRESS - 15);
+    pushCode8(0x83); // add esp, 8
+    pushCode8(0xc4);
+    pushCode8(0x08);
+    runTestCPU();
+}
+
+static bool isNearHost(U64 guest, U64 host) {
+    return guest <= host + VDSO_TEST_TOLERANCE && guest + VDSO_TEST_TOLERANCE >= host;
+}
+
+void testVdso() {
+    U32 tp = HEAP_ADDRESS + 0x100;
+
+    KVdso::map(memory);
+    KVdso::updateTime(cpu->instructionCount + cpu->blockInstructionCount, KSystem::getMicroCounter());
+
+    callVdso("__vdso_clock_gettime", 1, tp); // CLOCK_MONOTONIC
+    U64 host = KSystem::getMicroCounter();
+    U64 first = (U64)readd(tp) * 1000000 + readd(tp + 4) / 1000;
+    assertTrue(EAX == 0 && ESP == 4096 && readd(tp + 4) < 1000000000 && isNearHost(first, host));
+
+    callVdso("__vdso_clock_gettime", 1, tp);
+    U64 second = (U64)readd(tp) * 1000000 + readd(tp + 4) / 1000;
+    assertTrue(EAX == 0 && second >= first);
+
+    callVdso("__vdso_clock_gettime", 0, tp); // CLOCK_REALTIME
+    host = KSystem::getSystemTimeAsMicroSeconds();
+    assertTrue(EAX == 0 && readd(tp + 4) < 1000000000 && isNearHost((U64)readd(tp) * 1000000 + readd(tp + 4) / 1000, host));
+
+    writed(tp + 4, 0xffffffff);
+    writed(tp + 12, 0xffffffff);
+    callVdso("__vdso_clock_gettime64", 0, tp);
+    host = KSystem::getSystemTimeAsMicroSeconds();
+    assertTrue(EAX == 0 && readd(tp + 4) == 0 && readd(tp + 12) == 0 && readd(tp + 8) < 1000000000 && isNearHost((U64)readd(tp) * 1000000 + readd(tp + 8) / 1000, host));
+
+    callVdso("__vdso_gettimeofday", tp, 0);
+    host = KSystem::getSystemTimeAsMicroSeconds();
+    assertTrue(EAX == 0 && readd(tp + 4) < 1000000 && isNearHost((U64)readd(tp) * 1000000 + readd(tp + 4), host));
+
+    callVdso("__vdso_time", tp, 0);
+    host = KSystem::getSystemTimeAsMicroSeconds() / 1000000;
+    assertTrue(EAX == readd(tp) && EAX <= host + 1 && EAX + 1 >= host);
+
+    callVdso("__vdso_time", 0, 0);
+    assertTrue(EAX <= host + 1 && EAX + 1 >= host);
+
+    // CLOCK_PROCESS_CPUTIME_ID isn't in the time page, it goes through the syscall
+    writed(tp, 0xffffffff);
+    callVdso("__vdso_clock_gettime", 2, tp);
+    assertTrue(EAX == 0 && ESP == 4096 && readd(tp) != 0xffffffff && readd(tp + 4) < 1000000000);
+}
+#endif
+
 void testMovsb0x0a4() {
     cpu->big = false;
 
@@ -9180,6 +9572,9 @@ void test16BitMemoryAccess() {
 
 
 int main(int argc, char **argv) {	
+    if (argc > 1 && !strcmp(argv[1], "-benchmark")) {
+        return runBenchmarks(argc > 2 ? argv[2] : NULL);
+    }
     printf("Please wait, these first 2 tests can take a while\n");
     run(test32BitMemoryAccess, "32-bit Memory Access");
     run(test16BitMemoryAccess, "16-bit Memory Access");
@@ -9487,6 +9882,17 @@ int main(int argc, char **argv) {
     run(testScasb0x2ae, "Scasb 2ae");
     run(testScasw0x0af, "Scasw 0af");
     run(testScasd0x2af, "Scasd 2af");
+    run(testRepStringPages, "Rep string pages");
+    run(testDecodeAcrossPages, "Decode across pages");
+    run(testFusedCmpR32R32Jcc, "Fused cmp r32,r32 jcc");
+    run(testFusedCmpR32I32Jcc, "Fused cmp r32,imm jcc");
+    run(testFusedTestR32R32Jcc, "Fused test r32,r32 jcc");
+    run(testFusedDecJnz, "Fused dec jnz");
+    run(testFusedPushEbpMovEbpEsp, "Fused push ebp mov ebp,esp");
+    run(testFusedMovAdd, "Fused mov add");
+#ifdef BOXEDWINE_VDSO
+    run(testVdso, "vDSO");
+#endif
 
     run(testMovAlIb0x0b0, "Mov 0b0");
     run(testMovAlIb0x2b0, "Mov 2b0");
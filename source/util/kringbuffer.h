@@ -0,0 +1,168 @@
+#ifndef __KRINGBUFFER_H__
+#define __KRINGBUFFER_H__
+
+// growable byte ring buffer, data is copied straight between the ring and emulated memory
+//
+// the capacity is always a power of 2 so that positions can wrap with a mask
+#define KRINGBUFFER_MIN_CAPACITY 4096
+#define KRINGBUFFER_MAX_IDLE_CAPACITY (256 * 1024)
+
+class KRingBuffer {
+public:
+    KRingBuffer() : buffer(NULL), capacity(0), readPos(0), count(0) {}
+    ~KRingBuffer() {
+        if (this->buffer) {
+            delete[] this->buffer;
+        }
+    }
+
+    U32 size() const {return this->count;}
+    bool isEmpty() const {return this->count == 0;}
+
+    void write(const U8* data, U32 len) {
+        U8* p1;
+        U32 len1;
+        U8* p2;
+        U32 len2;
+
+        if (!len) {
+            return;
+        }
+        getWriteSpans(len, &p1, &len1, &p2, &len2);
+        memcpy(p1, data, len1);
+        if (len2) {
+            memcpy(p2, data + len1, len2);
+        }
+        this->count += len;
+    }
+
+    void writeFromMemory(U32 address, U32 len) {
+        U8* p1;
+        U32 len1;
+        U8* p2;
+        U32 len2;
+
+        if (!len) {
+            return;
+        }
+        getWriteSpans(len, &p1, &len1, &p2, &len2);
+        memcopyToNative(address, p1, len1);
+        if (len2) {
+            memcopyToNative(address + len1, p2, len2);
+        }
+        this->count += len;
+    }
+
+    U32 read(U8* data, U32 len) {
+        U8* p1;
+        U32 len1;
+        U8* p2;
+        U32 len2;
+
+        len = getReadSpans(len, &p1, &len1, &p2, &len2);
+        if (!len) {
+            return 0;
+        }
+        memcpy(data, p1, len1);
+        if (len2) {
+            memcpy(data + len1, p2, len2);
+        }
+        consume(len);
+        return len;
+    }
+
+    U32 readToMemory(U32 address, U32 len) {
+        U8* p1;
+        U32 len1;
+        U8* p2;
+        U32 len2;
+
+        len = getReadSpans(len, &p1, &len1, &p2, &len2);
+        if (!len) {
+            return 0;
+        }
+        memcopyFromNative(address, p1, len1);
+        if (len2) {
+            memcopyFromNative(address + len1, p2, len2);
+        }
+        consume(len);
+        return len;
+    }
+
+private:
+    void grow(U32 needed) {
+        U32 newCapacity = this->capacity ? this->capacity : KRINGBUFFER_MIN_CAPACITY;
+        while (newCapacity < needed) {
+            newCapacity <<= 1;
+        }
+        U8* newBuffer = new U8[newCapacity];
+        if (this->count) {
+            U32 first = this->capacity - this->readPos;
+            if (first > this->count) {
+                first = this->count;
+            }
+            memcpy(newBuffer, this->buffer + this->readPos, first);
+            memcpy(newBuffer + first, this->buffer, this->count - first);
+        }
+        if (this->buffer) {
+            delete[] this->buffer;
+        }
+        this->buffer = newBuffer;
+        this->capacity = newCapacity;
+        this->readPos = 0;
+    }
+
+    void getWriteSpans(U32 len, U8** p1, U32* len1, U8** p2, U32* len2) {
+        if (this->count + len > this->capacity) {
+            grow(this->count + len);
+        }
+        U32 writePos = (this->readPos + this->count) & (this->capacity - 1);
+        U32 first = this->capacity - writePos;
+
+        if (first > len) {
+            first = len;
+        }
+        *p1 = this->buffer + writePos;
+        *len1 = first;
+        *p2 = this->buffer;
+        *len2 = len - first;
+    }
+
+    U32 getReadSpans(U32 len, U8** p1, U32* len1, U8** p2, U32* len2) {
+        if (len > this->count) {
+            len = this->count;
+        }
+        U32 first = this->capacity - this->readPos;
+
+        if (first > len) {
+            first = len;
+        }
+        *p1 = this->buffer + this->readPos;
+        *len1 = first;
+        *p2 = this->buffer;
+        *len2 = len - first;
+        return len;
+    }
+
+    void consume(U32 len) {
+        this->count -= len;
+        if (this->count == 0) {
+            // start over at the beginning so that the next read/write is more likely to be a single span
+            this->readPos = 0;
+            if (this->capacity > KRINGBUFFER_MAX_IDLE_CAPACITY) {
+                delete[] this->buffer;
+                this->buffer = NULL;
+                this->capacity = 0;
+            }
+        } else {
+            this->readPos = (this->readPos + len) & (this->capacity - 1);
+        }
+    }
+
+    U8* buffer;
+    U32 capacity;
+    U32 readPos;
+    U32 count;
+};
+
+#endif
@@ -33,4421 +33,7 @@ void unmapVkMemory(VkDeviceMemory memory);
 #define ARG13 cpu->peek32(13)
 #define ARG14 cpu->peek32(14)
 #define ARG15 cpu->peek32(15)
-void* vulkanGetNextPtr(U32 address);
-void vulkanWriteNextPtr(U32 address, const void* pNext);
-class MarshalVkPhysicalDeviceFeatures {
-public:
-    MarshalVkPhysicalDeviceFeatures() {}
-    VkPhysicalDeviceFeatures s;
-    MarshalVkPhysicalDeviceFeatures(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceFeatures* s) {
-        s->robustBufferAccess = (VkBool32)readd(address);address+=4;
-        s->fullDrawIndexUint32 = (VkBool32)readd(address);address+=4;
-        s->imageCubeArray = (VkBool32)readd(address);address+=4;
-        s->independentBlend = (VkBool32)readd(address);address+=4;
-        s->geometryShader = (VkBool32)readd(address);address+=4;
-        s->tessellationShader = (VkBool32)readd(address);address+=4;
-        s->sampleRateShading = (VkBool32)readd(address);address+=4;
-        s->dualSrcBlend = (VkBool32)readd(address);address+=4;
-        s->logicOp = (VkBool32)readd(address);address+=4;
-        s->multiDrawIndirect = (VkBool32)readd(address);address+=4;
-        s->drawIndirectFirstInstance = (VkBool32)readd(address);address+=4;
-        s->depthClamp = (VkBool32)readd(address);address+=4;
-        s->depthBiasClamp = (VkBool32)readd(address);address+=4;
-        s->fillModeNonSolid = (VkBool32)readd(address);address+=4;
-        s->depthBounds = (VkBool32)readd(address);address+=4;
-        s->wideLines = (VkBool32)readd(address);address+=4;
-        s->largePoints = (VkBool32)readd(address);address+=4;
-        s->alphaToOne = (VkBool32)readd(address);address+=4;
-        s->multiViewport = (VkBool32)readd(address);address+=4;
-        s->samplerAnisotropy = (VkBool32)readd(address);address+=4;
-        s->textureCompressionETC2 = (VkBool32)readd(address);address+=4;
-        s->textureCompressionASTC_LDR = (VkBool32)readd(address);address+=4;
-        s->textureCompressionBC = (VkBool32)readd(address);address+=4;
-        s->occlusionQueryPrecise = (VkBool32)readd(address);address+=4;
-        s->pipelineStatisticsQuery = (VkBool32)readd(address);address+=4;
-        s->vertexPipelineStoresAndAtomics = (VkBool32)readd(address);address+=4;
-        s->fragmentStoresAndAtomics = (VkBool32)readd(address);address+=4;
-        s->shaderTessellationAndGeometryPointSize = (VkBool32)readd(address);address+=4;
-        s->shaderImageGatherExtended = (VkBool32)readd(address);address+=4;
-        s->shaderStorageImageExtendedFormats = (VkBool32)readd(address);address+=4;
-        s->shaderStorageImageMultisample = (VkBool32)readd(address);address+=4;
-        s->shaderStorageImageReadWithoutFormat = (VkBool32)readd(address);address+=4;
-        s->shaderStorageImageWriteWithoutFormat = (VkBool32)readd(address);address+=4;
-        s->shaderUniformBufferArrayDynamicIndexing = (VkBool32)readd(address);address+=4;
-        s->shaderSampledImageArrayDynamicIndexing = (VkBool32)readd(address);address+=4;
-        s->shaderStorageBufferArrayDynamicIndexing = (VkBool32)readd(address);address+=4;
-        s->shaderStorageImageArrayDynamicIndexing = (VkBool32)readd(address);address+=4;
-        s->shaderClipDistance = (VkBool32)readd(address);address+=4;
-        s->shaderCullDistance = (VkBool32)readd(address);address+=4;
-        s->shaderFloat64 = (VkBool32)readd(address);address+=4;
-        s->shaderInt64 = (VkBool32)readd(address);address+=4;
-        s->shaderInt16 = (VkBool32)readd(address);address+=4;
-        s->shaderResourceResidency = (VkBool32)readd(address);address+=4;
-        s->shaderResourceMinLod = (VkBool32)readd(address);address+=4;
-        s->sparseBinding = (VkBool32)readd(address);address+=4;
-        s->sparseResidencyBuffer = (VkBool32)readd(address);address+=4;
-        s->sparseResidencyImage2D = (VkBool32)readd(address);address+=4;
-        s->sparseResidencyImage3D = (VkBool32)readd(address);address+=4;
-        s->sparseResidency2Samples = (VkBool32)readd(address);address+=4;
-        s->sparseResidency4Samples = (VkBool32)readd(address);address+=4;
-        s->sparseResidency8Samples = (VkBool32)readd(address);address+=4;
-        s->sparseResidency16Samples = (VkBool32)readd(address);address+=4;
-        s->sparseResidencyAliased = (VkBool32)readd(address);address+=4;
-        s->variableMultisampleRate = (VkBool32)readd(address);address+=4;
-        s->inheritedQueries = (VkBool32)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceLimits {
-public:
-    MarshalVkPhysicalDeviceLimits() {}
-    VkPhysicalDeviceLimits s;
-    MarshalVkPhysicalDeviceLimits(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceLimits* s) {
-        s->maxImageDimension1D = (uint32_t)readd(address);address+=4;
-        s->maxImageDimension2D = (uint32_t)readd(address);address+=4;
-        s->maxImageDimension3D = (uint32_t)readd(address);address+=4;
-        s->maxImageDimensionCube = (uint32_t)readd(address);address+=4;
-        s->maxImageArrayLayers = (uint32_t)readd(address);address+=4;
-        s->maxTexelBufferElements = (uint32_t)readd(address);address+=4;
-        s->maxUniformBufferRange = (uint32_t)readd(address);address+=4;
-        s->maxStorageBufferRange = (uint32_t)readd(address);address+=4;
-        s->maxPushConstantsSize = (uint32_t)readd(address);address+=4;
-        s->maxMemoryAllocationCount = (uint32_t)readd(address);address+=4;
-        s->maxSamplerAllocationCount = (uint32_t)readd(address);address+=4;
-        s->bufferImageGranularity = (VkDeviceSize)readq(address);address+=8;
-        s->sparseAddressSpaceSize = (VkDeviceSize)readq(address);address+=8;
-        s->maxBoundDescriptorSets = (uint32_t)readd(address);address+=4;
-        s->maxPerStageDescriptorSamplers = (uint32_t)readd(address);address+=4;
-        s->maxPerStageDescriptorUniformBuffers = (uint32_t)readd(address);address+=4;
-        s->maxPerStageDescriptorStorageBuffers = (uint32_t)readd(address);address+=4;
-        s->maxPerStageDescriptorSampledImages = (uint32_t)readd(address);address+=4;
-        s->maxPerStageDescriptorStorageImages = (uint32_t)readd(address);address+=4;
-        s->maxPerStageDescriptorInputAttachments = (uint32_t)readd(address);address+=4;
-        s->maxPerStageResources = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetSamplers = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetUniformBuffers = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetUniformBuffersDynamic = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetStorageBuffers = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetStorageBuffersDynamic = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetSampledImages = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetStorageImages = (uint32_t)readd(address);address+=4;
-        s->maxDescriptorSetInputAttachments = (uint32_t)readd(address);address+=4;
-        s->maxVertexInputAttributes = (uint32_t)readd(address);address+=4;
-        s->maxVertexInputBindings = (uint32_t)readd(address);address+=4;
-        s->maxVertexInputAttributeOffset = (uint32_t)readd(address);address+=4;
-        s->maxVertexInputBindingStride = (uint32_t)readd(address);address+=4;
-        s->maxVertexOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxTessellationGenerationLevel = (uint32_t)readd(address);address+=4;
-        s->maxTessellationPatchSize = (uint32_t)readd(address);address+=4;
-        s->maxTessellationControlPerVertexInputComponents = (uint32_t)readd(address);address+=4;
-        s->maxTessellationControlPerVertexOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxTessellationControlPerPatchOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxTessellationControlTotalOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxTessellationEvaluationInputComponents = (uint32_t)readd(address);address+=4;
-        s->maxTessellationEvaluationOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxGeometryShaderInvocations = (uint32_t)readd(address);address+=4;
-        s->maxGeometryInputComponents = (uint32_t)readd(address);address+=4;
-        s->maxGeometryOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxGeometryOutputVertices = (uint32_t)readd(address);address+=4;
-        s->maxGeometryTotalOutputComponents = (uint32_t)readd(address);address+=4;
-        s->maxFragmentInputComponents = (uint32_t)readd(address);address+=4;
-        s->maxFragmentOutputAttachments = (uint32_t)readd(address);address+=4;
-        s->maxFragmentDualSrcAttachments = (uint32_t)readd(address);address+=4;
-        s->maxFragmentCombinedOutputResources = (uint32_t)readd(address);address+=4;
-        s->maxComputeSharedMemorySize = (uint32_t)readd(address);address+=4;
-        memcopyToNative(address, &s->maxComputeWorkGroupCount, 3);address+=3;
-        s->maxComputeWorkGroupInvocations = (uint32_t)readd(address);address+=4;
-        memcopyToNative(address, &s->maxComputeWorkGroupSize, 3);address+=3;
-        s->subPixelPrecisionBits = (uint32_t)readd(address);address+=4;
-        s->subTexelPrecisionBits = (uint32_t)readd(address);address+=4;
-        s->mipmapPrecisionBits = (uint32_t)readd(address);address+=4;
-        s->maxDrawIndexedIndexValue = (uint32_t)readd(address);address+=4;
-        s->maxDrawIndirectCount = (uint32_t)readd(address);address+=4;
-        s->maxSamplerLodBias = (float)readd(address);address+=4;
-        s->maxSamplerAnisotropy = (float)readd(address);address+=4;
-        s->maxViewports = (uint32_t)readd(address);address+=4;
-        memcopyToNative(address, &s->maxViewportDimensions, 2);address+=2;
-        memcopyToNative(address, &s->viewportBoundsRange, 2);address+=2;
-        s->viewportSubPixelBits = (uint32_t)readd(address);address+=4;
-        s->minMemoryMapAlignment = (size_t)readd(address);address+=4;
-        s->minTexelBufferOffsetAlignment = (VkDeviceSize)readq(address);address+=8;
-        s->minUniformBufferOffsetAlignment = (VkDeviceSize)readq(address);address+=8;
-        s->minStorageBufferOffsetAlignment = (VkDeviceSize)readq(address);address+=8;
-        s->minTexelOffset = (int32_t)readd(address);address+=4;
-        s->maxTexelOffset = (uint32_t)readd(address);address+=4;
-        s->minTexelGatherOffset = (int32_t)readd(address);address+=4;
-        s->maxTexelGatherOffset = (uint32_t)readd(address);address+=4;
-        s->minInterpolationOffset = (float)readd(address);address+=4;
-        s->maxInterpolationOffset = (float)readd(address);address+=4;
-        s->subPixelInterpolationOffsetBits = (uint32_t)readd(address);address+=4;
-        s->maxFramebufferWidth = (uint32_t)readd(address);address+=4;
-        s->maxFramebufferHeight = (uint32_t)readd(address);address+=4;
-        s->maxFramebufferLayers = (uint32_t)readd(address);address+=4;
-        s->framebufferColorSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->framebufferDepthSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->framebufferStencilSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->framebufferNoAttachmentsSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->maxColorAttachments = (uint32_t)readd(address);address+=4;
-        s->sampledImageColorSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->sampledImageIntegerSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->sampledImageDepthSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->sampledImageStencilSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->storageImageSampleCounts = (VkSampleCountFlags)readd(address);address+=4;
-        s->maxSampleMaskWords = (uint32_t)readd(address);address+=4;
-        s->timestampComputeAndGraphics = (VkBool32)readd(address);address+=4;
-        s->timestampPeriod = (float)readd(address);address+=4;
-        s->maxClipDistances = (uint32_t)readd(address);address+=4;
-        s->maxCullDistances = (uint32_t)readd(address);address+=4;
-        s->maxCombinedClipAndCullDistances = (uint32_t)readd(address);address+=4;
-        s->discreteQueuePriorities = (uint32_t)readd(address);address+=4;
-        memcopyToNative(address, &s->pointSizeRange, 2);address+=2;
-        memcopyToNative(address, &s->lineWidthRange, 2);address+=2;
-        s->pointSizeGranularity = (float)readd(address);address+=4;
-        s->lineWidthGranularity = (float)readd(address);address+=4;
-        s->strictLines = (VkBool32)readd(address);address+=4;
-        s->standardSampleLocations = (VkBool32)readd(address);address+=4;
-        s->optimalBufferCopyOffsetAlignment = (VkDeviceSize)readq(address);address+=8;
-        s->optimalBufferCopyRowPitchAlignment = (VkDeviceSize)readq(address);address+=8;
-        s->nonCoherentAtomSize = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkComponentMapping {
-public:
-    MarshalVkComponentMapping() {}
-    VkComponentMapping s;
-    MarshalVkComponentMapping(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkComponentMapping* s) {
-        s->r = (VkComponentSwizzle)readd(address);address+=4;
-        s->g = (VkComponentSwizzle)readd(address);address+=4;
-        s->b = (VkComponentSwizzle)readd(address);address+=4;
-        s->a = (VkComponentSwizzle)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceProperties {
-public:
-    MarshalVkPhysicalDeviceProperties() {}
-    VkPhysicalDeviceProperties s;
-    MarshalVkPhysicalDeviceProperties(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceProperties* s) {
-        s->apiVersion = (uint32_t)readd(address);address+=4;
-        s->driverVersion = (uint32_t)readd(address);address+=4;
-        s->vendorID = (uint32_t)readd(address);address+=4;
-        s->deviceID = (uint32_t)readd(address);address+=4;
-        s->deviceType = (VkPhysicalDeviceType)readd(address);address+=4;
-        memcopyToNative(address, &s->deviceName, 256);address+=256;
-        memcopyToNative(address, &s->pipelineCacheUUID, 16);address+=16;
-        MarshalVkPhysicalDeviceLimits::read(address, &s->limits); address+=488;
-        memcopyToNative(address, &s->sparseProperties, 20);address+=20;
-    }
-    static void write(U32 address, VkPhysicalDeviceProperties* s) {
-        writed(address, s->apiVersion);address+=4;
-        writed(address, s->driverVersion);address+=4;
-        writed(address, s->vendorID);address+=4;
-        writed(address, s->deviceID);address+=4;
-        writed(address, s->deviceType);address+=4;
-        memcopyFromNative(address, s->deviceName, 256); address+=256;
-        memcopyFromNative(address, s->pipelineCacheUUID, 16); address+=16;
-        memcopyFromNative(address, &s->limits, 488); address+=488;
-        memcopyFromNative(address, &s->sparseProperties, 20); address+=20;
-    }
-};
-
-class MarshalVkApplicationInfo {
-public:
-    MarshalVkApplicationInfo() {}
-    VkApplicationInfo s;
-    MarshalVkApplicationInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkApplicationInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pApplicationName = NULL;
-        } else {
-            s->pApplicationName = (char*)getPhysicalAddress(paramAddress, 0 * sizeof(char));
-        }
-        s->applicationVersion = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pEngineName = NULL;
-        } else {
-            s->pEngineName = (char*)getPhysicalAddress(paramAddress, 0 * sizeof(char));
-        }
-        s->engineVersion = (uint32_t)readd(address);address+=4;
-        s->apiVersion = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkDeviceQueueCreateInfo {
-public:
-    MarshalVkDeviceQueueCreateInfo() {}
-    VkDeviceQueueCreateInfo s;
-    MarshalVkDeviceQueueCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDeviceQueueCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkDeviceQueueCreateFlags)readd(address);address+=4;
-        s->queueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->queueCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pQueuePriorities = NULL;
-        } else {
-            s->pQueuePriorities = (float*)getPhysicalAddress(paramAddress, s->queueCount * sizeof(float));
-        }
-    }
-};
-
-class MarshalVkDeviceCreateInfo {
-public:
-    MarshalVkDeviceCreateInfo() {}
-    VkDeviceCreateInfo s;
-    MarshalVkDeviceCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDeviceCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkDeviceCreateFlags)readd(address);address+=4;
-        s->queueCreateInfoCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pQueueCreateInfos = NULL;
-        } else {
-            VkDeviceQueueCreateInfo* pQueueCreateInfos = new VkDeviceQueueCreateInfo[s->queueCreateInfoCount];
-            for (U32 i = 0; i < s->queueCreateInfoCount; i++) {
-                MarshalVkDeviceQueueCreateInfo::read(paramAddress, &pQueueCreateInfos[i]);
-            }
-            s->pQueueCreateInfos = pQueueCreateInfos;
-        }
-        s->enabledLayerCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->ppEnabledLayerNames = NULL;
-        } else {
-            char** ppEnabledLayerNames = new char*[s->enabledLayerCount];
-            for (int i=0;i<(int)s->enabledLayerCount;i++) {
-                ppEnabledLayerNames[i] = (char*)getPhysicalAddress(readd(paramAddress + i*4), 0);
-            }
-            s->ppEnabledLayerNames = ppEnabledLayerNames;
-        }
-        s->enabledExtensionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->ppEnabledExtensionNames = NULL;
-        } else {
-            char** ppEnabledExtensionNames = new char*[s->enabledExtensionCount];
-            for (int i=0;i<(int)s->enabledExtensionCount;i++) {
-                ppEnabledExtensionNames[i] = (char*)getPhysicalAddress(readd(paramAddress + i*4), 0);
-            }
-            s->ppEnabledExtensionNames = ppEnabledExtensionNames;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pEnabledFeatures = NULL;
-        } else {
-            VkPhysicalDeviceFeatures* pEnabledFeatures = new VkPhysicalDeviceFeatures();
-            MarshalVkPhysicalDeviceFeatures::read(paramAddress, pEnabledFeatures);
-            s->pEnabledFeatures = pEnabledFeatures;
-        }
-    }
-};
-
-class MarshalVkInstanceCreateInfo {
-public:
-    MarshalVkInstanceCreateInfo() {}
-    VkInstanceCreateInfo s;
-    MarshalVkInstanceCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkInstanceCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkInstanceCreateFlags)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pApplicationInfo = NULL;
-        } else {
-            VkApplicationInfo* pApplicationInfo = new VkApplicationInfo();
-            MarshalVkApplicationInfo::read(paramAddress, pApplicationInfo);
-            s->pApplicationInfo = pApplicationInfo;
-        }
-        s->enabledLayerCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->ppEnabledLayerNames = NULL;
-        } else {
-            char** ppEnabledLayerNames = new char*[s->enabledLayerCount];
-            for (int i=0;i<(int)s->enabledLayerCount;i++) {
-                ppEnabledLayerNames[i] = (char*)getPhysicalAddress(readd(paramAddress + i*4), 0);
-            }
-            s->ppEnabledLayerNames = ppEnabledLayerNames;
-        }
-        s->enabledExtensionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->ppEnabledExtensionNames = NULL;
-        } else {
-            char** ppEnabledExtensionNames = new char*[s->enabledExtensionCount];
-            for (int i=0;i<(int)s->enabledExtensionCount;i++) {
-                ppEnabledExtensionNames[i] = (char*)getPhysicalAddress(readd(paramAddress + i*4), 0);
-            }
-            s->ppEnabledExtensionNames = ppEnabledExtensionNames;
-        }
-    }
-};
-
-class MarshalVkMemoryAllocateInfo {
-public:
-    MarshalVkMemoryAllocateInfo() {}
-    VkMemoryAllocateInfo s;
-    MarshalVkMemoryAllocateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMemoryAllocateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->allocationSize = (VkDeviceSize)readq(address);address+=8;
-        s->memoryTypeIndex = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkMappedMemoryRange {
-public:
-    MarshalVkMappedMemoryRange() {}
-    VkMappedMemoryRange s;
-    MarshalVkMappedMemoryRange(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMappedMemoryRange* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->memory = (VkDeviceMemory)readq(address);address+=8;
-        s->offset = (VkDeviceSize)readq(address);address+=8;
-        s->size = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkDescriptorImageInfo {
-public:
-    MarshalVkDescriptorImageInfo() {}
-    VkDescriptorImageInfo s;
-    MarshalVkDescriptorImageInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorImageInfo* s) {
-        s->sampler = (VkSampler)readq(address);address+=8;
-        s->imageView = (VkImageView)readq(address);address+=8;
-        s->imageLayout = (VkImageLayout)readd(address);address+=4;
-    }
-};
-
-class MarshalVkWriteDescriptorSet {
-public:
-    MarshalVkWriteDescriptorSet() {}
-    VkWriteDescriptorSet s;
-    MarshalVkWriteDescriptorSet(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkWriteDescriptorSet* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->dstSet = (VkDescriptorSet)readq(address);address+=8;
-        s->dstBinding = (uint32_t)readd(address);address+=4;
-        s->dstArrayElement = (uint32_t)readd(address);address+=4;
-        s->descriptorCount = (uint32_t)readd(address);address+=4;
-        s->descriptorType = (VkDescriptorType)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pImageInfo = NULL;
-        } else {
-            VkDescriptorImageInfo* pImageInfo = new VkDescriptorImageInfo[s->descriptorCount];
-            for (U32 i = 0; i < s->descriptorCount; i++) {
-                MarshalVkDescriptorImageInfo::read(paramAddress, &pImageInfo[i]);
-            }
-            s->pImageInfo = pImageInfo;
-        }
-        memcopyToNative(address, &s->pBufferInfo, 24);address+=24;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pTexelBufferView = NULL;
-        } else {
-            s->pTexelBufferView = (VkBufferView*)getPhysicalAddress(paramAddress, s->descriptorCount * sizeof(VkBufferView));
-        }
-    }
-};
-
-class MarshalVkCopyDescriptorSet {
-public:
-    MarshalVkCopyDescriptorSet() {}
-    VkCopyDescriptorSet s;
-    MarshalVkCopyDescriptorSet(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCopyDescriptorSet* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcSet = (VkDescriptorSet)readq(address);address+=8;
-        s->srcBinding = (uint32_t)readd(address);address+=4;
-        s->srcArrayElement = (uint32_t)readd(address);address+=4;
-        s->dstSet = (VkDescriptorSet)readq(address);address+=8;
-        s->dstBinding = (uint32_t)readd(address);address+=4;
-        s->dstArrayElement = (uint32_t)readd(address);address+=4;
-        s->descriptorCount = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkBufferCreateInfo {
-public:
-    MarshalVkBufferCreateInfo() {}
-    VkBufferCreateInfo s;
-    MarshalVkBufferCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkBufferCreateFlags)readd(address);address+=4;
-        s->size = (VkDeviceSize)readq(address);address+=8;
-        s->usage = (VkBufferUsageFlags)readd(address);address+=4;
-        s->sharingMode = (VkSharingMode)readd(address);address+=4;
-        s->queueFamilyIndexCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pQueueFamilyIndices = NULL;
-        } else {
-            s->pQueueFamilyIndices = (uint32_t*)getPhysicalAddress(paramAddress, s->queueFamilyIndexCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkBufferViewCreateInfo {
-public:
-    MarshalVkBufferViewCreateInfo() {}
-    VkBufferViewCreateInfo s;
-    MarshalVkBufferViewCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferViewCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkBufferViewCreateFlags)readd(address);address+=4;
-        s->buffer = (VkBuffer)readq(address);address+=8;
-        s->format = (VkFormat)readd(address);address+=4;
-        s->offset = (VkDeviceSize)readq(address);address+=8;
-        s->range = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkMemoryBarrier {
-public:
-    MarshalVkMemoryBarrier() {}
-    VkMemoryBarrier s;
-    MarshalVkMemoryBarrier(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMemoryBarrier* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->dstAccessMask = (VkAccessFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkBufferMemoryBarrier {
-public:
-    MarshalVkBufferMemoryBarrier() {}
-    VkBufferMemoryBarrier s;
-    MarshalVkBufferMemoryBarrier(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferMemoryBarrier* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->dstAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->srcQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->dstQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->buffer = (VkBuffer)readq(address);address+=8;
-        s->offset = (VkDeviceSize)readq(address);address+=8;
-        s->size = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkImageMemoryBarrier {
-public:
-    MarshalVkImageMemoryBarrier() {}
-    VkImageMemoryBarrier s;
-    MarshalVkImageMemoryBarrier(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageMemoryBarrier* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->dstAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->oldLayout = (VkImageLayout)readd(address);address+=4;
-        s->newLayout = (VkImageLayout)readd(address);address+=4;
-        s->srcQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->dstQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->image = (VkImage)readq(address);address+=8;
-        memcopyToNative(address, &s->subresourceRange, 20);address+=20;
-    }
-};
-
-class MarshalVkImageCreateInfo {
-public:
-    MarshalVkImageCreateInfo() {}
-    VkImageCreateInfo s;
-    MarshalVkImageCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkImageCreateFlags)readd(address);address+=4;
-        s->imageType = (VkImageType)readd(address);address+=4;
-        s->format = (VkFormat)readd(address);address+=4;
-        memcopyToNative(address, &s->extent, 12);address+=12;
-        s->mipLevels = (uint32_t)readd(address);address+=4;
-        s->arrayLayers = (uint32_t)readd(address);address+=4;
-        s->samples = (VkSampleCountFlagBits)readd(address);address+=4;
-        s->tiling = (VkImageTiling)readd(address);address+=4;
-        s->usage = (VkImageUsageFlags)readd(address);address+=4;
-        s->sharingMode = (VkSharingMode)readd(address);address+=4;
-        s->queueFamilyIndexCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pQueueFamilyIndices = NULL;
-        } else {
-            s->pQueueFamilyIndices = (uint32_t*)getPhysicalAddress(paramAddress, s->queueFamilyIndexCount * sizeof(uint32_t));
-        }
-        s->initialLayout = (VkImageLayout)readd(address);address+=4;
-    }
-};
-
-class MarshalVkImageViewCreateInfo {
-public:
-    MarshalVkImageViewCreateInfo() {}
-    VkImageViewCreateInfo s;
-    MarshalVkImageViewCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageViewCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkImageViewCreateFlags)readd(address);address+=4;
-        s->image = (VkImage)readq(address);address+=8;
-        s->viewType = (VkImageViewType)readd(address);address+=4;
-        s->format = (VkFormat)readd(address);address+=4;
-        MarshalVkComponentMapping::read(address, &s->components); address+=16;
-        memcopyToNative(address, &s->subresourceRange, 20);address+=20;
-    }
-};
-
-class MarshalVkSparseBufferMemoryBindInfo {
-public:
-    MarshalVkSparseBufferMemoryBindInfo() {}
-    VkSparseBufferMemoryBindInfo s;
-    MarshalVkSparseBufferMemoryBindInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSparseBufferMemoryBindInfo* s) {
-        s->buffer = (VkBuffer)readq(address);address+=8;
-        s->bindCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pBinds = NULL;
-        } else {
-            s->pBinds = (VkSparseMemoryBind*)getPhysicalAddress(paramAddress, s->bindCount * sizeof(VkSparseMemoryBind));
-        }
-    }
-};
-
-class MarshalVkSparseImageOpaqueMemoryBindInfo {
-public:
-    MarshalVkSparseImageOpaqueMemoryBindInfo() {}
-    VkSparseImageOpaqueMemoryBindInfo s;
-    MarshalVkSparseImageOpaqueMemoryBindInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSparseImageOpaqueMemoryBindInfo* s) {
-        s->image = (VkImage)readq(address);address+=8;
-        s->bindCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pBinds = NULL;
-        } else {
-            s->pBinds = (VkSparseMemoryBind*)getPhysicalAddress(paramAddress, s->bindCount * sizeof(VkSparseMemoryBind));
-        }
-    }
-};
-
-class MarshalVkSparseImageMemoryBindInfo {
-public:
-    MarshalVkSparseImageMemoryBindInfo() {}
-    VkSparseImageMemoryBindInfo s;
-    MarshalVkSparseImageMemoryBindInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSparseImageMemoryBindInfo* s) {
-        s->image = (VkImage)readq(address);address+=8;
-        s->bindCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pBinds = NULL;
-        } else {
-            s->pBinds = (VkSparseImageMemoryBind*)getPhysicalAddress(paramAddress, s->bindCount * sizeof(VkSparseImageMemoryBind));
-        }
-    }
-};
-
-class MarshalVkBindSparseInfo {
-public:
-    MarshalVkBindSparseInfo() {}
-    VkBindSparseInfo s;
-    MarshalVkBindSparseInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBindSparseInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->waitSemaphoreCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pWaitSemaphores = NULL;
-        } else {
-            s->pWaitSemaphores = (VkSemaphore*)getPhysicalAddress(paramAddress, s->waitSemaphoreCount * sizeof(VkSemaphore));
-        }
-        s->bufferBindCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pBufferBinds = NULL;
-        } else {
-            VkSparseBufferMemoryBindInfo* pBufferBinds = new VkSparseBufferMemoryBindInfo[s->bufferBindCount];
-            for (U32 i = 0; i < s->bufferBindCount; i++) {
-                MarshalVkSparseBufferMemoryBindInfo::read(paramAddress, &pBufferBinds[i]);
-            }
-            s->pBufferBinds = pBufferBinds;
-        }
-        s->imageOpaqueBindCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pImageOpaqueBinds = NULL;
-        } else {
-            VkSparseImageOpaqueMemoryBindInfo* pImageOpaqueBinds = new VkSparseImageOpaqueMemoryBindInfo[s->imageOpaqueBindCount];
-            for (U32 i = 0; i < s->imageOpaqueBindCount; i++) {
-                MarshalVkSparseImageOpaqueMemoryBindInfo::read(paramAddress, &pImageOpaqueBinds[i]);
-            }
-            s->pImageOpaqueBinds = pImageOpaqueBinds;
-        }
-        s->imageBindCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pImageBinds = NULL;
-        } else {
-            VkSparseImageMemoryBindInfo* pImageBinds = new VkSparseImageMemoryBindInfo[s->imageBindCount];
-            for (U32 i = 0; i < s->imageBindCount; i++) {
-                MarshalVkSparseImageMemoryBindInfo::read(paramAddress, &pImageBinds[i]);
-            }
-            s->pImageBinds = pImageBinds;
-        }
-        s->signalSemaphoreCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSignalSemaphores = NULL;
-        } else {
-            s->pSignalSemaphores = (VkSemaphore*)getPhysicalAddress(paramAddress, s->signalSemaphoreCount * sizeof(VkSemaphore));
-        }
-    }
-};
-
-class MarshalVkShaderModuleCreateInfo {
-public:
-    MarshalVkShaderModuleCreateInfo() {}
-    VkShaderModuleCreateInfo s;
-    MarshalVkShaderModuleCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkShaderModuleCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkShaderModuleCreateFlags)readd(address);address+=4;
-        s->codeSize = (size_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pCode = NULL;
-        } else {
-            s->pCode = (uint32_t*)getPhysicalAddress(paramAddress, s->codeSize / 4 * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkDescriptorSetLayoutBinding {
-public:
-    MarshalVkDescriptorSetLayoutBinding() {}
-    VkDescriptorSetLayoutBinding s;
-    MarshalVkDescriptorSetLayoutBinding(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorSetLayoutBinding* s) {
-        s->binding = (uint32_t)readd(address);address+=4;
-        s->descriptorType = (VkDescriptorType)readd(address);address+=4;
-        s->descriptorCount = (uint32_t)readd(address);address+=4;
-        s->stageFlags = (VkShaderStageFlags)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pImmutableSamplers = NULL;
-        } else {
-            s->pImmutableSamplers = (VkSampler*)getPhysicalAddress(paramAddress, s->descriptorCount * sizeof(VkSampler));
-        }
-    }
-};
-
-class MarshalVkDescriptorSetLayoutCreateInfo {
-public:
-    MarshalVkDescriptorSetLayoutCreateInfo() {}
-    VkDescriptorSetLayoutCreateInfo s;
-    MarshalVkDescriptorSetLayoutCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorSetLayoutCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkDescriptorSetLayoutCreateFlags)readd(address);address+=4;
-        s->bindingCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pBindings = NULL;
-        } else {
-            VkDescriptorSetLayoutBinding* pBindings = new VkDescriptorSetLayoutBinding[s->bindingCount];
-            for (U32 i = 0; i < s->bindingCount; i++) {
-                MarshalVkDescriptorSetLayoutBinding::read(paramAddress, &pBindings[i]);
-            }
-            s->pBindings = pBindings;
-        }
-    }
-};
-
-class MarshalVkDescriptorPoolSize {
-public:
-    MarshalVkDescriptorPoolSize() {}
-    VkDescriptorPoolSize s;
-    MarshalVkDescriptorPoolSize(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorPoolSize* s) {
-        s->type = (VkDescriptorType)readd(address);address+=4;
-        s->descriptorCount = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkDescriptorPoolCreateInfo {
-public:
-    MarshalVkDescriptorPoolCreateInfo() {}
-    VkDescriptorPoolCreateInfo s;
-    MarshalVkDescriptorPoolCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorPoolCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkDescriptorPoolCreateFlags)readd(address);address+=4;
-        s->maxSets = (uint32_t)readd(address);address+=4;
-        s->poolSizeCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pPoolSizes = NULL;
-        } else {
-            VkDescriptorPoolSize* pPoolSizes = new VkDescriptorPoolSize[s->poolSizeCount];
-            for (U32 i = 0; i < s->poolSizeCount; i++) {
-                MarshalVkDescriptorPoolSize::read(paramAddress, &pPoolSizes[i]);
-            }
-            s->pPoolSizes = pPoolSizes;
-        }
-    }
-};
-
-class MarshalVkDescriptorSetAllocateInfo {
-public:
-    MarshalVkDescriptorSetAllocateInfo() {}
-    VkDescriptorSetAllocateInfo s;
-    MarshalVkDescriptorSetAllocateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorSetAllocateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->descriptorPool = (VkDescriptorPool)readq(address);address+=8;
-        s->descriptorSetCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSetLayouts = NULL;
-        } else {
-            s->pSetLayouts = (VkDescriptorSetLayout*)getPhysicalAddress(paramAddress, s->descriptorSetCount * sizeof(VkDescriptorSetLayout));
-        }
-    }
-};
-
-class MarshalVkSpecializationMapEntry {
-public:
-    MarshalVkSpecializationMapEntry() {}
-    VkSpecializationMapEntry s;
-    MarshalVkSpecializationMapEntry(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSpecializationMapEntry* s) {
-        s->constantID = (uint32_t)readd(address);address+=4;
-        s->offset = (uint32_t)readd(address);address+=4;
-        s->size = (size_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSpecializationInfo {
-public:
-    MarshalVkSpecializationInfo() {}
-    VkSpecializationInfo s;
-    MarshalVkSpecializationInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSpecializationInfo* s) {
-        s->mapEntryCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pMapEntries = NULL;
-        } else {
-            VkSpecializationMapEntry* pMapEntries = new VkSpecializationMapEntry[s->mapEntryCount];
-            for (U32 i = 0; i < s->mapEntryCount; i++) {
-                MarshalVkSpecializationMapEntry::read(paramAddress, &pMapEntries[i]);
-            }
-            s->pMapEntries = pMapEntries;
-        }
-        s->dataSize = (size_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pData = NULL;
-        } else {
-            s->pData = (void*)getPhysicalAddress(paramAddress, s->dataSize);
-        }
-    }
-};
-
-class MarshalVkPipelineShaderStageCreateInfo {
-public:
-    MarshalVkPipelineShaderStageCreateInfo() {}
-    VkPipelineShaderStageCreateInfo s;
-    MarshalVkPipelineShaderStageCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineShaderStageCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineShaderStageCreateFlags)readd(address);address+=4;
-        s->stage = (VkShaderStageFlagBits)readd(address);address+=4;
-        s->module = (VkShaderModule)readq(address);address+=8;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pName = NULL;
-        } else {
-            s->pName = (char*)getPhysicalAddress(paramAddress, 0 * sizeof(char));
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSpecializationInfo = NULL;
-        } else {
-            VkSpecializationInfo* pSpecializationInfo = new VkSpecializationInfo();
-            MarshalVkSpecializationInfo::read(paramAddress, pSpecializationInfo);
-            s->pSpecializationInfo = pSpecializationInfo;
-        }
-    }
-};
-
-class MarshalVkComputePipelineCreateInfo {
-public:
-    MarshalVkComputePipelineCreateInfo() {}
-    VkComputePipelineCreateInfo s;
-    MarshalVkComputePipelineCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkComputePipelineCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineCreateFlags)readd(address);address+=4;
-        MarshalVkPipelineShaderStageCreateInfo::read(address, &s->stage); address+=32;
-        s->layout = (VkPipelineLayout)readq(address);address+=8;
-        s->basePipelineHandle = (VkPipeline)readq(address);address+=8;
-        s->basePipelineIndex = (int32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkVertexInputBindingDescription {
-public:
-    MarshalVkVertexInputBindingDescription() {}
-    VkVertexInputBindingDescription s;
-    MarshalVkVertexInputBindingDescription(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkVertexInputBindingDescription* s) {
-        s->binding = (uint32_t)readd(address);address+=4;
-        s->stride = (uint32_t)readd(address);address+=4;
-        s->inputRate = (VkVertexInputRate)readd(address);address+=4;
-    }
-};
-
-class MarshalVkVertexInputAttributeDescription {
-public:
-    MarshalVkVertexInputAttributeDescription() {}
-    VkVertexInputAttributeDescription s;
-    MarshalVkVertexInputAttributeDescription(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkVertexInputAttributeDescription* s) {
-        s->location = (uint32_t)readd(address);address+=4;
-        s->binding = (uint32_t)readd(address);address+=4;
-        s->format = (VkFormat)readd(address);address+=4;
-        s->offset = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineVertexInputStateCreateInfo {
-public:
-    MarshalVkPipelineVertexInputStateCreateInfo() {}
-    VkPipelineVertexInputStateCreateInfo s;
-    MarshalVkPipelineVertexInputStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineVertexInputStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineVertexInputStateCreateFlags)readd(address);address+=4;
-        s->vertexBindingDescriptionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pVertexBindingDescriptions = NULL;
-        } else {
-            VkVertexInputBindingDescription* pVertexBindingDescriptions = new VkVertexInputBindingDescription[s->vertexBindingDescriptionCount];
-            for (U32 i = 0; i < s->vertexBindingDescriptionCount; i++) {
-                MarshalVkVertexInputBindingDescription::read(paramAddress, &pVertexBindingDescriptions[i]);
-            }
-            s->pVertexBindingDescriptions = pVertexBindingDescriptions;
-        }
-        s->vertexAttributeDescriptionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pVertexAttributeDescriptions = NULL;
-        } else {
-            VkVertexInputAttributeDescription* pVertexAttributeDescriptions = new VkVertexInputAttributeDescription[s->vertexAttributeDescriptionCount];
-            for (U32 i = 0; i < s->vertexAttributeDescriptionCount; i++) {
-                MarshalVkVertexInputAttributeDescription::read(paramAddress, &pVertexAttributeDescriptions[i]);
-            }
-            s->pVertexAttributeDescriptions = pVertexAttributeDescriptions;
-        }
-    }
-};
-
-class MarshalVkPipelineInputAssemblyStateCreateInfo {
-public:
-    MarshalVkPipelineInputAssemblyStateCreateInfo() {}
-    VkPipelineInputAssemblyStateCreateInfo s;
-    MarshalVkPipelineInputAssemblyStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineInputAssemblyStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineInputAssemblyStateCreateFlags)readd(address);address+=4;
-        s->topology = (VkPrimitiveTopology)readd(address);address+=4;
-        s->primitiveRestartEnable = (VkBool32)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineTessellationStateCreateInfo {
-public:
-    MarshalVkPipelineTessellationStateCreateInfo() {}
-    VkPipelineTessellationStateCreateInfo s;
-    MarshalVkPipelineTessellationStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineTessellationStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineTessellationStateCreateFlags)readd(address);address+=4;
-        s->patchControlPoints = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineViewportStateCreateInfo {
-public:
-    MarshalVkPipelineViewportStateCreateInfo() {}
-    VkPipelineViewportStateCreateInfo s;
-    MarshalVkPipelineViewportStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineViewportStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineViewportStateCreateFlags)readd(address);address+=4;
-        s->viewportCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pViewports = NULL;
-        } else {
-            s->pViewports = (VkViewport*)getPhysicalAddress(paramAddress, s->viewportCount * sizeof(VkViewport));
-        }
-        s->scissorCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pScissors = NULL;
-        } else {
-            s->pScissors = (VkRect2D*)getPhysicalAddress(paramAddress, s->scissorCount * sizeof(VkRect2D));
-        }
-    }
-};
-
-class MarshalVkPipelineRasterizationStateCreateInfo {
-public:
-    MarshalVkPipelineRasterizationStateCreateInfo() {}
-    VkPipelineRasterizationStateCreateInfo s;
-    MarshalVkPipelineRasterizationStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineRasterizationStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineRasterizationStateCreateFlags)readd(address);address+=4;
-        s->depthClampEnable = (VkBool32)readd(address);address+=4;
-        s->rasterizerDiscardEnable = (VkBool32)readd(address);address+=4;
-        s->polygonMode = (VkPolygonMode)readd(address);address+=4;
-        s->cullMode = (VkCullModeFlags)readd(address);address+=4;
-        s->frontFace = (VkFrontFace)readd(address);address+=4;
-        s->depthBiasEnable = (VkBool32)readd(address);address+=4;
-        s->depthBiasConstantFactor = (float)readd(address);address+=4;
-        s->depthBiasClamp = (float)readd(address);address+=4;
-        s->depthBiasSlopeFactor = (float)readd(address);address+=4;
-        s->lineWidth = (float)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineMultisampleStateCreateInfo {
-public:
-    MarshalVkPipelineMultisampleStateCreateInfo() {}
-    VkPipelineMultisampleStateCreateInfo s;
-    MarshalVkPipelineMultisampleStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineMultisampleStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineMultisampleStateCreateFlags)readd(address);address+=4;
-        s->rasterizationSamples = (VkSampleCountFlagBits)readd(address);address+=4;
-        s->sampleShadingEnable = (VkBool32)readd(address);address+=4;
-        s->minSampleShading = (float)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSampleMask = NULL;
-        } else {
-            s->pSampleMask = (VkSampleMask*)getPhysicalAddress(paramAddress, (s->rasterizationSamples + 31) / 32 * sizeof(VkSampleMask));
-        }
-        s->alphaToCoverageEnable = (VkBool32)readd(address);address+=4;
-        s->alphaToOneEnable = (VkBool32)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineColorBlendAttachmentState {
-public:
-    MarshalVkPipelineColorBlendAttachmentState() {}
-    VkPipelineColorBlendAttachmentState s;
-    MarshalVkPipelineColorBlendAttachmentState(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineColorBlendAttachmentState* s) {
-        s->blendEnable = (VkBool32)readd(address);address+=4;
-        s->srcColorBlendFactor = (VkBlendFactor)readd(address);address+=4;
-        s->dstColorBlendFactor = (VkBlendFactor)readd(address);address+=4;
-        s->colorBlendOp = (VkBlendOp)readd(address);address+=4;
-        s->srcAlphaBlendFactor = (VkBlendFactor)readd(address);address+=4;
-        s->dstAlphaBlendFactor = (VkBlendFactor)readd(address);address+=4;
-        s->alphaBlendOp = (VkBlendOp)readd(address);address+=4;
-        s->colorWriteMask = (VkColorComponentFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineColorBlendStateCreateInfo {
-public:
-    MarshalVkPipelineColorBlendStateCreateInfo() {}
-    VkPipelineColorBlendStateCreateInfo s;
-    MarshalVkPipelineColorBlendStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineColorBlendStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineColorBlendStateCreateFlags)readd(address);address+=4;
-        s->logicOpEnable = (VkBool32)readd(address);address+=4;
-        s->logicOp = (VkLogicOp)readd(address);address+=4;
-        s->attachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pAttachments = NULL;
-        } else {
-            VkPipelineColorBlendAttachmentState* pAttachments = new VkPipelineColorBlendAttachmentState[s->attachmentCount];
-            for (U32 i = 0; i < s->attachmentCount; i++) {
-                MarshalVkPipelineColorBlendAttachmentState::read(paramAddress, &pAttachments[i]);
-            }
-            s->pAttachments = pAttachments;
-        }
-        memcopyToNative(address, &s->blendConstants, 4);address+=4;
-    }
-};
-
-class MarshalVkPipelineDynamicStateCreateInfo {
-public:
-    MarshalVkPipelineDynamicStateCreateInfo() {}
-    VkPipelineDynamicStateCreateInfo s;
-    MarshalVkPipelineDynamicStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineDynamicStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineDynamicStateCreateFlags)readd(address);address+=4;
-        s->dynamicStateCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDynamicStates = NULL;
-        } else {
-            s->pDynamicStates = (VkDynamicState*)getPhysicalAddress(paramAddress, s->dynamicStateCount * sizeof(VkDynamicState));
-        }
-    }
-};
-
-class MarshalVkStencilOpState {
-public:
-    MarshalVkStencilOpState() {}
-    VkStencilOpState s;
-    MarshalVkStencilOpState(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkStencilOpState* s) {
-        s->failOp = (VkStencilOp)readd(address);address+=4;
-        s->passOp = (VkStencilOp)readd(address);address+=4;
-        s->depthFailOp = (VkStencilOp)readd(address);address+=4;
-        s->compareOp = (VkCompareOp)readd(address);address+=4;
-        s->compareMask = (uint32_t)readd(address);address+=4;
-        s->writeMask = (uint32_t)readd(address);address+=4;
-        s->reference = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineDepthStencilStateCreateInfo {
-public:
-    MarshalVkPipelineDepthStencilStateCreateInfo() {}
-    VkPipelineDepthStencilStateCreateInfo s;
-    MarshalVkPipelineDepthStencilStateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineDepthStencilStateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineDepthStencilStateCreateFlags)readd(address);address+=4;
-        s->depthTestEnable = (VkBool32)readd(address);address+=4;
-        s->depthWriteEnable = (VkBool32)readd(address);address+=4;
-        s->depthCompareOp = (VkCompareOp)readd(address);address+=4;
-        s->depthBoundsTestEnable = (VkBool32)readd(address);address+=4;
-        s->stencilTestEnable = (VkBool32)readd(address);address+=4;
-        MarshalVkStencilOpState::read(address, &s->front); address+=28;
-        MarshalVkStencilOpState::read(address, &s->back); address+=28;
-        s->minDepthBounds = (float)readd(address);address+=4;
-        s->maxDepthBounds = (float)readd(address);address+=4;
-    }
-};
-
-class MarshalVkGraphicsPipelineCreateInfo {
-public:
-    MarshalVkGraphicsPipelineCreateInfo() {}
-    VkGraphicsPipelineCreateInfo s;
-    MarshalVkGraphicsPipelineCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGraphicsPipelineCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineCreateFlags)readd(address);address+=4;
-        s->stageCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pStages = NULL;
-        } else {
-            VkPipelineShaderStageCreateInfo* pStages = new VkPipelineShaderStageCreateInfo[s->stageCount];
-            for (U32 i = 0; i < s->stageCount; i++) {
-                MarshalVkPipelineShaderStageCreateInfo::read(paramAddress, &pStages[i]);
-            }
-            s->pStages = pStages;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pVertexInputState = NULL;
-        } else {
-            VkPipelineVertexInputStateCreateInfo* pVertexInputState = new VkPipelineVertexInputStateCreateInfo();
-            MarshalVkPipelineVertexInputStateCreateInfo::read(paramAddress, pVertexInputState);
-            s->pVertexInputState = pVertexInputState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pInputAssemblyState = NULL;
-        } else {
-            VkPipelineInputAssemblyStateCreateInfo* pInputAssemblyState = new VkPipelineInputAssemblyStateCreateInfo();
-            MarshalVkPipelineInputAssemblyStateCreateInfo::read(paramAddress, pInputAssemblyState);
-            s->pInputAssemblyState = pInputAssemblyState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pTessellationState = NULL;
-        } else {
-            VkPipelineTessellationStateCreateInfo* pTessellationState = new VkPipelineTessellationStateCreateInfo();
-            MarshalVkPipelineTessellationStateCreateInfo::read(paramAddress, pTessellationState);
-            s->pTessellationState = pTessellationState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pViewportState = NULL;
-        } else {
-            VkPipelineViewportStateCreateInfo* pViewportState = new VkPipelineViewportStateCreateInfo();
-            MarshalVkPipelineViewportStateCreateInfo::read(paramAddress, pViewportState);
-            s->pViewportState = pViewportState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRasterizationState = NULL;
-        } else {
-            VkPipelineRasterizationStateCreateInfo* pRasterizationState = new VkPipelineRasterizationStateCreateInfo();
-            MarshalVkPipelineRasterizationStateCreateInfo::read(paramAddress, pRasterizationState);
-            s->pRasterizationState = pRasterizationState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pMultisampleState = NULL;
-        } else {
-            VkPipelineMultisampleStateCreateInfo* pMultisampleState = new VkPipelineMultisampleStateCreateInfo();
-            MarshalVkPipelineMultisampleStateCreateInfo::read(paramAddress, pMultisampleState);
-            s->pMultisampleState = pMultisampleState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDepthStencilState = NULL;
-        } else {
-            VkPipelineDepthStencilStateCreateInfo* pDepthStencilState = new VkPipelineDepthStencilStateCreateInfo();
-            MarshalVkPipelineDepthStencilStateCreateInfo::read(paramAddress, pDepthStencilState);
-            s->pDepthStencilState = pDepthStencilState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pColorBlendState = NULL;
-        } else {
-            VkPipelineColorBlendStateCreateInfo* pColorBlendState = new VkPipelineColorBlendStateCreateInfo();
-            MarshalVkPipelineColorBlendStateCreateInfo::read(paramAddress, pColorBlendState);
-            s->pColorBlendState = pColorBlendState;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDynamicState = NULL;
-        } else {
-            VkPipelineDynamicStateCreateInfo* pDynamicState = new VkPipelineDynamicStateCreateInfo();
-            MarshalVkPipelineDynamicStateCreateInfo::read(paramAddress, pDynamicState);
-            s->pDynamicState = pDynamicState;
-        }
-        s->layout = (VkPipelineLayout)readq(address);address+=8;
-        s->renderPass = (VkRenderPass)readq(address);address+=8;
-        s->subpass = (uint32_t)readd(address);address+=4;
-        s->basePipelineHandle = (VkPipeline)readq(address);address+=8;
-        s->basePipelineIndex = (int32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPipelineCacheCreateInfo {
-public:
-    MarshalVkPipelineCacheCreateInfo() {}
-    VkPipelineCacheCreateInfo s;
-    MarshalVkPipelineCacheCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineCacheCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineCacheCreateFlags)readd(address);address+=4;
-        s->initialDataSize = (size_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pInitialData = NULL;
-        } else {
-            s->pInitialData = (void*)getPhysicalAddress(paramAddress, s->initialDataSize);
-        }
-    }
-};
-
-class MarshalVkPipelineLayoutCreateInfo {
-public:
-    MarshalVkPipelineLayoutCreateInfo() {}
-    VkPipelineLayoutCreateInfo s;
-    MarshalVkPipelineLayoutCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPipelineLayoutCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineLayoutCreateFlags)readd(address);address+=4;
-        s->setLayoutCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSetLayouts = NULL;
-        } else {
-            s->pSetLayouts = (VkDescriptorSetLayout*)getPhysicalAddress(paramAddress, s->setLayoutCount * sizeof(VkDescriptorSetLayout));
-        }
-        s->pushConstantRangeCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pPushConstantRanges = NULL;
-        } else {
-            s->pPushConstantRanges = (VkPushConstantRange*)getPhysicalAddress(paramAddress, s->pushConstantRangeCount * sizeof(VkPushConstantRange));
-        }
-    }
-};
-
-class MarshalVkSamplerCreateInfo {
-public:
-    MarshalVkSamplerCreateInfo() {}
-    VkSamplerCreateInfo s;
-    MarshalVkSamplerCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSamplerCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkSamplerCreateFlags)readd(address);address+=4;
-        s->magFilter = (VkFilter)readd(address);address+=4;
-        s->minFilter = (VkFilter)readd(address);address+=4;
-        s->mipmapMode = (VkSamplerMipmapMode)readd(address);address+=4;
-        s->addressModeU = (VkSamplerAddressMode)readd(address);address+=4;
-        s->addressModeV = (VkSamplerAddressMode)readd(address);address+=4;
-        s->addressModeW = (VkSamplerAddressMode)readd(address);address+=4;
-        s->mipLodBias = (float)readd(address);address+=4;
-        s->anisotropyEnable = (VkBool32)readd(address);address+=4;
-        s->maxAnisotropy = (float)readd(address);address+=4;
-        s->compareEnable = (VkBool32)readd(address);address+=4;
-        s->compareOp = (VkCompareOp)readd(address);address+=4;
-        s->minLod = (float)readd(address);address+=4;
-        s->maxLod = (float)readd(address);address+=4;
-        s->borderColor = (VkBorderColor)readd(address);address+=4;
-        s->unnormalizedCoordinates = (VkBool32)readd(address);address+=4;
-    }
-};
-
-class MarshalVkCommandPoolCreateInfo {
-public:
-    MarshalVkCommandPoolCreateInfo() {}
-    VkCommandPoolCreateInfo s;
-    MarshalVkCommandPoolCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCommandPoolCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkCommandPoolCreateFlags)readd(address);address+=4;
-        s->queueFamilyIndex = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkCommandBufferAllocateInfo {
-public:
-    MarshalVkCommandBufferAllocateInfo() {}
-    VkCommandBufferAllocateInfo s;
-    MarshalVkCommandBufferAllocateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCommandBufferAllocateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->commandPool = (VkCommandPool)readq(address);address+=8;
-        s->level = (VkCommandBufferLevel)readd(address);address+=4;
-        s->commandBufferCount = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkCommandBufferInheritanceInfo {
-public:
-    MarshalVkCommandBufferInheritanceInfo() {}
-    VkCommandBufferInheritanceInfo s;
-    MarshalVkCommandBufferInheritanceInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCommandBufferInheritanceInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->renderPass = (VkRenderPass)readq(address);address+=8;
-        s->subpass = (uint32_t)readd(address);address+=4;
-        s->framebuffer = (VkFramebuffer)readq(address);address+=8;
-        s->occlusionQueryEnable = (VkBool32)readd(address);address+=4;
-        s->queryFlags = (VkQueryControlFlags)readd(address);address+=4;
-        s->pipelineStatistics = (VkQueryPipelineStatisticFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkCommandBufferBeginInfo {
-public:
-    MarshalVkCommandBufferBeginInfo() {}
-    VkCommandBufferBeginInfo s;
-    MarshalVkCommandBufferBeginInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCommandBufferBeginInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkCommandBufferUsageFlags)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pInheritanceInfo = NULL;
-        } else {
-            VkCommandBufferInheritanceInfo* pInheritanceInfo = new VkCommandBufferInheritanceInfo();
-            MarshalVkCommandBufferInheritanceInfo::read(paramAddress, pInheritanceInfo);
-            s->pInheritanceInfo = pInheritanceInfo;
-        }
-    }
-};
-
-class MarshalVkRenderPassBeginInfo {
-public:
-    MarshalVkRenderPassBeginInfo() {}
-    VkRenderPassBeginInfo s;
-    MarshalVkRenderPassBeginInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkRenderPassBeginInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->renderPass = (VkRenderPass)readq(address);address+=8;
-        s->framebuffer = (VkFramebuffer)readq(address);address+=8;
-        memcopyToNative(address, &s->renderArea, 16);address+=16;
-        s->clearValueCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pClearValues = NULL;
-        } else {
-            s->pClearValues = (VkClearValue*)getPhysicalAddress(paramAddress, s->clearValueCount * sizeof(VkClearValue));
-        }
-    }
-};
-
-class MarshalVkAttachmentDescription {
-public:
-    MarshalVkAttachmentDescription() {}
-    VkAttachmentDescription s;
-    MarshalVkAttachmentDescription(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAttachmentDescription* s) {
-        s->flags = (VkAttachmentDescriptionFlags)readd(address);address+=4;
-        s->format = (VkFormat)readd(address);address+=4;
-        s->samples = (VkSampleCountFlagBits)readd(address);address+=4;
-        s->loadOp = (VkAttachmentLoadOp)readd(address);address+=4;
-        s->storeOp = (VkAttachmentStoreOp)readd(address);address+=4;
-        s->stencilLoadOp = (VkAttachmentLoadOp)readd(address);address+=4;
-        s->stencilStoreOp = (VkAttachmentStoreOp)readd(address);address+=4;
-        s->initialLayout = (VkImageLayout)readd(address);address+=4;
-        s->finalLayout = (VkImageLayout)readd(address);address+=4;
-    }
-};
-
-class MarshalVkAttachmentReference {
-public:
-    MarshalVkAttachmentReference() {}
-    VkAttachmentReference s;
-    MarshalVkAttachmentReference(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAttachmentReference* s) {
-        s->attachment = (uint32_t)readd(address);address+=4;
-        s->layout = (VkImageLayout)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSubpassDescription {
-public:
-    MarshalVkSubpassDescription() {}
-    VkSubpassDescription s;
-    MarshalVkSubpassDescription(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubpassDescription* s) {
-        s->flags = (VkSubpassDescriptionFlags)readd(address);address+=4;
-        s->pipelineBindPoint = (VkPipelineBindPoint)readd(address);address+=4;
-        s->inputAttachmentCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pInputAttachments = NULL;
-        } else {
-            VkAttachmentReference* pInputAttachments = new VkAttachmentReference[s->inputAttachmentCount];
-            for (U32 i = 0; i < s->inputAttachmentCount; i++) {
-                MarshalVkAttachmentReference::read(paramAddress, &pInputAttachments[i]);
-            }
-            s->pInputAttachments = pInputAttachments;
-        }
-        s->colorAttachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pColorAttachments = NULL;
-        } else {
-            VkAttachmentReference* pColorAttachments = new VkAttachmentReference[s->colorAttachmentCount];
-            for (U32 i = 0; i < s->colorAttachmentCount; i++) {
-                MarshalVkAttachmentReference::read(paramAddress, &pColorAttachments[i]);
-            }
-            s->pColorAttachments = pColorAttachments;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pResolveAttachments = NULL;
-        } else {
-            VkAttachmentReference* pResolveAttachments = new VkAttachmentReference[s->colorAttachmentCount];
-            for (U32 i = 0; i < s->colorAttachmentCount; i++) {
-                MarshalVkAttachmentReference::read(paramAddress, &pResolveAttachments[i]);
-            }
-            s->pResolveAttachments = pResolveAttachments;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDepthStencilAttachment = NULL;
-        } else {
-            VkAttachmentReference* pDepthStencilAttachment = new VkAttachmentReference();
-            MarshalVkAttachmentReference::read(paramAddress, pDepthStencilAttachment);
-            s->pDepthStencilAttachment = pDepthStencilAttachment;
-        }
-        s->preserveAttachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pPreserveAttachments = NULL;
-        } else {
-            s->pPreserveAttachments = (uint32_t*)getPhysicalAddress(paramAddress, s->preserveAttachmentCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkRenderPassCreateInfo {
-public:
-    MarshalVkRenderPassCreateInfo() {}
-    VkRenderPassCreateInfo s;
-    MarshalVkRenderPassCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkRenderPassCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkRenderPassCreateFlags)readd(address);address+=4;
-        s->attachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pAttachments = NULL;
-        } else {
-            VkAttachmentDescription* pAttachments = new VkAttachmentDescription[s->attachmentCount];
-            for (U32 i = 0; i < s->attachmentCount; i++) {
-                MarshalVkAttachmentDescription::read(paramAddress, &pAttachments[i]);
-            }
-            s->pAttachments = pAttachments;
-        }
-        s->subpassCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSubpasses = NULL;
-        } else {
-            VkSubpassDescription* pSubpasses = new VkSubpassDescription[s->subpassCount];
-            for (U32 i = 0; i < s->subpassCount; i++) {
-                MarshalVkSubpassDescription::read(paramAddress, &pSubpasses[i]);
-            }
-            s->pSubpasses = pSubpasses;
-        }
-        s->dependencyCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDependencies = NULL;
-        } else {
-            s->pDependencies = (VkSubpassDependency*)getPhysicalAddress(paramAddress, s->dependencyCount * sizeof(VkSubpassDependency));
-        }
-    }
-};
-
-class MarshalVkEventCreateInfo {
-public:
-    MarshalVkEventCreateInfo() {}
-    VkEventCreateInfo s;
-    MarshalVkEventCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkEventCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkEventCreateFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkFenceCreateInfo {
-public:
-    MarshalVkFenceCreateInfo() {}
-    VkFenceCreateInfo s;
-    MarshalVkFenceCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkFenceCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkFenceCreateFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSemaphoreCreateInfo {
-public:
-    MarshalVkSemaphoreCreateInfo() {}
-    VkSemaphoreCreateInfo s;
-    MarshalVkSemaphoreCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSemaphoreCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkSemaphoreCreateFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkQueryPoolCreateInfo {
-public:
-    MarshalVkQueryPoolCreateInfo() {}
-    VkQueryPoolCreateInfo s;
-    MarshalVkQueryPoolCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkQueryPoolCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkQueryPoolCreateFlags)readd(address);address+=4;
-        s->queryType = (VkQueryType)readd(address);address+=4;
-        s->queryCount = (uint32_t)readd(address);address+=4;
-        s->pipelineStatistics = (VkQueryPipelineStatisticFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkFramebufferCreateInfo {
-public:
-    MarshalVkFramebufferCreateInfo() {}
-    VkFramebufferCreateInfo s;
-    MarshalVkFramebufferCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkFramebufferCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkFramebufferCreateFlags)readd(address);address+=4;
-        s->renderPass = (VkRenderPass)readq(address);address+=8;
-        s->attachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pAttachments = NULL;
-        } else {
-            s->pAttachments = (VkImageView*)getPhysicalAddress(paramAddress, s->attachmentCount * sizeof(VkImageView));
-        }
-        s->width = (uint32_t)readd(address);address+=4;
-        s->height = (uint32_t)readd(address);address+=4;
-        s->layers = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSubmitInfo {
-public:
-    MarshalVkSubmitInfo() {}
-    VkSubmitInfo s;
-    MarshalVkSubmitInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubmitInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->waitSemaphoreCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pWaitSemaphores = NULL;
-        } else {
-            s->pWaitSemaphores = (VkSemaphore*)getPhysicalAddress(paramAddress, s->waitSemaphoreCount * sizeof(VkSemaphore));
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pWaitDstStageMask = NULL;
-        } else {
-            s->pWaitDstStageMask = (VkPipelineStageFlags*)getPhysicalAddress(paramAddress, s->waitSemaphoreCount * sizeof(VkPipelineStageFlags));
-        }
-        s->commandBufferCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pCommandBuffers = NULL;
-        } else {
-            VkCommandBuffer* pCommandBuffers = new VkCommandBuffer[s->commandBufferCount];
-            for (int i=0;i<(int)s->commandBufferCount;i++) {
-                pCommandBuffers[i] = (VkCommandBuffer)getVulkanPtr(paramAddress);
-            }
-            s->pCommandBuffers = pCommandBuffers;
-        }
-        s->signalSemaphoreCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSignalSemaphores = NULL;
-        } else {
-            s->pSignalSemaphores = (VkSemaphore*)getPhysicalAddress(paramAddress, s->signalSemaphoreCount * sizeof(VkSemaphore));
-        }
-    }
-};
-
-class MarshalVkSurfaceCapabilitiesKHR {
-public:
-    MarshalVkSurfaceCapabilitiesKHR() {}
-    VkSurfaceCapabilitiesKHR s;
-    MarshalVkSurfaceCapabilitiesKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSurfaceCapabilitiesKHR* s) {
-        s->minImageCount = (uint32_t)readd(address);address+=4;
-        s->maxImageCount = (uint32_t)readd(address);address+=4;
-        memcopyToNative(address, &s->currentExtent, 8);address+=8;
-        memcopyToNative(address, &s->minImageExtent, 8);address+=8;
-        memcopyToNative(address, &s->maxImageExtent, 8);address+=8;
-        s->maxImageArrayLayers = (uint32_t)readd(address);address+=4;
-        s->supportedTransforms = (VkSurfaceTransformFlagsKHR)readd(address);address+=4;
-        s->currentTransform = (VkSurfaceTransformFlagBitsKHR)readd(address);address+=4;
-        s->supportedCompositeAlpha = (VkCompositeAlphaFlagsKHR)readd(address);address+=4;
-        s->supportedUsageFlags = (VkImageUsageFlags)readd(address);address+=4;
-    }
-    static void write(U32 address, VkSurfaceCapabilitiesKHR* s) {
-        writed(address, s->minImageCount);address+=4;
-        writed(address, s->maxImageCount);address+=4;
-        memcopyFromNative(address, &s->currentExtent, 8); address+=8;
-        memcopyFromNative(address, &s->minImageExtent, 8); address+=8;
-        memcopyFromNative(address, &s->maxImageExtent, 8); address+=8;
-        writed(address, s->maxImageArrayLayers);address+=4;
-        writed(address, s->supportedTransforms);address+=4;
-        writed(address, s->currentTransform);address+=4;
-        writed(address, s->supportedCompositeAlpha);address+=4;
-        writed(address, s->supportedUsageFlags);address+=4;
-    }
-};
-
-class MarshalVkSurfaceFormatKHR {
-public:
-    MarshalVkSurfaceFormatKHR() {}
-    VkSurfaceFormatKHR s;
-    static void write(U32 address, VkSurfaceFormatKHR* s) {
-        writed(address, s->format);address+=4;
-        writed(address, s->colorSpace);address+=4;
-    }
-};
-
-class MarshalVkSwapchainCreateInfoKHR {
-public:
-    MarshalVkSwapchainCreateInfoKHR() {}
-    VkSwapchainCreateInfoKHR s;
-    MarshalVkSwapchainCreateInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSwapchainCreateInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkSwapchainCreateFlagsKHR)readd(address);address+=4;
-        s->surface = (VkSurfaceKHR)readq(address);address+=8;
-        s->minImageCount = (uint32_t)readd(address);address+=4;
-        s->imageFormat = (VkFormat)readd(address);address+=4;
-        s->imageColorSpace = (VkColorSpaceKHR)readd(address);address+=4;
-        memcopyToNative(address, &s->imageExtent, 8);address+=8;
-        s->imageArrayLayers = (uint32_t)readd(address);address+=4;
-        s->imageUsage = (VkImageUsageFlags)readd(address);address+=4;
-        s->imageSharingMode = (VkSharingMode)readd(address);address+=4;
-        s->queueFamilyIndexCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pQueueFamilyIndices = NULL;
-        } else {
-            s->pQueueFamilyIndices = (uint32_t*)getPhysicalAddress(paramAddress, s->queueFamilyIndexCount * sizeof(uint32_t));
-        }
-        s->preTransform = (VkSurfaceTransformFlagBitsKHR)readd(address);address+=4;
-        s->compositeAlpha = (VkCompositeAlphaFlagBitsKHR)readd(address);address+=4;
-        s->presentMode = (VkPresentModeKHR)readd(address);address+=4;
-        s->clipped = (VkBool32)readd(address);address+=4;
-        s->oldSwapchain = (VkSwapchainKHR)readq(address);address+=8;
-    }
-};
-
-class MarshalVkPresentInfoKHR {
-public:
-    MarshalVkPresentInfoKHR() {}
-    VkPresentInfoKHR s;
-    MarshalVkPresentInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPresentInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->waitSemaphoreCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pWaitSemaphores = NULL;
-        } else {
-            s->pWaitSemaphores = (VkSemaphore*)getPhysicalAddress(paramAddress, s->waitSemaphoreCount * sizeof(VkSemaphore));
-        }
-        s->swapchainCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSwapchains = NULL;
-        } else {
-            s->pSwapchains = (VkSwapchainKHR*)getPhysicalAddress(paramAddress, s->swapchainCount * sizeof(VkSwapchainKHR));
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pImageIndices = NULL;
-        } else {
-            s->pImageIndices = (uint32_t*)getPhysicalAddress(paramAddress, s->swapchainCount * sizeof(uint32_t));
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pResults = NULL;
-        } else {
-            s->pResults = (VkResult*)getPhysicalAddress(paramAddress, s->swapchainCount * sizeof(VkResult));
-        }
-    }
-};
-
-class MarshalVkPrivateDataSlotCreateInfoEXT {
-public:
-    MarshalVkPrivateDataSlotCreateInfoEXT() {}
-    VkPrivateDataSlotCreateInfoEXT s;
-    MarshalVkPrivateDataSlotCreateInfoEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPrivateDataSlotCreateInfoEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPrivateDataSlotCreateFlagsEXT)readd(address);address+=4;
-    }
-};
-
-class MarshalVkIndirectCommandsLayoutTokenNV {
-public:
-    MarshalVkIndirectCommandsLayoutTokenNV() {}
-    VkIndirectCommandsLayoutTokenNV s;
-    MarshalVkIndirectCommandsLayoutTokenNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkIndirectCommandsLayoutTokenNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->tokenType = (VkIndirectCommandsTokenTypeNV)readd(address);address+=4;
-        s->stream = (uint32_t)readd(address);address+=4;
-        s->offset = (uint32_t)readd(address);address+=4;
-        s->vertexBindingUnit = (uint32_t)readd(address);address+=4;
-        s->vertexDynamicStride = (VkBool32)readd(address);address+=4;
-        s->pushconstantPipelineLayout = (VkPipelineLayout)readq(address);address+=8;
-        s->pushconstantShaderStageFlags = (VkShaderStageFlags)readd(address);address+=4;
-        s->pushconstantOffset = (uint32_t)readd(address);address+=4;
-        s->pushconstantSize = (uint32_t)readd(address);address+=4;
-        s->indirectStateFlags = (VkIndirectStateFlagsNV)readd(address);address+=4;
-        s->indexTypeCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pIndexTypes = NULL;
-        } else {
-            s->pIndexTypes = (VkIndexType*)getPhysicalAddress(paramAddress, s->indexTypeCount * sizeof(VkIndexType));
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pIndexTypeValues = NULL;
-        } else {
-            s->pIndexTypeValues = (uint32_t*)getPhysicalAddress(paramAddress, s->indexTypeCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkIndirectCommandsLayoutCreateInfoNV {
-public:
-    MarshalVkIndirectCommandsLayoutCreateInfoNV() {}
-    VkIndirectCommandsLayoutCreateInfoNV s;
-    MarshalVkIndirectCommandsLayoutCreateInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkIndirectCommandsLayoutCreateInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkIndirectCommandsLayoutUsageFlagsNV)readd(address);address+=4;
-        s->pipelineBindPoint = (VkPipelineBindPoint)readd(address);address+=4;
-        s->tokenCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pTokens = NULL;
-        } else {
-            VkIndirectCommandsLayoutTokenNV* pTokens = new VkIndirectCommandsLayoutTokenNV[s->tokenCount];
-            for (U32 i = 0; i < s->tokenCount; i++) {
-                MarshalVkIndirectCommandsLayoutTokenNV::read(paramAddress, &pTokens[i]);
-            }
-            s->pTokens = pTokens;
-        }
-        s->streamCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pStreamStrides = NULL;
-        } else {
-            s->pStreamStrides = (uint32_t*)getPhysicalAddress(paramAddress, s->streamCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkGeneratedCommandsInfoNV {
-public:
-    MarshalVkGeneratedCommandsInfoNV() {}
-    VkGeneratedCommandsInfoNV s;
-    MarshalVkGeneratedCommandsInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGeneratedCommandsInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->pipelineBindPoint = (VkPipelineBindPoint)readd(address);address+=4;
-        s->pipeline = (VkPipeline)readq(address);address+=8;
-        s->indirectCommandsLayout = (VkIndirectCommandsLayoutNV)readq(address);address+=8;
-        s->streamCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pStreams = NULL;
-        } else {
-            s->pStreams = (VkIndirectCommandsStreamNV*)getPhysicalAddress(paramAddress, s->streamCount * sizeof(VkIndirectCommandsStreamNV));
-        }
-        s->sequencesCount = (uint32_t)readd(address);address+=4;
-        s->preprocessBuffer = (VkBuffer)readq(address);address+=8;
-        s->preprocessOffset = (VkDeviceSize)readq(address);address+=8;
-        s->preprocessSize = (VkDeviceSize)readq(address);address+=8;
-        s->sequencesCountBuffer = (VkBuffer)readq(address);address+=8;
-        s->sequencesCountOffset = (VkDeviceSize)readq(address);address+=8;
-        s->sequencesIndexBuffer = (VkBuffer)readq(address);address+=8;
-        s->sequencesIndexOffset = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkGeneratedCommandsMemoryRequirementsInfoNV {
-public:
-    MarshalVkGeneratedCommandsMemoryRequirementsInfoNV() {}
-    VkGeneratedCommandsMemoryRequirementsInfoNV s;
-    MarshalVkGeneratedCommandsMemoryRequirementsInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGeneratedCommandsMemoryRequirementsInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->pipelineBindPoint = (VkPipelineBindPoint)readd(address);address+=4;
-        s->pipeline = (VkPipeline)readq(address);address+=8;
-        s->indirectCommandsLayout = (VkIndirectCommandsLayoutNV)readq(address);address+=8;
-        s->maxSequencesCount = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceFeatures2 {
-public:
-    MarshalVkPhysicalDeviceFeatures2() {}
-    VkPhysicalDeviceFeatures2 s;
-    MarshalVkPhysicalDeviceFeatures2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceFeatures2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->features, 220);address+=220;
-    }
-    static void write(U32 address, VkPhysicalDeviceFeatures2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->features, 220); address+=220;
-    }
-};
-
-class MarshalVkPhysicalDeviceProperties2 {
-public:
-    MarshalVkPhysicalDeviceProperties2() {}
-    VkPhysicalDeviceProperties2 s;
-    MarshalVkPhysicalDeviceProperties2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceProperties2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        MarshalVkPhysicalDeviceProperties::read(address, &s->properties); address+=800;
-    }
-    static void write(U32 address, VkPhysicalDeviceProperties2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->properties, 800); address+=800;
-    }
-};
-
-class MarshalVkFormatProperties2 {
-public:
-    MarshalVkFormatProperties2() {}
-    VkFormatProperties2 s;
-    MarshalVkFormatProperties2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkFormatProperties2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->formatProperties, 12);address+=12;
-    }
-    static void write(U32 address, VkFormatProperties2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->formatProperties, 12); address+=12;
-    }
-};
-
-class MarshalVkImageFormatProperties2 {
-public:
-    MarshalVkImageFormatProperties2() {}
-    VkImageFormatProperties2 s;
-    MarshalVkImageFormatProperties2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageFormatProperties2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->imageFormatProperties, 32);address+=32;
-    }
-    static void write(U32 address, VkImageFormatProperties2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->imageFormatProperties, 32); address+=32;
-    }
-};
-
-class MarshalVkPhysicalDeviceImageFormatInfo2 {
-public:
-    MarshalVkPhysicalDeviceImageFormatInfo2() {}
-    VkPhysicalDeviceImageFormatInfo2 s;
-    MarshalVkPhysicalDeviceImageFormatInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceImageFormatInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->format = (VkFormat)readd(address);address+=4;
-        s->type = (VkImageType)readd(address);address+=4;
-        s->tiling = (VkImageTiling)readd(address);address+=4;
-        s->usage = (VkImageUsageFlags)readd(address);address+=4;
-        s->flags = (VkImageCreateFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkQueueFamilyProperties2 {
-public:
-    MarshalVkQueueFamilyProperties2() {}
-    VkQueueFamilyProperties2 s;
-    static void write(U32 address, VkQueueFamilyProperties2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->queueFamilyProperties, 24); address+=24;
-    }
-};
-
-class MarshalVkPhysicalDeviceMemoryProperties2 {
-public:
-    MarshalVkPhysicalDeviceMemoryProperties2() {}
-    VkPhysicalDeviceMemoryProperties2 s;
-    MarshalVkPhysicalDeviceMemoryProperties2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceMemoryProperties2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->memoryProperties, 456);address+=456;
-    }
-    static void write(U32 address, VkPhysicalDeviceMemoryProperties2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->memoryProperties, 456); address+=456;
-    }
-};
-
-class MarshalVkSparseImageFormatProperties2 {
-public:
-    MarshalVkSparseImageFormatProperties2() {}
-    VkSparseImageFormatProperties2 s;
-    static void write(U32 address, VkSparseImageFormatProperties2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->properties, 20); address+=20;
-    }
-};
-
-class MarshalVkPhysicalDeviceSparseImageFormatInfo2 {
-public:
-    MarshalVkPhysicalDeviceSparseImageFormatInfo2() {}
-    VkPhysicalDeviceSparseImageFormatInfo2 s;
-    MarshalVkPhysicalDeviceSparseImageFormatInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceSparseImageFormatInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->format = (VkFormat)readd(address);address+=4;
-        s->type = (VkImageType)readd(address);address+=4;
-        s->samples = (VkSampleCountFlagBits)readd(address);address+=4;
-        s->usage = (VkImageUsageFlags)readd(address);address+=4;
-        s->tiling = (VkImageTiling)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceExternalBufferInfo {
-public:
-    MarshalVkPhysicalDeviceExternalBufferInfo() {}
-    VkPhysicalDeviceExternalBufferInfo s;
-    MarshalVkPhysicalDeviceExternalBufferInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceExternalBufferInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkBufferCreateFlags)readd(address);address+=4;
-        s->usage = (VkBufferUsageFlags)readd(address);address+=4;
-        s->handleType = (VkExternalMemoryHandleTypeFlagBits)readd(address);address+=4;
-    }
-};
-
-class MarshalVkExternalBufferProperties {
-public:
-    MarshalVkExternalBufferProperties() {}
-    VkExternalBufferProperties s;
-    MarshalVkExternalBufferProperties(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkExternalBufferProperties* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->externalMemoryProperties, 12);address+=12;
-    }
-    static void write(U32 address, VkExternalBufferProperties* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->externalMemoryProperties, 12); address+=12;
-    }
-};
-
-class MarshalVkPhysicalDeviceIDProperties {
-public:
-    MarshalVkPhysicalDeviceIDProperties() {}
-    VkPhysicalDeviceIDProperties s;
-    MarshalVkPhysicalDeviceIDProperties(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceIDProperties* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->deviceUUID, 16);address+=16;
-        memcopyToNative(address, &s->driverUUID, 16);address+=16;
-        memcopyToNative(address, &s->deviceLUID, 8);address+=8;
-        s->deviceNodeMask = (uint32_t)readd(address);address+=4;
-        s->deviceLUIDValid = (VkBool32)readd(address);address+=4;
-    }
-    static void write(U32 address, VkPhysicalDeviceIDProperties* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, s->deviceUUID, 16); address+=16;
-        memcopyFromNative(address, s->driverUUID, 16); address+=16;
-        memcopyFromNative(address, s->deviceLUID, 8); address+=8;
-        writed(address, s->deviceNodeMask);address+=4;
-        writed(address, s->deviceLUIDValid);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceExternalSemaphoreInfo {
-public:
-    MarshalVkPhysicalDeviceExternalSemaphoreInfo() {}
-    VkPhysicalDeviceExternalSemaphoreInfo s;
-    MarshalVkPhysicalDeviceExternalSemaphoreInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceExternalSemaphoreInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->handleType = (VkExternalSemaphoreHandleTypeFlagBits)readd(address);address+=4;
-    }
-};
-
-class MarshalVkExternalSemaphoreProperties {
-public:
-    MarshalVkExternalSemaphoreProperties() {}
-    VkExternalSemaphoreProperties s;
-    MarshalVkExternalSemaphoreProperties(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkExternalSemaphoreProperties* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->exportFromImportedHandleTypes = (VkExternalSemaphoreHandleTypeFlags)readd(address);address+=4;
-        s->compatibleHandleTypes = (VkExternalSemaphoreHandleTypeFlags)readd(address);address+=4;
-        s->externalSemaphoreFeatures = (VkExternalSemaphoreFeatureFlags)readd(address);address+=4;
-    }
-    static void write(U32 address, VkExternalSemaphoreProperties* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->exportFromImportedHandleTypes);address+=4;
-        writed(address, s->compatibleHandleTypes);address+=4;
-        writed(address, s->externalSemaphoreFeatures);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceExternalFenceInfo {
-public:
-    MarshalVkPhysicalDeviceExternalFenceInfo() {}
-    VkPhysicalDeviceExternalFenceInfo s;
-    MarshalVkPhysicalDeviceExternalFenceInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceExternalFenceInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->handleType = (VkExternalFenceHandleTypeFlagBits)readd(address);address+=4;
-    }
-};
-
-class MarshalVkExternalFenceProperties {
-public:
-    MarshalVkExternalFenceProperties() {}
-    VkExternalFenceProperties s;
-    MarshalVkExternalFenceProperties(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkExternalFenceProperties* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->exportFromImportedHandleTypes = (VkExternalFenceHandleTypeFlags)readd(address);address+=4;
-        s->compatibleHandleTypes = (VkExternalFenceHandleTypeFlags)readd(address);address+=4;
-        s->externalFenceFeatures = (VkExternalFenceFeatureFlags)readd(address);address+=4;
-    }
-    static void write(U32 address, VkExternalFenceProperties* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->exportFromImportedHandleTypes);address+=4;
-        writed(address, s->compatibleHandleTypes);address+=4;
-        writed(address, s->externalFenceFeatures);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceGroupProperties {
-public:
-    MarshalVkPhysicalDeviceGroupProperties() {}
-    VkPhysicalDeviceGroupProperties s;
-    static void write(U32 address, VkPhysicalDeviceGroupProperties* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->physicalDeviceCount);address+=4;
-        memcopyFromNative(address, s->physicalDevices, 128); address+=128;
-        writed(address, s->subsetAllocation);address+=4;
-    }
-};
-
-class MarshalVkBindBufferMemoryInfo {
-public:
-    MarshalVkBindBufferMemoryInfo() {}
-    VkBindBufferMemoryInfo s;
-    MarshalVkBindBufferMemoryInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBindBufferMemoryInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->buffer = (VkBuffer)readq(address);address+=8;
-        s->memory = (VkDeviceMemory)readq(address);address+=8;
-        s->memoryOffset = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkBindImageMemoryInfo {
-public:
-    MarshalVkBindImageMemoryInfo() {}
-    VkBindImageMemoryInfo s;
-    MarshalVkBindImageMemoryInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBindImageMemoryInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->image = (VkImage)readq(address);address+=8;
-        s->memory = (VkDeviceMemory)readq(address);address+=8;
-        s->memoryOffset = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkDeviceGroupPresentCapabilitiesKHR {
-public:
-    MarshalVkDeviceGroupPresentCapabilitiesKHR() {}
-    VkDeviceGroupPresentCapabilitiesKHR s;
-    MarshalVkDeviceGroupPresentCapabilitiesKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDeviceGroupPresentCapabilitiesKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->presentMask, 32);address+=32;
-        s->modes = (VkDeviceGroupPresentModeFlagsKHR)readd(address);address+=4;
-    }
-    static void write(U32 address, VkDeviceGroupPresentCapabilitiesKHR* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, s->presentMask, 128); address+=128;
-        writed(address, s->modes);address+=4;
-    }
-};
-
-class MarshalVkAcquireNextImageInfoKHR {
-public:
-    MarshalVkAcquireNextImageInfoKHR() {}
-    VkAcquireNextImageInfoKHR s;
-    MarshalVkAcquireNextImageInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAcquireNextImageInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->swapchain = (VkSwapchainKHR)readq(address);address+=8;
-        s->timeout = (uint64_t)readq(address);address+=8;
-        s->semaphore = (VkSemaphore)readq(address);address+=8;
-        s->fence = (VkFence)readq(address);address+=8;
-        s->deviceMask = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkDescriptorUpdateTemplateEntry {
-public:
-    MarshalVkDescriptorUpdateTemplateEntry() {}
-    VkDescriptorUpdateTemplateEntry s;
-    MarshalVkDescriptorUpdateTemplateEntry(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorUpdateTemplateEntry* s) {
-        s->dstBinding = (uint32_t)readd(address);address+=4;
-        s->dstArrayElement = (uint32_t)readd(address);address+=4;
-        s->descriptorCount = (uint32_t)readd(address);address+=4;
-        s->descriptorType = (VkDescriptorType)readd(address);address+=4;
-        s->offset = (size_t)readd(address);address+=4;
-        s->stride = (size_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkDescriptorUpdateTemplateCreateInfo {
-public:
-    MarshalVkDescriptorUpdateTemplateCreateInfo() {}
-    VkDescriptorUpdateTemplateCreateInfo s;
-    MarshalVkDescriptorUpdateTemplateCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorUpdateTemplateCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkDescriptorUpdateTemplateCreateFlags)readd(address);address+=4;
-        s->descriptorUpdateEntryCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDescriptorUpdateEntries = NULL;
-        } else {
-            VkDescriptorUpdateTemplateEntry* pDescriptorUpdateEntries = new VkDescriptorUpdateTemplateEntry[s->descriptorUpdateEntryCount];
-            for (U32 i = 0; i < s->descriptorUpdateEntryCount; i++) {
-                MarshalVkDescriptorUpdateTemplateEntry::read(paramAddress, &pDescriptorUpdateEntries[i]);
-            }
-            s->pDescriptorUpdateEntries = pDescriptorUpdateEntries;
-        }
-        s->templateType = (VkDescriptorUpdateTemplateType)readd(address);address+=4;
-        s->descriptorSetLayout = (VkDescriptorSetLayout)readq(address);address+=8;
-        s->pipelineBindPoint = (VkPipelineBindPoint)readd(address);address+=4;
-        s->pipelineLayout = (VkPipelineLayout)readq(address);address+=8;
-        s->set = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceSurfaceInfo2KHR {
-public:
-    MarshalVkPhysicalDeviceSurfaceInfo2KHR() {}
-    VkPhysicalDeviceSurfaceInfo2KHR s;
-    MarshalVkPhysicalDeviceSurfaceInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceSurfaceInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->surface = (VkSurfaceKHR)readq(address);address+=8;
-    }
-};
-
-class MarshalVkSurfaceCapabilities2KHR {
-public:
-    MarshalVkSurfaceCapabilities2KHR() {}
-    VkSurfaceCapabilities2KHR s;
-    MarshalVkSurfaceCapabilities2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSurfaceCapabilities2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        MarshalVkSurfaceCapabilitiesKHR::read(address, &s->surfaceCapabilities); address+=52;
-    }
-    static void write(U32 address, VkSurfaceCapabilities2KHR* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->surfaceCapabilities, 52); address+=52;
-    }
-};
-
-class MarshalVkSurfaceFormat2KHR {
-public:
-    MarshalVkSurfaceFormat2KHR() {}
-    VkSurfaceFormat2KHR s;
-    static void write(U32 address, VkSurfaceFormat2KHR* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->surfaceFormat, 8); address+=8;
-    }
-};
-
-class MarshalVkBufferMemoryRequirementsInfo2 {
-public:
-    MarshalVkBufferMemoryRequirementsInfo2() {}
-    VkBufferMemoryRequirementsInfo2 s;
-    MarshalVkBufferMemoryRequirementsInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferMemoryRequirementsInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->buffer = (VkBuffer)readq(address);address+=8;
-    }
-};
-
-class MarshalVkImageMemoryRequirementsInfo2 {
-public:
-    MarshalVkImageMemoryRequirementsInfo2() {}
-    VkImageMemoryRequirementsInfo2 s;
-    MarshalVkImageMemoryRequirementsInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageMemoryRequirementsInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->image = (VkImage)readq(address);address+=8;
-    }
-};
-
-class MarshalVkImageSparseMemoryRequirementsInfo2 {
-public:
-    MarshalVkImageSparseMemoryRequirementsInfo2() {}
-    VkImageSparseMemoryRequirementsInfo2 s;
-    MarshalVkImageSparseMemoryRequirementsInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageSparseMemoryRequirementsInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->image = (VkImage)readq(address);address+=8;
-    }
-};
-
-class MarshalVkMemoryRequirements2 {
-public:
-    MarshalVkMemoryRequirements2() {}
-    VkMemoryRequirements2 s;
-    MarshalVkMemoryRequirements2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMemoryRequirements2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->memoryRequirements, 20);address+=20;
-    }
-    static void write(U32 address, VkMemoryRequirements2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->memoryRequirements, 20); address+=20;
-    }
-};
-
-class MarshalVkSparseImageMemoryRequirements2 {
-public:
-    MarshalVkSparseImageMemoryRequirements2() {}
-    VkSparseImageMemoryRequirements2 s;
-    static void write(U32 address, VkSparseImageMemoryRequirements2* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->memoryRequirements, 48); address+=48;
-    }
-};
-
-class MarshalVkSamplerYcbcrConversionCreateInfo {
-public:
-    MarshalVkSamplerYcbcrConversionCreateInfo() {}
-    VkSamplerYcbcrConversionCreateInfo s;
-    MarshalVkSamplerYcbcrConversionCreateInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSamplerYcbcrConversionCreateInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->format = (VkFormat)readd(address);address+=4;
-        s->ycbcrModel = (VkSamplerYcbcrModelConversion)readd(address);address+=4;
-        s->ycbcrRange = (VkSamplerYcbcrRange)readd(address);address+=4;
-        MarshalVkComponentMapping::read(address, &s->components); address+=16;
-        s->xChromaOffset = (VkChromaLocation)readd(address);address+=4;
-        s->yChromaOffset = (VkChromaLocation)readd(address);address+=4;
-        s->chromaFilter = (VkFilter)readd(address);address+=4;
-        s->forceExplicitReconstruction = (VkBool32)readd(address);address+=4;
-    }
-};
-
-class MarshalVkConditionalRenderingBeginInfoEXT {
-public:
-    MarshalVkConditionalRenderingBeginInfoEXT() {}
-    VkConditionalRenderingBeginInfoEXT s;
-    MarshalVkConditionalRenderingBeginInfoEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkConditionalRenderingBeginInfoEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->buffer = (VkBuffer)readq(address);address+=8;
-        s->offset = (VkDeviceSize)readq(address);address+=8;
-        s->flags = (VkConditionalRenderingFlagsEXT)readd(address);address+=4;
-    }
-};
-
-class MarshalVkDeviceQueueInfo2 {
-public:
-    MarshalVkDeviceQueueInfo2() {}
-    VkDeviceQueueInfo2 s;
-    MarshalVkDeviceQueueInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDeviceQueueInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkDeviceQueueCreateFlags)readd(address);address+=4;
-        s->queueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->queueIndex = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSampleLocationsInfoEXT {
-public:
-    MarshalVkSampleLocationsInfoEXT() {}
-    VkSampleLocationsInfoEXT s;
-    MarshalVkSampleLocationsInfoEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSampleLocationsInfoEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->sampleLocationsPerPixel = (VkSampleCountFlagBits)readd(address);address+=4;
-        memcopyToNative(address, &s->sampleLocationGridSize, 8);address+=8;
-        s->sampleLocationsCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSampleLocations = NULL;
-        } else {
-            s->pSampleLocations = (VkSampleLocationEXT*)getPhysicalAddress(paramAddress, s->sampleLocationsCount * sizeof(VkSampleLocationEXT));
-        }
-    }
-};
-
-class MarshalVkMultisamplePropertiesEXT {
-public:
-    MarshalVkMultisamplePropertiesEXT() {}
-    VkMultisamplePropertiesEXT s;
-    MarshalVkMultisamplePropertiesEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMultisamplePropertiesEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->maxSampleLocationGridSize, 8);address+=8;
-    }
-    static void write(U32 address, VkMultisamplePropertiesEXT* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, &s->maxSampleLocationGridSize, 8); address+=8;
-    }
-};
-
-class MarshalVkValidationCacheCreateInfoEXT {
-public:
-    MarshalVkValidationCacheCreateInfoEXT() {}
-    VkValidationCacheCreateInfoEXT s;
-    MarshalVkValidationCacheCreateInfoEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkValidationCacheCreateInfoEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkValidationCacheCreateFlagsEXT)readd(address);address+=4;
-        s->initialDataSize = (size_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pInitialData = NULL;
-        } else {
-            s->pInitialData = (void*)getPhysicalAddress(paramAddress, s->initialDataSize);
-        }
-    }
-};
-
-class MarshalVkDescriptorSetLayoutSupport {
-public:
-    MarshalVkDescriptorSetLayoutSupport() {}
-    VkDescriptorSetLayoutSupport s;
-    MarshalVkDescriptorSetLayoutSupport(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDescriptorSetLayoutSupport* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->supported = (VkBool32)readd(address);address+=4;
-    }
-    static void write(U32 address, VkDescriptorSetLayoutSupport* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->supported);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceHostQueryResetFeatures {
-public:
-    MarshalVkPhysicalDeviceHostQueryResetFeatures() {}
-    VkPhysicalDeviceHostQueryResetFeatures s;
-    MarshalVkPhysicalDeviceHostQueryResetFeatures(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceHostQueryResetFeatures* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->hostQueryReset = (VkBool32)readd(address);address+=4;
-    }
-    static void write(U32 address, VkPhysicalDeviceHostQueryResetFeatures* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->hostQueryReset);address+=4;
-    }
-};
-
-class MarshalVkMemoryHostPointerPropertiesEXT {
-public:
-    MarshalVkMemoryHostPointerPropertiesEXT() {}
-    VkMemoryHostPointerPropertiesEXT s;
-    MarshalVkMemoryHostPointerPropertiesEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMemoryHostPointerPropertiesEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->memoryTypeBits = (uint32_t)readd(address);address+=4;
-    }
-    static void write(U32 address, VkMemoryHostPointerPropertiesEXT* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->memoryTypeBits);address+=4;
-    }
-};
-
-class MarshalVkCalibratedTimestampInfoEXT {
-public:
-    MarshalVkCalibratedTimestampInfoEXT() {}
-    VkCalibratedTimestampInfoEXT s;
-    MarshalVkCalibratedTimestampInfoEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCalibratedTimestampInfoEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->timeDomain = (VkTimeDomainEXT)readd(address);address+=4;
-    }
-};
-
-class MarshalVkAttachmentDescription2 {
-public:
-    MarshalVkAttachmentDescription2() {}
-    VkAttachmentDescription2 s;
-    MarshalVkAttachmentDescription2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAttachmentDescription2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkAttachmentDescriptionFlags)readd(address);address+=4;
-        s->format = (VkFormat)readd(address);address+=4;
-        s->samples = (VkSampleCountFlagBits)readd(address);address+=4;
-        s->loadOp = (VkAttachmentLoadOp)readd(address);address+=4;
-        s->storeOp = (VkAttachmentStoreOp)readd(address);address+=4;
-        s->stencilLoadOp = (VkAttachmentLoadOp)readd(address);address+=4;
-        s->stencilStoreOp = (VkAttachmentStoreOp)readd(address);address+=4;
-        s->initialLayout = (VkImageLayout)readd(address);address+=4;
-        s->finalLayout = (VkImageLayout)readd(address);address+=4;
-    }
-};
-
-class MarshalVkAttachmentReference2 {
-public:
-    MarshalVkAttachmentReference2() {}
-    VkAttachmentReference2 s;
-    MarshalVkAttachmentReference2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAttachmentReference2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->attachment = (uint32_t)readd(address);address+=4;
-        s->layout = (VkImageLayout)readd(address);address+=4;
-        s->aspectMask = (VkImageAspectFlags)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSubpassDescription2 {
-public:
-    MarshalVkSubpassDescription2() {}
-    VkSubpassDescription2 s;
-    MarshalVkSubpassDescription2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubpassDescription2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkSubpassDescriptionFlags)readd(address);address+=4;
-        s->pipelineBindPoint = (VkPipelineBindPoint)readd(address);address+=4;
-        s->viewMask = (uint32_t)readd(address);address+=4;
-        s->inputAttachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pInputAttachments = NULL;
-        } else {
-            VkAttachmentReference2* pInputAttachments = new VkAttachmentReference2[s->inputAttachmentCount];
-            for (U32 i = 0; i < s->inputAttachmentCount; i++) {
-                MarshalVkAttachmentReference2::read(paramAddress, &pInputAttachments[i]);
-            }
-            s->pInputAttachments = pInputAttachments;
-        }
-        s->colorAttachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pColorAttachments = NULL;
-        } else {
-            VkAttachmentReference2* pColorAttachments = new VkAttachmentReference2[s->colorAttachmentCount];
-            for (U32 i = 0; i < s->colorAttachmentCount; i++) {
-                MarshalVkAttachmentReference2::read(paramAddress, &pColorAttachments[i]);
-            }
-            s->pColorAttachments = pColorAttachments;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pResolveAttachments = NULL;
-        } else {
-            VkAttachmentReference2* pResolveAttachments = new VkAttachmentReference2[s->colorAttachmentCount];
-            for (U32 i = 0; i < s->colorAttachmentCount; i++) {
-                MarshalVkAttachmentReference2::read(paramAddress, &pResolveAttachments[i]);
-            }
-            s->pResolveAttachments = pResolveAttachments;
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDepthStencilAttachment = NULL;
-        } else {
-            VkAttachmentReference2* pDepthStencilAttachment = new VkAttachmentReference2();
-            MarshalVkAttachmentReference2::read(paramAddress, pDepthStencilAttachment);
-            s->pDepthStencilAttachment = pDepthStencilAttachment;
-        }
-        s->preserveAttachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pPreserveAttachments = NULL;
-        } else {
-            s->pPreserveAttachments = (uint32_t*)getPhysicalAddress(paramAddress, s->preserveAttachmentCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkSubpassDependency2 {
-public:
-    MarshalVkSubpassDependency2() {}
-    VkSubpassDependency2 s;
-    MarshalVkSubpassDependency2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubpassDependency2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcSubpass = (uint32_t)readd(address);address+=4;
-        s->dstSubpass = (uint32_t)readd(address);address+=4;
-        s->srcStageMask = (VkPipelineStageFlags)readd(address);address+=4;
-        s->dstStageMask = (VkPipelineStageFlags)readd(address);address+=4;
-        s->srcAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->dstAccessMask = (VkAccessFlags)readd(address);address+=4;
-        s->dependencyFlags = (VkDependencyFlags)readd(address);address+=4;
-        s->viewOffset = (int32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkRenderPassCreateInfo2 {
-public:
-    MarshalVkRenderPassCreateInfo2() {}
-    VkRenderPassCreateInfo2 s;
-    MarshalVkRenderPassCreateInfo2(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkRenderPassCreateInfo2* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkRenderPassCreateFlags)readd(address);address+=4;
-        s->attachmentCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pAttachments = NULL;
-        } else {
-            VkAttachmentDescription2* pAttachments = new VkAttachmentDescription2[s->attachmentCount];
-            for (U32 i = 0; i < s->attachmentCount; i++) {
-                MarshalVkAttachmentDescription2::read(paramAddress, &pAttachments[i]);
-            }
-            s->pAttachments = pAttachments;
-        }
-        s->subpassCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSubpasses = NULL;
-        } else {
-            VkSubpassDescription2* pSubpasses = new VkSubpassDescription2[s->subpassCount];
-            for (U32 i = 0; i < s->subpassCount; i++) {
-                MarshalVkSubpassDescription2::read(paramAddress, &pSubpasses[i]);
-            }
-            s->pSubpasses = pSubpasses;
-        }
-        s->dependencyCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDependencies = NULL;
-        } else {
-            VkSubpassDependency2* pDependencies = new VkSubpassDependency2[s->dependencyCount];
-            for (U32 i = 0; i < s->dependencyCount; i++) {
-                MarshalVkSubpassDependency2::read(paramAddress, &pDependencies[i]);
-            }
-            s->pDependencies = pDependencies;
-        }
-        s->correlatedViewMaskCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pCorrelatedViewMasks = NULL;
-        } else {
-            s->pCorrelatedViewMasks = (uint32_t*)getPhysicalAddress(paramAddress, s->correlatedViewMaskCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkSubpassBeginInfo {
-public:
-    MarshalVkSubpassBeginInfo() {}
-    VkSubpassBeginInfo s;
-    MarshalVkSubpassBeginInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubpassBeginInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->contents = (VkSubpassContents)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSubpassEndInfo {
-public:
-    MarshalVkSubpassEndInfo() {}
-    VkSubpassEndInfo s;
-    MarshalVkSubpassEndInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubpassEndInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-    }
-};
-
-class MarshalVkSemaphoreWaitInfo {
-public:
-    MarshalVkSemaphoreWaitInfo() {}
-    VkSemaphoreWaitInfo s;
-    MarshalVkSemaphoreWaitInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSemaphoreWaitInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkSemaphoreWaitFlags)readd(address);address+=4;
-        s->semaphoreCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSemaphores = NULL;
-        } else {
-            s->pSemaphores = (VkSemaphore*)getPhysicalAddress(paramAddress, s->semaphoreCount * sizeof(VkSemaphore));
-        }
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pValues = NULL;
-        } else {
-            s->pValues = (uint64_t*)getPhysicalAddress(paramAddress, s->semaphoreCount * sizeof(uint64_t));
-        }
-    }
-};
-
-class MarshalVkSemaphoreSignalInfo {
-public:
-    MarshalVkSemaphoreSignalInfo() {}
-    VkSemaphoreSignalInfo s;
-    MarshalVkSemaphoreSignalInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSemaphoreSignalInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->semaphore = (VkSemaphore)readq(address);address+=8;
-        s->value = (uint64_t)readq(address);address+=8;
-    }
-};
-
-class MarshalVkPhysicalDeviceVertexAttributeDivisorFeaturesEXT {
-public:
-    MarshalVkPhysicalDeviceVertexAttributeDivisorFeaturesEXT() {}
-    VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT s;
-    MarshalVkPhysicalDeviceVertexAttributeDivisorFeaturesEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->vertexAttributeInstanceRateDivisor = (VkBool32)readd(address);address+=4;
-        s->vertexAttributeInstanceRateZeroDivisor = (VkBool32)readd(address);address+=4;
-    }
-    static void write(U32 address, VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->vertexAttributeInstanceRateDivisor);address+=4;
-        writed(address, s->vertexAttributeInstanceRateZeroDivisor);address+=4;
-    }
-};
-
-class MarshalVkPhysicalDeviceTransformFeedbackFeaturesEXT {
-public:
-    MarshalVkPhysicalDeviceTransformFeedbackFeaturesEXT() {}
-    VkPhysicalDeviceTransformFeedbackFeaturesEXT s;
-    MarshalVkPhysicalDeviceTransformFeedbackFeaturesEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkPhysicalDeviceTransformFeedbackFeaturesEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->transformFeedback = (VkBool32)readd(address);address+=4;
-        s->geometryStreams = (VkBool32)readd(address);address+=4;
-    }
-    static void write(U32 address, VkPhysicalDeviceTransformFeedbackFeaturesEXT* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->transformFeedback);address+=4;
-        writed(address, s->geometryStreams);address+=4;
-    }
-};
-
-class MarshalVkShadingRatePaletteNV {
-public:
-    MarshalVkShadingRatePaletteNV() {}
-    VkShadingRatePaletteNV s;
-    MarshalVkShadingRatePaletteNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkShadingRatePaletteNV* s) {
-        s->shadingRatePaletteEntryCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pShadingRatePaletteEntries = NULL;
-        } else {
-            s->pShadingRatePaletteEntries = (VkShadingRatePaletteEntryNV*)getPhysicalAddress(paramAddress, s->shadingRatePaletteEntryCount * sizeof(VkShadingRatePaletteEntryNV));
-        }
-    }
-};
-
-class MarshalVkCoarseSampleOrderCustomNV {
-public:
-    MarshalVkCoarseSampleOrderCustomNV() {}
-    VkCoarseSampleOrderCustomNV s;
-    MarshalVkCoarseSampleOrderCustomNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCoarseSampleOrderCustomNV* s) {
-        s->shadingRate = (VkShadingRatePaletteEntryNV)readd(address);address+=4;
-        s->sampleCount = (uint32_t)readd(address);address+=4;
-        s->sampleLocationCount = (uint32_t)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSampleLocations = NULL;
-        } else {
-            s->pSampleLocations = (VkCoarseSampleLocationNV*)getPhysicalAddress(paramAddress, s->sampleLocationCount * sizeof(VkCoarseSampleLocationNV));
-        }
-    }
-};
-
-class MarshalVkRayTracingShaderGroupCreateInfoNV {
-public:
-    MarshalVkRayTracingShaderGroupCreateInfoNV() {}
-    VkRayTracingShaderGroupCreateInfoNV s;
-    MarshalVkRayTracingShaderGroupCreateInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkRayTracingShaderGroupCreateInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->type = (VkRayTracingShaderGroupTypeKHR)readd(address);address+=4;
-        s->generalShader = (uint32_t)readd(address);address+=4;
-        s->closestHitShader = (uint32_t)readd(address);address+=4;
-        s->anyHitShader = (uint32_t)readd(address);address+=4;
-        s->intersectionShader = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkRayTracingPipelineCreateInfoNV {
-public:
-    MarshalVkRayTracingPipelineCreateInfoNV() {}
-    VkRayTracingPipelineCreateInfoNV s;
-    MarshalVkRayTracingPipelineCreateInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkRayTracingPipelineCreateInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkPipelineCreateFlags)readd(address);address+=4;
-        s->stageCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pStages = NULL;
-        } else {
-            VkPipelineShaderStageCreateInfo* pStages = new VkPipelineShaderStageCreateInfo[s->stageCount];
-            for (U32 i = 0; i < s->stageCount; i++) {
-                MarshalVkPipelineShaderStageCreateInfo::read(paramAddress, &pStages[i]);
-            }
-            s->pStages = pStages;
-        }
-        s->groupCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pGroups = NULL;
-        } else {
-            VkRayTracingShaderGroupCreateInfoNV* pGroups = new VkRayTracingShaderGroupCreateInfoNV[s->groupCount];
-            for (U32 i = 0; i < s->groupCount; i++) {
-                MarshalVkRayTracingShaderGroupCreateInfoNV::read(paramAddress, &pGroups[i]);
-            }
-            s->pGroups = pGroups;
-        }
-        s->maxRecursionDepth = (uint32_t)readd(address);address+=4;
-        s->layout = (VkPipelineLayout)readq(address);address+=8;
-        s->basePipelineHandle = (VkPipeline)readq(address);address+=8;
-        s->basePipelineIndex = (int32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkGeometryTrianglesNV {
-public:
-    MarshalVkGeometryTrianglesNV() {}
-    VkGeometryTrianglesNV s;
-    MarshalVkGeometryTrianglesNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGeometryTrianglesNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->vertexData = (VkBuffer)readq(address);address+=8;
-        s->vertexOffset = (VkDeviceSize)readq(address);address+=8;
-        s->vertexCount = (uint32_t)readd(address);address+=4;
-        s->vertexStride = (VkDeviceSize)readq(address);address+=8;
-        s->vertexFormat = (VkFormat)readd(address);address+=4;
-        s->indexData = (VkBuffer)readq(address);address+=8;
-        s->indexOffset = (VkDeviceSize)readq(address);address+=8;
-        s->indexCount = (uint32_t)readd(address);address+=4;
-        s->indexType = (VkIndexType)readd(address);address+=4;
-        s->transformData = (VkBuffer)readq(address);address+=8;
-        s->transformOffset = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkGeometryAABBNV {
-public:
-    MarshalVkGeometryAABBNV() {}
-    VkGeometryAABBNV s;
-    MarshalVkGeometryAABBNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGeometryAABBNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->aabbData = (VkBuffer)readq(address);address+=8;
-        s->numAABBs = (uint32_t)readd(address);address+=4;
-        s->stride = (uint32_t)readd(address);address+=4;
-        s->offset = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkGeometryDataNV {
-public:
-    MarshalVkGeometryDataNV() {}
-    VkGeometryDataNV s;
-    MarshalVkGeometryDataNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGeometryDataNV* s) {
-        MarshalVkGeometryTrianglesNV::read(address, &s->triangles); address+=80;
-        MarshalVkGeometryAABBNV::read(address, &s->aabbs); address+=32;
-    }
-};
-
-class MarshalVkGeometryNV {
-public:
-    MarshalVkGeometryNV() {}
-    VkGeometryNV s;
-    MarshalVkGeometryNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkGeometryNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->geometryType = (VkGeometryTypeKHR)readd(address);address+=4;
-        MarshalVkGeometryDataNV::read(address, &s->geometry); address+=112;
-        s->flags = (VkGeometryFlagsKHR)readd(address);address+=4;
-    }
-};
-
-class MarshalVkAccelerationStructureInfoNV {
-public:
-    MarshalVkAccelerationStructureInfoNV() {}
-    VkAccelerationStructureInfoNV s;
-    MarshalVkAccelerationStructureInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAccelerationStructureInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->type = (VkAccelerationStructureTypeKHR)readd(address);address+=4;
-        s->flags = (VkBuildAccelerationStructureFlagsKHR)readd(address);address+=4;
-        s->instanceCount = (uint32_t)readd(address);address+=4;
-        s->geometryCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pGeometries = NULL;
-        } else {
-            VkGeometryNV* pGeometries = new VkGeometryNV[s->geometryCount];
-            for (U32 i = 0; i < s->geometryCount; i++) {
-                MarshalVkGeometryNV::read(paramAddress, &pGeometries[i]);
-            }
-            s->pGeometries = pGeometries;
-        }
-    }
-};
-
-class MarshalVkAccelerationStructureCreateInfoNV {
-public:
-    MarshalVkAccelerationStructureCreateInfoNV() {}
-    VkAccelerationStructureCreateInfoNV s;
-    MarshalVkAccelerationStructureCreateInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAccelerationStructureCreateInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->compactedSize = (VkDeviceSize)readq(address);address+=8;
-        MarshalVkAccelerationStructureInfoNV::read(address, &s->info); address+=28;
-    }
-};
-
-class MarshalVkBindAccelerationStructureMemoryInfoNV {
-public:
-    MarshalVkBindAccelerationStructureMemoryInfoNV() {}
-    VkBindAccelerationStructureMemoryInfoNV s;
-    MarshalVkBindAccelerationStructureMemoryInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBindAccelerationStructureMemoryInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->accelerationStructure = (VkAccelerationStructureNV)readq(address);address+=8;
-        s->memory = (VkDeviceMemory)readq(address);address+=8;
-        s->memoryOffset = (VkDeviceSize)readq(address);address+=8;
-        s->deviceIndexCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pDeviceIndices = NULL;
-        } else {
-            s->pDeviceIndices = (uint32_t*)getPhysicalAddress(paramAddress, s->deviceIndexCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkAccelerationStructureMemoryRequirementsInfoNV {
-public:
-    MarshalVkAccelerationStructureMemoryRequirementsInfoNV() {}
-    VkAccelerationStructureMemoryRequirementsInfoNV s;
-    MarshalVkAccelerationStructureMemoryRequirementsInfoNV(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAccelerationStructureMemoryRequirementsInfoNV* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->type = (VkAccelerationStructureMemoryRequirementsTypeNV)readd(address);address+=4;
-        s->accelerationStructure = (VkAccelerationStructureNV)readq(address);address+=8;
-    }
-};
-
-class MarshalVkBufferDeviceAddressInfo {
-public:
-    MarshalVkBufferDeviceAddressInfo() {}
-    VkBufferDeviceAddressInfo s;
-    MarshalVkBufferDeviceAddressInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferDeviceAddressInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->buffer = (VkBuffer)readq(address);address+=8;
-    }
-};
-
-class MarshalVkCooperativeMatrixPropertiesNV {
-public:
-    MarshalVkCooperativeMatrixPropertiesNV() {}
-    VkCooperativeMatrixPropertiesNV s;
-    static void write(U32 address, VkCooperativeMatrixPropertiesNV* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->MSize);address+=4;
-        writed(address, s->NSize);address+=4;
-        writed(address, s->KSize);address+=4;
-        writed(address, s->AType);address+=4;
-        writed(address, s->BType);address+=4;
-        writed(address, s->CType);address+=4;
-        writed(address, s->DType);address+=4;
-        writed(address, s->scope);address+=4;
-    }
-};
-
-class MarshalVkPerformanceCounterKHR {
-public:
-    MarshalVkPerformanceCounterKHR() {}
-    VkPerformanceCounterKHR s;
-    static void write(U32 address, VkPerformanceCounterKHR* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->unit);address+=4;
-        writed(address, s->scope);address+=4;
-        writed(address, s->storage);address+=4;
-        memcopyFromNative(address, s->uuid, 16); address+=16;
-    }
-};
-
-class MarshalVkPerformanceCounterDescriptionKHR {
-public:
-    MarshalVkPerformanceCounterDescriptionKHR() {}
-    VkPerformanceCounterDescriptionKHR s;
-    static void write(U32 address, VkPerformanceCounterDescriptionKHR* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->flags);address+=4;
-        memcopyFromNative(address, s->name, 256); address+=256;
-        memcopyFromNative(address, s->category, 256); address+=256;
-        memcopyFromNative(address, s->description, 256); address+=256;
-    }
-};
-
-class MarshalVkQueryPoolPerformanceCreateInfoKHR {
-public:
-    MarshalVkQueryPoolPerformanceCreateInfoKHR() {}
-    VkQueryPoolPerformanceCreateInfoKHR s;
-    MarshalVkQueryPoolPerformanceCreateInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkQueryPoolPerformanceCreateInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->queueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->counterIndexCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pCounterIndices = NULL;
-        } else {
-            s->pCounterIndices = (uint32_t*)getPhysicalAddress(paramAddress, s->counterIndexCount * sizeof(uint32_t));
-        }
-    }
-};
-
-class MarshalVkAcquireProfilingLockInfoKHR {
-public:
-    MarshalVkAcquireProfilingLockInfoKHR() {}
-    VkAcquireProfilingLockInfoKHR s;
-    MarshalVkAcquireProfilingLockInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkAcquireProfilingLockInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkAcquireProfilingLockFlagsKHR)readd(address);address+=4;
-        s->timeout = (uint64_t)readq(address);address+=8;
-    }
-};
-
-class MarshalVkHeadlessSurfaceCreateInfoEXT {
-public:
-    MarshalVkHeadlessSurfaceCreateInfoEXT() {}
-    VkHeadlessSurfaceCreateInfoEXT s;
-    MarshalVkHeadlessSurfaceCreateInfoEXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkHeadlessSurfaceCreateInfoEXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkHeadlessSurfaceCreateFlagsEXT)readd(address);address+=4;
-    }
-};
-
-class MarshalVkFramebufferMixedSamplesCombinationNV {
-public:
-    MarshalVkFramebufferMixedSamplesCombinationNV() {}
-    VkFramebufferMixedSamplesCombinationNV s;
-    static void write(U32 address, VkFramebufferMixedSamplesCombinationNV* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->coverageReductionMode);address+=4;
-        writed(address, s->rasterizationSamples);address+=4;
-        writed(address, s->depthStencilSamples);address+=4;
-        writed(address, s->colorSamples);address+=4;
-    }
-};
-
-class MarshalVkDeviceMemoryOpaqueCaptureAddressInfo {
-public:
-    MarshalVkDeviceMemoryOpaqueCaptureAddressInfo() {}
-    VkDeviceMemoryOpaqueCaptureAddressInfo s;
-    MarshalVkDeviceMemoryOpaqueCaptureAddressInfo(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDeviceMemoryOpaqueCaptureAddressInfo* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->memory = (VkDeviceMemory)readq(address);address+=8;
-    }
-};
-
-class MarshalVkPhysicalDeviceToolPropertiesEXT {
-public:
-    MarshalVkPhysicalDeviceToolPropertiesEXT() {}
-    VkPhysicalDeviceToolPropertiesEXT s;
-    static void write(U32 address, VkPhysicalDeviceToolPropertiesEXT* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        memcopyFromNative(address, s->name, 256); address+=256;
-        memcopyFromNative(address, s->version, 256); address+=256;
-        writed(address, s->purposes);address+=4;
-        memcopyFromNative(address, s->description, 256); address+=256;
-        memcopyFromNative(address, s->layer, 256); address+=256;
-    }
-};
-
-class MarshalVkBufferCopy2KHR {
-public:
-    MarshalVkBufferCopy2KHR() {}
-    VkBufferCopy2KHR s;
-    MarshalVkBufferCopy2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferCopy2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcOffset = (VkDeviceSize)readq(address);address+=8;
-        s->dstOffset = (VkDeviceSize)readq(address);address+=8;
-        s->size = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkImageCopy2KHR {
-public:
-    MarshalVkImageCopy2KHR() {}
-    VkImageCopy2KHR s;
-    MarshalVkImageCopy2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageCopy2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->srcSubresource, 16);address+=16;
-        memcopyToNative(address, &s->srcOffset, 12);address+=12;
-        memcopyToNative(address, &s->dstSubresource, 16);address+=16;
-        memcopyToNative(address, &s->dstOffset, 12);address+=12;
-        memcopyToNative(address, &s->extent, 12);address+=12;
-    }
-};
-
-class MarshalVkImageBlit2KHR {
-public:
-    MarshalVkImageBlit2KHR() {}
-    VkImageBlit2KHR s;
-    MarshalVkImageBlit2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageBlit2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->srcSubresource, 16);address+=16;
-        memcopyToNative(address, &s->srcOffsets, 2);address+=2;
-        memcopyToNative(address, &s->dstSubresource, 16);address+=16;
-        memcopyToNative(address, &s->dstOffsets, 2);address+=2;
-    }
-};
-
-class MarshalVkBufferImageCopy2KHR {
-public:
-    MarshalVkBufferImageCopy2KHR() {}
-    VkBufferImageCopy2KHR s;
-    MarshalVkBufferImageCopy2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferImageCopy2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->bufferOffset = (VkDeviceSize)readq(address);address+=8;
-        s->bufferRowLength = (uint32_t)readd(address);address+=4;
-        s->bufferImageHeight = (uint32_t)readd(address);address+=4;
-        memcopyToNative(address, &s->imageSubresource, 16);address+=16;
-        memcopyToNative(address, &s->imageOffset, 12);address+=12;
-        memcopyToNative(address, &s->imageExtent, 12);address+=12;
-    }
-};
-
-class MarshalVkImageResolve2KHR {
-public:
-    MarshalVkImageResolve2KHR() {}
-    VkImageResolve2KHR s;
-    MarshalVkImageResolve2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageResolve2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        memcopyToNative(address, &s->srcSubresource, 16);address+=16;
-        memcopyToNative(address, &s->srcOffset, 12);address+=12;
-        memcopyToNative(address, &s->dstSubresource, 16);address+=16;
-        memcopyToNative(address, &s->dstOffset, 12);address+=12;
-        memcopyToNative(address, &s->extent, 12);address+=12;
-    }
-};
-
-class MarshalVkCopyBufferInfo2KHR {
-public:
-    MarshalVkCopyBufferInfo2KHR() {}
-    VkCopyBufferInfo2KHR s;
-    MarshalVkCopyBufferInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCopyBufferInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcBuffer = (VkBuffer)readq(address);address+=8;
-        s->dstBuffer = (VkBuffer)readq(address);address+=8;
-        s->regionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRegions = NULL;
-        } else {
-            VkBufferCopy2KHR* pRegions = new VkBufferCopy2KHR[s->regionCount];
-            for (U32 i = 0; i < s->regionCount; i++) {
-                MarshalVkBufferCopy2KHR::read(paramAddress, &pRegions[i]);
-            }
-            s->pRegions = pRegions;
-        }
-    }
-};
-
-class MarshalVkCopyImageInfo2KHR {
-public:
-    MarshalVkCopyImageInfo2KHR() {}
-    VkCopyImageInfo2KHR s;
-    MarshalVkCopyImageInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCopyImageInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcImage = (VkImage)readq(address);address+=8;
-        s->srcImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->dstImage = (VkImage)readq(address);address+=8;
-        s->dstImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->regionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRegions = NULL;
-        } else {
-            VkImageCopy2KHR* pRegions = new VkImageCopy2KHR[s->regionCount];
-            for (U32 i = 0; i < s->regionCount; i++) {
-                MarshalVkImageCopy2KHR::read(paramAddress, &pRegions[i]);
-            }
-            s->pRegions = pRegions;
-        }
-    }
-};
-
-class MarshalVkBlitImageInfo2KHR {
-public:
-    MarshalVkBlitImageInfo2KHR() {}
-    VkBlitImageInfo2KHR s;
-    MarshalVkBlitImageInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBlitImageInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcImage = (VkImage)readq(address);address+=8;
-        s->srcImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->dstImage = (VkImage)readq(address);address+=8;
-        s->dstImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->regionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRegions = NULL;
-        } else {
-            VkImageBlit2KHR* pRegions = new VkImageBlit2KHR[s->regionCount];
-            for (U32 i = 0; i < s->regionCount; i++) {
-                MarshalVkImageBlit2KHR::read(paramAddress, &pRegions[i]);
-            }
-            s->pRegions = pRegions;
-        }
-        s->filter = (VkFilter)readd(address);address+=4;
-    }
-};
-
-class MarshalVkCopyBufferToImageInfo2KHR {
-public:
-    MarshalVkCopyBufferToImageInfo2KHR() {}
-    VkCopyBufferToImageInfo2KHR s;
-    MarshalVkCopyBufferToImageInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCopyBufferToImageInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcBuffer = (VkBuffer)readq(address);address+=8;
-        s->dstImage = (VkImage)readq(address);address+=8;
-        s->dstImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->regionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRegions = NULL;
-        } else {
-            VkBufferImageCopy2KHR* pRegions = new VkBufferImageCopy2KHR[s->regionCount];
-            for (U32 i = 0; i < s->regionCount; i++) {
-                MarshalVkBufferImageCopy2KHR::read(paramAddress, &pRegions[i]);
-            }
-            s->pRegions = pRegions;
-        }
-    }
-};
-
-class MarshalVkCopyImageToBufferInfo2KHR {
-public:
-    MarshalVkCopyImageToBufferInfo2KHR() {}
-    VkCopyImageToBufferInfo2KHR s;
-    MarshalVkCopyImageToBufferInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCopyImageToBufferInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcImage = (VkImage)readq(address);address+=8;
-        s->srcImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->dstBuffer = (VkBuffer)readq(address);address+=8;
-        s->regionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRegions = NULL;
-        } else {
-            VkBufferImageCopy2KHR* pRegions = new VkBufferImageCopy2KHR[s->regionCount];
-            for (U32 i = 0; i < s->regionCount; i++) {
-                MarshalVkBufferImageCopy2KHR::read(paramAddress, &pRegions[i]);
-            }
-            s->pRegions = pRegions;
-        }
-    }
-};
-
-class MarshalVkResolveImageInfo2KHR {
-public:
-    MarshalVkResolveImageInfo2KHR() {}
-    VkResolveImageInfo2KHR s;
-    MarshalVkResolveImageInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkResolveImageInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcImage = (VkImage)readq(address);address+=8;
-        s->srcImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->dstImage = (VkImage)readq(address);address+=8;
-        s->dstImageLayout = (VkImageLayout)readd(address);address+=4;
-        s->regionCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pRegions = NULL;
-        } else {
-            VkImageResolve2KHR* pRegions = new VkImageResolve2KHR[s->regionCount];
-            for (U32 i = 0; i < s->regionCount; i++) {
-                MarshalVkImageResolve2KHR::read(paramAddress, &pRegions[i]);
-            }
-            s->pRegions = pRegions;
-        }
-    }
-};
-
-class MarshalVkPhysicalDeviceFragmentShadingRateKHR {
-public:
-    MarshalVkPhysicalDeviceFragmentShadingRateKHR() {}
-    VkPhysicalDeviceFragmentShadingRateKHR s;
-    static void write(U32 address, VkPhysicalDeviceFragmentShadingRateKHR* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writed(address, s->sampleCounts);address+=4;
-        memcopyFromNative(address, &s->fragmentSize, 8); address+=8;
-    }
-};
-
-class MarshalVkVertexInputBindingDescription2EXT {
-public:
-    MarshalVkVertexInputBindingDescription2EXT() {}
-    VkVertexInputBindingDescription2EXT s;
-    MarshalVkVertexInputBindingDescription2EXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkVertexInputBindingDescription2EXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->binding = (uint32_t)readd(address);address+=4;
-        s->stride = (uint32_t)readd(address);address+=4;
-        s->inputRate = (VkVertexInputRate)readd(address);address+=4;
-        s->divisor = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkVertexInputAttributeDescription2EXT {
-public:
-    MarshalVkVertexInputAttributeDescription2EXT() {}
-    VkVertexInputAttributeDescription2EXT s;
-    MarshalVkVertexInputAttributeDescription2EXT(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkVertexInputAttributeDescription2EXT* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->location = (uint32_t)readd(address);address+=4;
-        s->binding = (uint32_t)readd(address);address+=4;
-        s->format = (VkFormat)readd(address);address+=4;
-        s->offset = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkMemoryBarrier2KHR {
-public:
-    MarshalVkMemoryBarrier2KHR() {}
-    VkMemoryBarrier2KHR s;
-    MarshalVkMemoryBarrier2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkMemoryBarrier2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcStageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->srcAccessMask = (VkAccessFlags2KHR)readq(address);address+=8;
-        s->dstStageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->dstAccessMask = (VkAccessFlags2KHR)readq(address);address+=8;
-    }
-};
-
-class MarshalVkImageMemoryBarrier2KHR {
-public:
-    MarshalVkImageMemoryBarrier2KHR() {}
-    VkImageMemoryBarrier2KHR s;
-    MarshalVkImageMemoryBarrier2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkImageMemoryBarrier2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcStageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->srcAccessMask = (VkAccessFlags2KHR)readq(address);address+=8;
-        s->dstStageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->dstAccessMask = (VkAccessFlags2KHR)readq(address);address+=8;
-        s->oldLayout = (VkImageLayout)readd(address);address+=4;
-        s->newLayout = (VkImageLayout)readd(address);address+=4;
-        s->srcQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->dstQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->image = (VkImage)readq(address);address+=8;
-        memcopyToNative(address, &s->subresourceRange, 20);address+=20;
-    }
-};
-
-class MarshalVkBufferMemoryBarrier2KHR {
-public:
-    MarshalVkBufferMemoryBarrier2KHR() {}
-    VkBufferMemoryBarrier2KHR s;
-    MarshalVkBufferMemoryBarrier2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkBufferMemoryBarrier2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->srcStageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->srcAccessMask = (VkAccessFlags2KHR)readq(address);address+=8;
-        s->dstStageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->dstAccessMask = (VkAccessFlags2KHR)readq(address);address+=8;
-        s->srcQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->dstQueueFamilyIndex = (uint32_t)readd(address);address+=4;
-        s->buffer = (VkBuffer)readq(address);address+=8;
-        s->offset = (VkDeviceSize)readq(address);address+=8;
-        s->size = (VkDeviceSize)readq(address);address+=8;
-    }
-};
-
-class MarshalVkDependencyInfoKHR {
-public:
-    MarshalVkDependencyInfoKHR() {}
-    VkDependencyInfoKHR s;
-    MarshalVkDependencyInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkDependencyInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->dependencyFlags = (VkDependencyFlags)readd(address);address+=4;
-        s->memoryBarrierCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pMemoryBarriers = NULL;
-        } else {
-            VkMemoryBarrier2KHR* pMemoryBarriers = new VkMemoryBarrier2KHR[s->memoryBarrierCount];
-            for (U32 i = 0; i < s->memoryBarrierCount; i++) {
-                MarshalVkMemoryBarrier2KHR::read(paramAddress, &pMemoryBarriers[i]);
-            }
-            s->pMemoryBarriers = pMemoryBarriers;
-        }
-        s->bufferMemoryBarrierCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pBufferMemoryBarriers = NULL;
-        } else {
-            VkBufferMemoryBarrier2KHR* pBufferMemoryBarriers = new VkBufferMemoryBarrier2KHR[s->bufferMemoryBarrierCount];
-            for (U32 i = 0; i < s->bufferMemoryBarrierCount; i++) {
-                MarshalVkBufferMemoryBarrier2KHR::read(paramAddress, &pBufferMemoryBarriers[i]);
-            }
-            s->pBufferMemoryBarriers = pBufferMemoryBarriers;
-        }
-        s->imageMemoryBarrierCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pImageMemoryBarriers = NULL;
-        } else {
-            VkImageMemoryBarrier2KHR* pImageMemoryBarriers = new VkImageMemoryBarrier2KHR[s->imageMemoryBarrierCount];
-            for (U32 i = 0; i < s->imageMemoryBarrierCount; i++) {
-                MarshalVkImageMemoryBarrier2KHR::read(paramAddress, &pImageMemoryBarriers[i]);
-            }
-            s->pImageMemoryBarriers = pImageMemoryBarriers;
-        }
-    }
-};
-
-class MarshalVkSemaphoreSubmitInfoKHR {
-public:
-    MarshalVkSemaphoreSubmitInfoKHR() {}
-    VkSemaphoreSubmitInfoKHR s;
-    MarshalVkSemaphoreSubmitInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSemaphoreSubmitInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->semaphore = (VkSemaphore)readq(address);address+=8;
-        s->value = (uint64_t)readq(address);address+=8;
-        s->stageMask = (VkPipelineStageFlags2KHR)readq(address);address+=8;
-        s->deviceIndex = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkCommandBufferSubmitInfoKHR {
-public:
-    MarshalVkCommandBufferSubmitInfoKHR() {}
-    VkCommandBufferSubmitInfoKHR s;
-    MarshalVkCommandBufferSubmitInfoKHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkCommandBufferSubmitInfoKHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->commandBuffer = (VkCommandBuffer)getVulkanPtr(readd(address));address+=4;
-        s->deviceMask = (uint32_t)readd(address);address+=4;
-    }
-};
-
-class MarshalVkSubmitInfo2KHR {
-public:
-    MarshalVkSubmitInfo2KHR() {}
-    VkSubmitInfo2KHR s;
-    MarshalVkSubmitInfo2KHR(U32 address) {read(address, &this->s);}
-    static void read(U32 address, VkSubmitInfo2KHR* s) {
-        s->sType = (VkStructureType)readd(address);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pNext = NULL;
-        } else {
-            s->pNext = vulkanGetNextPtr(paramAddress);
-        }
-        s->flags = (VkSubmitFlagsKHR)readd(address);address+=4;
-        s->waitSemaphoreInfoCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pWaitSemaphoreInfos = NULL;
-        } else {
-            VkSemaphoreSubmitInfoKHR* pWaitSemaphoreInfos = new VkSemaphoreSubmitInfoKHR[s->waitSemaphoreInfoCount];
-            for (U32 i = 0; i < s->waitSemaphoreInfoCount; i++) {
-                MarshalVkSemaphoreSubmitInfoKHR::read(paramAddress, &pWaitSemaphoreInfos[i]);
-            }
-            s->pWaitSemaphoreInfos = pWaitSemaphoreInfos;
-        }
-        s->commandBufferInfoCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pCommandBufferInfos = NULL;
-        } else {
-            VkCommandBufferSubmitInfoKHR* pCommandBufferInfos = new VkCommandBufferSubmitInfoKHR[s->commandBufferInfoCount];
-            for (U32 i = 0; i < s->commandBufferInfoCount; i++) {
-                MarshalVkCommandBufferSubmitInfoKHR::read(paramAddress, &pCommandBufferInfos[i]);
-            }
-            s->pCommandBufferInfos = pCommandBufferInfos;
-        }
-        s->signalSemaphoreInfoCount = (uint32_t)readd(address);address+=4;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress == 0) {
-            s->pSignalSemaphoreInfos = NULL;
-        } else {
-            VkSemaphoreSubmitInfoKHR* pSignalSemaphoreInfos = new VkSemaphoreSubmitInfoKHR[s->signalSemaphoreInfoCount];
-            for (U32 i = 0; i < s->signalSemaphoreInfoCount; i++) {
-                MarshalVkSemaphoreSubmitInfoKHR::read(paramAddress, &pSignalSemaphoreInfos[i]);
-            }
-            s->pSignalSemaphoreInfos = pSignalSemaphoreInfos;
-        }
-    }
-};
-
-class MarshalVkCheckpointData2NV {
-public:
-    MarshalVkCheckpointData2NV() {}
-    VkCheckpointData2NV s;
-    static void write(U32 address, VkCheckpointData2NV* s) {
-        writed(address, s->sType);address+=4;
-        U32 paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-            vulkanWriteNextPtr(paramAddress, s->pNext);
-            delete s->pNext;
-        }
-        writeq(address, s->stage);address+=8;
-        paramAddress = readd(address);address+=4;
-        if (paramAddress != 0) {
-kpanic("        Can't marshal void*");
-        }
-    }
-};
-
+#include "vk_host_marshal.h"
 // return type: VkResult(4 bytes)
 void vk_CreateInstance(CPU* cpu) {
     initVulkan();
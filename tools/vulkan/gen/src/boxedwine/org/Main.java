@@ -157,7 +157,9 @@ public class Main {
             fosPassThrough.close();
 
             fosPassThrough = new FileOutputStream(hostSource+"vk_host.cpp");
-            VkHost.write(fosPassThrough, hostFunctions);
+            FileOutputStream fosMarshal = new FileOutputStream(hostSource+"vk_host_marshal.h");
+            VkHost.write(fosPassThrough, fosMarshal, hostFunctions);
+            fosMarshal.close();
             fosPassThrough.close();
 
             fosPassThrough = new FileOutputStream(hostSource+"vk_host.h");
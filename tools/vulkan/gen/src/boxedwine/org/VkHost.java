@@ -132,7 +132,7 @@ public class VkHost {
         fos.write(out.toString().getBytes());
     }
 
-    static public void write(FileOutputStream fos, Vector<VkFunction> hostFunctions) throws Exception {
+    static public void write(FileOutputStream fos, FileOutputStream fosMarshal, Vector<VkFunction> hostFunctions) throws Exception {
         StringBuilder out = new StringBuilder();
         out.append("#include \"boxedwine.h\"\n");
         out.append("#ifdef BOXEDWINE_VULKAN\n");
@@ -165,8 +165,18 @@ public class VkHost {
             VkHost.writeFunction(fn, part2);
         }
 
-        out.append("void* vulkanGetNextPtr(U32 address);\n");
-        out.append("void vulkanWriteNextPtr(U32 address, const void* pNext);\n");
+        out.append("#include \"vk_host_marshal.h\"\n");
+
+        // the Marshal classes are in their own header so that the tests can use them too
+        StringBuilder marshal = new StringBuilder();
+        marshal.append("#ifndef __VK_HOST_MARSHAL_H__\n");
+        marshal.append("#define __VK_HOST_MARSHAL_H__\n");
+        marshal.append("#include \"vk_host.h\"\n\n");
+        marshal.append("void* getVulkanPtr(U32 address);\n");
+        marshal.append("void* vulkanGetNextPtr(U32 address);\n");
+        marshal.append("void vulkanWriteNextPtr(U32 address, const void* pNext);\n");
+        marshal.append("// size on the host of the members from first to last, if it matches the guest the members are copied with one memcpy\n");
+        marshal.append("#define MARSHAL_RUN_SIZE(t, first, last) (offsetof(t, last) + sizeof(t::last) - offsetof(t, first))\n");
         StringBuilder tmp = new StringBuilder();
 
         for (String ext : Main.typeExtensions.values()) {
@@ -197,9 +207,10 @@ public class VkHost {
         // pass 4
         for (VkType t : Main.orderedTypes) {
             if (t.needMarshalIn || t.needMarshalOut) {
-                VkHostMarshalType.write(t, out);
+                VkHostMarshalType.write(t, marshal);
             }
         }
+        marshal.append("#endif\n");
         part2.append("void* vulkanGetNextPtr(U32 address) {\n");
         part2.append("    if (address == 0) {\n");
         part2.append("        return NULL;\n");
@@ -251,5 +262,6 @@ public class VkHost {
         part2.append("#endif\n\n");
         fos.write(out.toString().getBytes());
         fos.write(part2.toString().getBytes());
+        fosMarshal.write(marshal.toString().getBytes());
     }
 }
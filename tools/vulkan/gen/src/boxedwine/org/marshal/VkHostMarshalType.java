@@ -3,7 +3,148 @@ package boxedwine.org.marshal;
 import boxedwine.org.VkParam;
 import boxedwine.org.VkType;
 
+import java.util.Vector;
+
 public class VkHostMarshalType {
+    // true if the guest bytes can be used as is on the host
+    private static boolean isSameOnHost(VkType t) {
+        if (t.type.equals("VK_DEFINE_NON_DISPATCHABLE_HANDLE")) {
+            return true;
+        }
+        if (t.category.equals("enum")) {
+            // the VK_*_MAX_ENUM values force every enum to be 32-bit
+            return true;
+        }
+        if (t.type.equals("VK_DEFINE_HANDLE") || t.type.equals("size_t")) {
+            return false;
+        }
+        if (t.category.equals("platform")) {
+            return !t.type.equals("void") && !t.type.equals("void*");
+        }
+        if (t.category.equals("basetype") || t.category.equals("bitmask") || t.category.equals("handle")) {
+            return t.parent != null && isSameOnHost(t.parent);
+        }
+        return false;
+    }
+
+    private static boolean canCopy(VkParam p) {
+        if (p.isPointer || p.arrayLen != 0 || !isSameOnHost(p.paramType)) {
+            return false;
+        }
+        int width = p.paramType.getSize();
+        return width == 2 || width == 4 || width == 8;
+    }
+
+    // The guest packs members one after the other.  A member can only be added to the run if the host won't pad in
+    // front of it, so it must be aligned within the run and not need more alignment than the first member of the run.
+    private static boolean fitsRun(Vector<VkParam> run, VkParam p) {
+        int width = p.getSize();
+        return (getRunSize(run) % width) == 0 && width <= run.get(0).getSize();
+    }
+
+    private static int getRunSize(Vector<VkParam> run) {
+        int result = 0;
+        for (VkParam r : run) {
+            result += r.getSize();
+        }
+        return result;
+    }
+
+    private static void writeRunAssert(VkType t, Vector<VkParam> run, StringBuilder out) {
+        out.append("        static_assert(MARSHAL_RUN_SIZE(");
+        out.append(t.name);
+        out.append(", ");
+        out.append(run.get(0).name);
+        out.append(", ");
+        out.append(run.get(run.size() - 1).name);
+        out.append(") == ");
+        out.append(getRunSize(run));
+        out.append(", \"host layout doesn't match the guest\");\n");
+    }
+
+    // a single member that isn't a float is faster with readd/readq than with a memcpy, a float can't be cast from readd
+    private static boolean needsRunCopy(Vector<VkParam> run) {
+        return run.size() > 1 || run.get(0).paramType.name.equals("float");
+    }
+
+    private static void writeReadRun(VkType t, Vector<VkParam> run, StringBuilder out) throws Exception {
+        if (run.isEmpty()) {
+            return;
+        }
+        if (needsRunCopy(run)) {
+            int size = getRunSize(run);
+            writeRunAssert(t, run, out);
+            out.append("        memcopyToNativeInline(address, &s->");
+            out.append(run.get(0).name);
+            out.append(", ");
+            out.append(size);
+            out.append(");address+=");
+            out.append(size);
+            out.append(";\n");
+        } else {
+            writeReadMember(run.get(0), out);
+        }
+        run.clear();
+    }
+
+    private static void writeWriteRun(VkType t, Vector<VkParam> run, StringBuilder out) throws Exception {
+        if (run.isEmpty()) {
+            return;
+        }
+        if (needsRunCopy(run)) {
+            int size = getRunSize(run);
+            writeRunAssert(t, run, out);
+            out.append("        memcopyFromNativeInline(address, &s->");
+            out.append(run.get(0).name);
+            out.append(", ");
+            out.append(size);
+            out.append("); address+=");
+            out.append(size);
+            out.append(";\n");
+        } else {
+            writeWriteMember(run.get(0), out);
+        }
+        run.clear();
+    }
+
+    private static void writeReadMember(VkParam p, StringBuilder out) throws Exception {
+        int width = p.paramType.getSize();
+        out.append("        s->");
+        out.append(p.name);
+        out.append(" = (");
+        out.append(p.paramType.name);
+        out.append(")read");
+        if (width == 8) {
+            out.append("q(address);address+=8;\n");
+        } else if (width == 4) {
+            out.append("d(address);address+=4;\n");
+        } else if (width == 2) {
+            out.append("w(address);address+=2;\n");
+        } else {
+            throw new Exception("Unknown width");
+        }
+    }
+
+    private static void writeWriteMember(VkParam p, StringBuilder out) throws Exception {
+        int width = p.getSize();
+        out.append("        write");
+        if (width == 8) {
+            out.append("q(address, s->");
+            out.append(p.name);
+            out.append(");address+=8;\n");
+        } else if (width == 4) {
+            out.append("d(address, s->");
+            out.append(p.name);
+            out.append(");address+=4;\n");
+        } else if (width == 2) {
+            out.append("w(address, s->");
+            out.append(p.name);
+            out.append(");address+=2;\n");
+        } else {
+            throw new Exception("Unknown width");
+        }
+    }
+
     public static void write(VkType t, StringBuilder out) throws Exception {
         out.append("class Marshal");
         out.append(t.name);
@@ -24,10 +165,19 @@ public class VkHostMarshalType {
             out.append("* s");
             out.append(") {\n");
             boolean createdParamAddress = false;
+            Vector<VkParam> run = new Vector<>();
             if (t.name.equals("VkComputePipelineCreateInfo")) {
                 int ii=0;
             }
             for (VkParam p : t.members) {
+                if (canCopy(p)) {
+                    if (!run.isEmpty() && !fitsRun(run, p)) {
+                        writeReadRun(t, run, out);
+                    }
+                    run.add(p);
+                    continue;
+                }
+                writeReadRun(t, run, out);
                 if (p.isPointer) {
                     if (createdParamAddress) {
                         out.append("        paramAddress = readd(address);address+=4;\n");
@@ -232,24 +382,12 @@ public class VkHostMarshalType {
                             out.append(p.paramType.name);
                             out.append(")getVulkanPtr(readd(address));address+=4;\n");
                         } else {
-                            out.append("        s->");
-                            out.append(p.name);
-                            out.append(" = (");
-                            out.append(p.paramType.name);
-                            out.append(")read");
-                            if (width == 8) {
-                                out.append("q(address);address+=8;\n");
-                            } else if (width == 4) {
-                                out.append("d(address);address+=4;\n");
-                            } else if (width == 2) {
-                                out.append("w(address);address+=2;\n");
-                            } else {
-                                throw new Exception("Unknown width");
-                            }
+                            writeReadMember(p, out);
                         }
                     }
                 }
             }
+            writeReadRun(t, run, out);
             out.append("    }\n");
         }
         if (t.needMarshalOut) {
@@ -258,7 +396,16 @@ public class VkHostMarshalType {
             out.append("* s");
             out.append(") {\n");
             boolean createdParamAddress = false;
+            Vector<VkParam> run = new Vector<>();
             for (VkParam p : t.members) {
+                if (canCopy(p)) {
+                    if (!run.isEmpty() && !fitsRun(run, p)) {
+                        writeWriteRun(t, run, out);
+                    }
+                    run.add(p);
+                    continue;
+                }
+                writeWriteRun(t, run, out);
                 if (p.isPointer) {
                     if (createdParamAddress) {
                         out.append("        paramAddress = readd(address);address+=4;\n");
@@ -308,25 +455,11 @@ public class VkHostMarshalType {
                         out.append(width);
                         out.append(";\n");
                     } else {
-                        out.append("        write");
-                        if (width == 8) {
-                            out.append("q(address, s->");
-                            out.append(p.name);
-                            out.append(");address+=8;\n");
-                        } else if (width == 4) {
-                            out.append("d(address, s->");
-                            out.append(p.name);
-                            out.append(");address+=4;\n");
-                        } else if (width == 2) {
-                            out.append("w(address, s->");
-                            out.append(p.name);
-                            out.append(");address+=2;\n");
-                        } else {
-                            throw new Exception("Unknown width");
-                        }
+                        writeWriteMember(p, out);
                     }
                 }
             }
+            writeWriteRun(t, run, out);
             out.append("    }\n");
         }
         out.append("};\n\n");